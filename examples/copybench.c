@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <mpi.h>
+#include <hdf5.h>
+#include "H5VLpdc_public.h"
+
+/* Compares the write cache staging copy strategies: every rank writes a
+ * buffer of the given size with each strategy, the time spent in H5Dwrite is
+ * dominated by the copy since the transfers complete in the background.
+ *
+ * Usage: copybench <file> [MB per rank] [iterations] [copy threads]
+ */
+
+static const char *mode_names[] = {"auto", "memcpy", "stream", "parallel"};
+
+int
+main(int argc, char *argv[])
+{
+    hid_t     file_id, fapl_id, dset_id, filespace, memspace;
+    int       my_rank, num_procs, mode, iter;
+    long long nbytes, offset, total;
+    int       niter    = 5;
+    unsigned  nthreads = 4;
+    char *    buf;
+    double    stime, elapsed, best, sum, max_best;
+    char      name[32];
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    if (argc < 2) {
+        if (my_rank == 0)
+            printf("Usage: %s <file> [MB per rank] [iterations] [copy threads]\n", argv[0]);
+        MPI_Finalize();
+        return 1;
+    }
+    nbytes = (argc > 2 ? atoll(argv[2]) : 256) * 1048576;
+    if (argc > 3)
+        niter = atoi(argv[3]);
+    if (argc > 4)
+        nthreads = (unsigned)atoi(argv[4]);
+
+    total  = nbytes * num_procs;
+    offset = nbytes * my_rank;
+    buf    = (char *)malloc(nbytes);
+    memset(buf, my_rank + 1, nbytes);
+
+    /* Keep the whole buffer in one transfer, so that all of it is staged */
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_WORLD, MPI_INFO_NULL);
+    H5Pset_pdc_write_cache(fapl_id, (size_t)nbytes * 2, 100, 0);
+    H5Pset_pdc_chunking(fapl_id, (size_t)nbytes, 1);
+
+    if ((file_id = H5Fcreate(argv[1], H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) < 0) {
+        printf("H5Fcreate() error\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    memspace  = H5Screate_simple(1, (hsize_t *)&nbytes, NULL);
+    filespace = H5Screate_simple(1, (hsize_t *)&total, NULL);
+    H5Sselect_hyperslab(filespace, H5S_SELECT_SET, (hsize_t *)&offset, NULL, (hsize_t *)&nbytes, NULL);
+
+    if (my_rank == 0)
+        printf("%d ranks, %lld MB per rank, %d iterations, %u copy threads\n", num_procs, nbytes / 1048576,
+               niter, nthreads);
+
+    for (mode = H5VL_PDC_COPY_AUTO; mode <= H5VL_PDC_COPY_PARALLEL; mode++) {
+        H5VLpdc_set_copy((H5VL_pdc_copy_mode_t)mode, nthreads);
+
+        snprintf(name, sizeof(name), "data_%s", mode_names[mode]);
+        dset_id = H5Dcreate(file_id, name, H5T_NATIVE_CHAR, filespace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+        best = sum = 0;
+        for (iter = 0; iter < niter; iter++) {
+            MPI_Barrier(MPI_COMM_WORLD);
+            stime = MPI_Wtime();
+            if (H5Dwrite(dset_id, H5T_NATIVE_CHAR, memspace, filespace, H5P_DEFAULT, buf) < 0)
+                printf("write %s failed\n", name);
+            elapsed = MPI_Wtime() - stime;
+
+            /* Empty the write cache before the next iteration */
+            H5Fflush(file_id, H5F_SCOPE_LOCAL);
+
+            sum += elapsed;
+            if (iter == 0 || elapsed < best)
+                best = elapsed;
+        }
+
+        MPI_Reduce(&best, &max_best, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (my_rank == 0)
+            printf("%-8s best %.4f s (%.2f GB/s per rank), mean %.4f s\n", mode_names[mode], max_best,
+                   nbytes / max_best / 1e9, sum / niter);
+
+        H5Dclose(dset_id);
+    }
+
+    H5Sclose(memspace);
+    H5Sclose(filespace);
+    H5Pclose(fapl_id);
+    H5Fclose(file_id);
+    free(buf);
+
+    MPI_Finalize();
+    return 0;
+}
@@ -16,57 +16,374 @@
 /*
  * Purpose: The PDC VOL connector utilize the PDC library as the storage backend
  */
-#include "H5VLpdc.h" /* PDC plugin                         */
+#include "H5VLpdc_private.h" /* PDC plugin */
 
-#include "hdf5.h"
 #include "H5PLextern.h"
-#include "H5VLerror.h"
 
 /* External headers needed by this file */
 #include "H5linkedlist.h"
+#include "mercury_thread.h"
+#include "mercury_thread_condition.h"
 #include "pdc.h"
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
+#include <unistd.h>
 
 /****************/
 /* Local Macros */
 /****************/
 
-#define ADDR_MAX              256
-#define H5VL_PDC_SEQ_LIST_LEN 128
+/* Default write cache watermarks, in percent of the cache size */
+#define H5VL_PDC_CACHE_HIGH_PCT 90
+#define H5VL_PDC_CACHE_LOW_PCT  50
 
-#ifdef PDC_VOL_WRITE_CACHE_MAX_GB
-#define MAX_WRITE_CACHE_SIZE_GB PDC_VOL_WRITE_CACHE_MAX_GB
-#else
-#define MAX_WRITE_CACHE_SIZE_GB 1
-#endif
-/* (Uncomment to enable) */
-/* #define ENABLE_LOGGING */
-
-/*******************/
-/* Global variables*/
-/*******************/
-uint64_t write_cache_size_g = 0;
+/* Environment variables overriding the write cache defaults */
+#define H5VL_PDC_CACHE_SIZE_ENV "HDF5_VOL_PDC_WRITE_CACHE_SIZE"
+#define H5VL_PDC_CACHE_HIGH_ENV "HDF5_VOL_PDC_WRITE_CACHE_HIGH"
+#define H5VL_PDC_CACHE_LOW_ENV  "HDF5_VOL_PDC_WRITE_CACHE_LOW"
 
-/* Remove warnings when connector does not use callback arguments */
-#if defined(__cplusplus)
-#define H5VL_ATTR_UNUSED
-#elif defined(__GNUC__) && (__GNUC__ >= 4)
-#define H5VL_ATTR_UNUSED __attribute__((unused))
+/* Deferred writes may be completed by a per-file progress thread, off unless enabled */
+#ifdef PDC_VOL_FLUSH_THREAD
+#define H5VL_PDC_FLUSH_THREAD_DEFAULT PDC_VOL_FLUSH_THREAD
 #else
-#define H5VL_ATTR_UNUSED
+#define H5VL_PDC_FLUSH_THREAD_DEFAULT 0
 #endif
+#define H5VL_PDC_FLUSH_THREAD_ENV "HDF5_VOL_PDC_FLUSH_THREAD"
+
+/* Interval between completion checks of the transfers of a flush thread, in microseconds */
+#define H5VL_PDC_FLUSH_POLL_US 200
+
+/* Environment variable selecting the read-after-write consistency, "strict" or "overlap" */
+#define H5VL_PDC_CONSISTENCY_ENV "HDF5_VOL_PDC_CONSISTENCY"
+
+/* Requests larger than a chunk are transferred as sub-regions of at most one
+ * chunk, with up to a window of them in flight; a sub-region never holds
+ * 2^31 elements or more */
+#define H5VL_PDC_CHUNK_SIZE     (64 * 1048576)
+#define H5VL_PDC_CHUNK_WINDOW   4
+#define H5VL_PDC_CHUNK_MAX_ELEM ((uint64_t)0x7fffffff)
+
+/* Environment variables overriding the chunking defaults */
+#define H5VL_PDC_CHUNK_SIZE_ENV   "HDF5_VOL_PDC_CHUNK_SIZE"
+#define H5VL_PDC_CHUNK_WINDOW_ENV "HDF5_VOL_PDC_CHUNK_WINDOW"
+
+/* Two-phase write aggregation: one aggregator per GROUP ranks unless set, and
+ * the tag of the messages carrying blocks to an aggregator */
+#define H5VL_PDC_AGG_GROUP 32
+#define H5VL_PDC_AGG_TAG   0x5044
+
+/* Environment variables overriding the aggregation defaults */
+#define H5VL_PDC_AGG_ENV         "HDF5_VOL_PDC_AGGREGATION"
+#define H5VL_PDC_AGGREGATORS_ENV "HDF5_VOL_PDC_AGGREGATORS"
+
+/* Read-ahead of the next timestep: byte budget of the read-ahead buffers of a
+ * file, and number of group sequences tracked to detect traversals */
+#define H5VL_PDC_PREFETCH_SIZE     (512 * 1048576)
+#define H5VL_PDC_PREFETCH_HIST     64
+#define H5VL_PDC_PREFETCH_SIZE_ENV "HDF5_VOL_PDC_PREFETCH_SIZE"
+
+/* Dataset metadata cache: number of closed datasets of a file kept open for
+ * reopening, and number of buckets of its hash table */
+#define H5VL_PDC_META_CACHE     256
+#define H5VL_PDC_META_BUCKETS   256
+#define H5VL_PDC_META_CACHE_ENV "HDF5_VOL_PDC_META_CACHE"
+
+/* Dataset creates are deferred until the next collective point, then made in a
+ * batch; the ranks agree on the creates already made by some of them this many
+ * at a time */
+#define H5VL_PDC_DEFER_CREATE_ENV "HDF5_VOL_PDC_DEFER_CREATE"
+#define H5VL_PDC_CREATE_AGREE     1024
+
+/* Collective metadata: the metadata lookups of the collective operations on a
+ * file opened on several ranks are made by rank 0 and broadcast to the others */
+#define H5VL_PDC_COLL_META_ENV "HDF5_VOL_PDC_COLL_METADATA"
+
+/* Byte budget of the read cache, shared by all files */
+#define H5VL_PDC_READ_CACHE_SIZE     (256 * 1048576)
+#define H5VL_PDC_READ_CACHE_SIZE_ENV "HDF5_VOL_PDC_READ_CACHE_SIZE"
+
+/* Sparse reads: a selection made of several regions is read as its bounding
+ * box, of at most SIEVE_MAX bytes, when that moves fewer bytes than the
+ * regions once each region transfer is charged SIEVE_COST bytes of overhead */
+#define H5VL_PDC_SIEVE_MAX      (16 * 1048576)
+#define H5VL_PDC_SIEVE_COST     (64 * 1024)
+#define H5VL_PDC_SIEVE_MAX_ENV  "HDF5_VOL_PDC_SIEVE_MAX"
+#define H5VL_PDC_SIEVE_COST_ENV "HDF5_VOL_PDC_SIEVE_COST"
+
+/* Property names used by the connector on HDF5 property lists */
+#define H5VL_PDC_WRITE_CACHE_PROP  "pdc_write_cache"
+#define H5VL_PDC_WRITE_BUF_PROP    "pdc_write_buffer"
+#define H5VL_PDC_FLUSH_THREAD_PROP "pdc_flush_thread"
+#define H5VL_PDC_CONSISTENCY_PROP  "pdc_consistency"
+#define H5VL_PDC_CHUNK_PROP        "pdc_chunking"
+#define H5VL_PDC_AGG_PROP          "pdc_aggregators"
+#define H5VL_PDC_AGG_XFER_PROP     "pdc_aggregation"
+#define H5VL_PDC_PREFETCH_PROP     "pdc_prefetch"
+#define H5VL_PDC_READ_AHEAD_PROP   "pdc_read_ahead"
+#define H5VL_PDC_READ_CACHE_PROP   "pdc_read_cache"
+#define H5VL_PDC_COLUMNAR_PROP     "pdc_columnar"
+#define H5VL_PDC_META_CACHE_PROP   "pdc_meta_cache"
+#define H5VL_PDC_COLL_META_PROP    "pdc_coll_metadata"
+#define H5VL_PDC_DEFER_CREATE_PROP "pdc_defer_create"
+
+/* Object tags holding the encoded HDF5 datatype of a dataset, and the number
+ * of member objects of a columnar compound dataset */
+#define H5VL_PDC_DTYPE_TAG    "PDC_H5T_DTYPE"
+#define H5VL_PDC_COLUMNAR_TAG "PDC_COLUMNAR"
+
+/* Container tag holding the namespace index of a file, and number of buckets
+ * of its hash table */
+#define H5VL_PDC_LINKS_TAG    "PDC_H5_LINKS"
+#define H5VL_PDC_LINK_BUCKETS 4096
+
+/* The PDC client is not thread-safe, every call into it is serialized with the flush threads */
+#define H5VL_PDC_LOCK()   hg_thread_mutex_lock(&pdc_lock_g)
+#define H5VL_PDC_UNLOCK() hg_thread_mutex_unlock(&pdc_lock_g)
 
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
-/* The VOL wrapper context */
-typedef struct H5VL_pdc_wrap_ctx_t {
-    hid_t under_vol_id;   /* VOL ID for under VOL */
-    void *under_wrap_ctx; /* Object wrapping context for under VOL */
-} H5VL_pdc_wrap_ctx_t;
+/* Write cache settings, as stored on a FAPL */
+typedef struct H5VL_pdc_cache_conf_t {
+    size_t   size;     /* Byte budget of the write cache */
+    unsigned high_pct; /* Flush once the cache is this full */
+    unsigned low_pct;  /* Drain the cache down to this level */
+} H5VL_pdc_cache_conf_t;
+
+/* Per-file write cache accounting */
+typedef struct H5VL_pdc_cache_t {
+    size_t max_size;  /* Byte budget for buffered write data */
+    size_t high_mark; /* Flush is triggered above this many cached bytes */
+    size_t low_mark;  /* A flush drains requests until this level is reached */
+    size_t cur_size;  /* Bytes currently held by deferred requests */
+} H5VL_pdc_cache_t;
+
+/* Chunking of large transfers, as stored on a FAPL */
+typedef struct H5VL_pdc_chunk_conf_t {
+    size_t   size;   /* Upper bound of the bytes moved by one region transfer */
+    unsigned window; /* Number of sub-region transfers kept in flight */
+} H5VL_pdc_chunk_conf_t;
+
+/* Write aggregation settings, as stored on a FAPL */
+typedef struct H5VL_pdc_agg_conf_t {
+    unsigned naggr;      /* Number of aggregator ranks, 0 for one per H5VL_PDC_AGG_GROUP ranks */
+    hbool_t  collective; /* Aggregate the writes made with a collective MPI-IO DXPL */
+} H5VL_pdc_agg_conf_t;
+
+/* Block announced by a rank to its aggregator */
+typedef struct H5VL_pdc_agg_desc_t {
+    uint64_t offset[H5VL_PDC_MAX_RANK];
+    uint64_t count[H5VL_PDC_MAX_RANK];
+    uint64_t size; /* Bytes sent to the aggregator, 0 when the rank writes the block itself */
+    int      ndim;
+} H5VL_pdc_agg_desc_t;
+
+/* Write buffer handling, as stored on a DXPL */
+typedef struct H5VL_pdc_buf_conf_t {
+    H5VL_pdc_buf_mode_t    mode;       /* How the user buffer is handed to the connector */
+    H5VL_pdc_buf_release_t release_cb; /* Called once a transfer no longer needs the buffer */
+    void *                 release_ctx;
+} H5VL_pdc_buf_conf_t;
+
+/* Buffer backing a deferred transfer request */
+typedef struct H5VL_pdc_buf_t {
+    void *                 buf;         /* Data to be transferred */
+    size_t                 size;        /* Size of buf in bytes */
+    hbool_t                cached;      /* Whether size is accounted in the write cache */
+    H5VL_pdc_buf_mode_t    mode;        /* Ownership of buf */
+    H5VL_pdc_buf_release_t release_cb;  /* User release callback, if any */
+    void *                 release_ctx; /* User context for release_cb */
+} H5VL_pdc_buf_t;
+
+/* Deferred write request, its PDC regions and transfer are created when it is started */
+typedef struct H5VL_pdc_xfer_t {
+    pdcid_t        obj_id;
+    int            ndim;
+    uint64_t       offset[H5VL_PDC_MAX_RANK]; /* Position of the block in the object */
+    uint64_t       count[H5VL_PDC_MAX_RANK];  /* Extent of the block, buf holds it in row-major order */
+    H5VL_pdc_buf_t buf;
+} H5VL_pdc_xfer_t;
+
+/* Blocks an aggregator receives, merged into runs written as one region each */
+typedef struct H5VL_pdc_agg_plan_t {
+    H5VL_pdc_xfer_t * blocks; /* Announced blocks, in the order of their ranks */
+    H5VL_pdc_xfer_t **sorted; /* The blocks by offset */
+    H5VL_pdc_xfer_t * runs;   /* Runs of adjacent blocks, with their staging buffers */
+    int *             first;  /* Index in sorted of the first block of each run, nrun + 1 entries */
+    int *             from;   /* Rank in the group of each block */
+    MPI_Request *     reqs;   /* Receives of the blocks of the other ranks */
+    int               n;
+    int               nrun;
+    int               nrecv; /* Receives posted and not waited for yet */
+} H5VL_pdc_agg_plan_t;
+
+/* Block read ahead from the dataset of the next timestep */
+typedef struct H5VL_pdc_ra_t {
+    char            name[ADDR_MAX]; /* PDC object name of the dataset */
+    pdcid_t         obj_id;
+    H5VL_pdc_xfer_t box; /* Selection, buf receives it */
+    size_t          elem;
+    pdcid_t         req; /* Transfer, 0 once it has been waited for */
+    pdcid_t         regions[2];
+} H5VL_pdc_ra_t;
+
+/* Last step read of a dataset in a sequence of groups named <prefix><step> */
+typedef struct H5VL_pdc_ra_hist_t {
+    char            key[ADDR_MAX]; /* Dataset name and group name prefix */
+    uint64_t        step;
+    H5VL_pdc_xfer_t box;
+    size_t          elem;
+} H5VL_pdc_ra_hist_t;
+
+/* Per-file read-ahead state */
+typedef struct H5VL_pdc_prefetch_t {
+    size_t              max_size; /* Byte budget of the read-ahead buffers, 0 disables read-ahead */
+    size_t              cur_size; /* Bytes held by read-ahead buffers */
+    H5VL_pdc_ra_t *     blocks;   /* Blocks read ahead, oldest first */
+    int                 cnt;
+    int                 alloc;
+    H5VL_pdc_ra_hist_t *hist; /* Tracked sequences, allocated on first use */
+    int                 nhist;
+    int                 hist_next; /* Slot reused once all are taken */
+} H5VL_pdc_prefetch_t;
+
+/* Region kept by the read cache */
+typedef struct H5VL_pdc_rc_ent_t {
+    struct H5VL_pdc_obj_t *   file;           /* File the dataset belongs to */
+    char                      name[ADDR_MAX]; /* PDC object name of the dataset */
+    H5VL_pdc_xfer_t           box;            /* Region, buf holds its data */
+    size_t                    elem;
+    struct H5VL_pdc_rc_ent_t *prev;           /* Next more recently used region */
+    struct H5VL_pdc_rc_ent_t *next;           /* Next less recently used region */
+} H5VL_pdc_rc_ent_t;
+
+/* Regions read from datasets that enable the read cache, shared by all files */
+typedef struct H5VL_pdc_rcache_t {
+    hbool_t            init;     /* Whether the settings were resolved */
+    size_t             max_size; /* Byte budget of the cached regions, 0 disables the cache */
+    size_t             cur_size; /* Bytes held by cached regions */
+    H5VL_pdc_rc_ent_t *head;     /* Most recently used region */
+    H5VL_pdc_rc_ent_t *tail;     /* Least recently used region, evicted first */
+} H5VL_pdc_rcache_t;
+
+/* An attribute of a PDC object or container, stored as a tag and kept in
+ * memory so that getting its datatype, space and value needs no server round
+ * trip; written values are held until the object is closed or flushed */
+typedef struct H5VL_pdc_attr_ent_t {
+    char *                      name;
+    pdcid_t                     obj_id; /* Object holding the tag, 0 for the container */
+    pdcid_t                     cont_id;
+    hid_t                       type_id; /* Datatype it was created with, or derived from its tag */
+    hid_t                       space_id;
+    pdc_var_type_t              pdc_type; /* PDC type the value is stored with */
+    void *                      value;    /* NULL until the value is written or fetched */
+    psize_t                     size;
+    hbool_t                     dirty; /* Written since it was last pushed to the servers */
+    struct H5VL_pdc_attr_ent_t *next;
+} H5VL_pdc_attr_ent_t;
+
+/* Metadata of a dataset object, shared by the open handles of the dataset and
+ * kept once they are closed, so that reopening it needs no server round trip */
+typedef struct H5VL_pdc_meta_t {
+    char                    name[ADDR_MAX]; /* PDC object name of the dataset */
+    pdcid_t                 obj_id;
+    pdc_var_type_t          pdc_type;
+    psize_t                 compound_size;
+    hid_t                   type_id;
+    int                     ndim;
+    hsize_t                 dims[H5S_MAX_RANK];
+    pdcid_t *               member_ids; /* Member objects of a columnar dataset, NULL otherwise */
+    int                     nmembers;
+    H5VL_pdc_attr_ent_t *   attrs;  /* Attributes of the dataset */
+    int                     nref;   /* Open handles */
+    hbool_t                 linked; /* Whether the entry can be found, FALSE once invalidated */
+    struct H5VL_pdc_meta_t *hnext;  /* Next entry of the hash bucket */
+    struct H5VL_pdc_meta_t *prev;   /* Next more recently closed entry */
+    struct H5VL_pdc_meta_t *next;   /* Next less recently closed entry */
+} H5VL_pdc_meta_t;
+
+/* A dataset create deferred until the next collective point, then made with
+ * the other deferred creates of its file. An independent operation that needs
+ * the object earlier makes it on its own, the record then stays in the batch
+ * with its name only. */
+typedef struct H5VL_pdc_create_t {
+    char                      name[ADDR_MAX]; /* PDC object name of the dataset */
+    pdcid_t                   obj_prop;       /* Object property with the type and dimensions */
+    void *                    type_buf;       /* Encoded datatype, for the datatype tag */
+    size_t                    type_size;
+    psize_t                   compound_size; /* Element size of a compound dataset, 0 otherwise */
+    struct H5VL_pdc_obj_t *   dset;          /* Handle waiting for the object, NULL once closed */
+    hbool_t                   made;          /* Made by this rank ahead of the batch */
+    struct H5VL_pdc_create_t *next;
+} H5VL_pdc_create_t;
+
+/* A link of the namespace of a file, to a group or a dataset. Links are added
+ * by the creates and opens of the file and loaded from the index stored in its
+ * container, so that groups are listed without asking the servers. */
+typedef struct H5VL_pdc_link_t {
+    char *                  path; /* Absolute HDF5 path of the object */
+    const char *            name; /* Last component of the path */
+    H5O_type_t              type;
+    int64_t                 corder;     /* Creation order among the links of the parent */
+    int64_t                 max_corder; /* Creation order of the next link of a group */
+    hsize_t                 nlinks;     /* Links of a group */
+    struct H5VL_pdc_link_t *parent;
+    struct H5VL_pdc_link_t *first;   /* Links of a group, in creation order */
+    struct H5VL_pdc_link_t *last;    /* Last of them, where the next one is appended */
+    struct H5VL_pdc_link_t *sibling; /* Next link of the parent */
+    struct H5VL_pdc_link_t *hnext;   /* Next link of the hash bucket */
+} H5VL_pdc_link_t;
+
+/* Per-file namespace index */
+typedef struct H5VL_pdc_links_t {
+    H5VL_pdc_link_t **buckets; /* Links by path, allocated when the file is created or opened */
+    H5VL_pdc_link_t * root;
+    hbool_t           dirty; /* Changed since it was stored */
+} H5VL_pdc_links_t;
+
+/* Per-file dataset metadata cache */
+typedef struct H5VL_pdc_meta_cache_t {
+    unsigned          max_closed; /* Closed datasets kept, 0 keeps none */
+    unsigned          nclosed;
+    H5VL_pdc_meta_t **buckets; /* Entries by name, allocated on first use */
+    H5VL_pdc_meta_t * head;    /* Most recently closed entry */
+    H5VL_pdc_meta_t * tail;    /* Least recently closed entry, evicted first */
+} H5VL_pdc_meta_cache_t;
+
+/* Sieving of sparse reads, shared by all files */
+typedef struct H5VL_pdc_sieve_t {
+    hbool_t init;     /* Whether the settings were resolved */
+    size_t  max_size; /* Largest bounding box read in place of regions, 0 disables sieving */
+    size_t  cost;     /* Overhead of a region transfer, in bytes */
+} H5VL_pdc_sieve_t;
+
+/* Member of a columnar compound dataset moved by a transfer */
+typedef struct H5VL_pdc_member_t {
+    int             idx;       /* Index of the member in the datatype of the dataset */
+    size_t          mem_off;   /* Offset of the member in a memory element */
+    size_t          mem_size;  /* Size of the member in memory */
+    size_t          file_size; /* Size of the member in its object */
+    size_t          scale;     /* Elements of its object per dataset element, file_size for byte objects */
+    H5VL_pdc_conv_t conv;      /* Conversion on the way, src_size is 0 when there is none */
+} H5VL_pdc_member_t;
+
+/* Per-file background flush engine */
+typedef struct H5VL_pdc_flush_t {
+    hbool_t           enabled;  /* Whether the progress thread is running */
+    hbool_t           shutdown; /* Asks the progress thread to exit */
+    hbool_t           failed;   /* A background transfer failed since the last drain */
+    hg_thread_t       thread;
+    hg_thread_mutex_t mutex;  /* Protects the pending list, the batch count and cache accounting */
+    hg_thread_cond_t  queued; /* Signaled when requests are queued or on shutdown */
+    hg_thread_cond_t  done;   /* Signaled when an in-flight batch has completed */
+    H5VL_pdc_xfer_t * xfers;  /* In-flight batch, swapped with the pending list of the file */
+    int               alloc;
+    int               cnt;
+    int               npin; /* Reads copying from the pending list, which is not taken meanwhile */
+} H5VL_pdc_flush_t;
 
 /* Common object information */
 typedef struct H5VL_pdc_obj_t {
@@ -83,12 +400,11 @@ typedef struct H5VL_pdc_obj_t {
     psize_t        compound_size;
     pdcid_t        reg_id_from;
     pdcid_t        reg_id_to;
-    pdcid_t *      xfer_requests;
+    H5VL_pdc_xfer_t *xfers;
     int            req_alloc;
     int            req_cnt;
     H5I_type_t     h5i_type;
     H5O_type_t     h5o_type;
-    void **        bufs;
     /* File object elements */
     MPI_Comm               comm;
     MPI_Info               info;
@@ -97,14 +413,40 @@ typedef struct H5VL_pdc_obj_t {
     pdcid_t                cont_id;
     int                    nobj;
     struct H5VL_pdc_obj_t *file_obj_ptr;
+    H5VL_pdc_cache_t       cache;
+    H5VL_pdc_stats_t       stats; /* Under the flush mutex while the flush thread runs */
+    H5VL_pdc_flush_t       flush;
+    H5VL_pdc_consistency_t consistency;
+    H5VL_pdc_chunk_conf_t  chunk;
+    H5VL_pdc_agg_conf_t    agg;
+    MPI_Comm               agg_comm;  /* Ranks sharing an aggregator, created on first use */
+    H5VL_pdc_agg_desc_t *  agg_descs; /* Blocks announced to this rank when it is an aggregator */
+    H5VL_pdc_prefetch_t    prefetch;
+    H5VL_pdc_meta_cache_t  mcache;       /* Metadata of the datasets opened or created, by name */
+    hbool_t                coll_meta;    /* Metadata lookups are made by rank 0 and broadcast */
+    hbool_t                coll_world;   /* The communicator spans all PDC clients */
+    hbool_t                defer_create; /* Dataset creates wait for the next batch */
+    H5VL_pdc_create_t *    creates;      /* Deferred dataset creates, in the order they were made */
+    H5VL_pdc_create_t *    creates_last; /* Last of them, where the next one is appended */
+    H5VL_pdc_attr_ent_t *  attrs;        /* Attributes of the container and its groups */
+    H5VL_pdc_links_t       links;        /* Groups and datasets of the file, by path */
     H5_LIST_HEAD(H5VL_pdc_obj_t) ids;
     /* Dataset object elements */
-    hid_t   dcpl_id;
-    hid_t   dapl_id;
-    hid_t   dxpl_id;
-    hid_t   type_id;
-    hid_t   space_id;
-    hbool_t mapped;
+    hid_t              dcpl_id;
+    hid_t              dapl_id;
+    hid_t              dxpl_id;
+    hid_t              type_id;
+    hid_t              space_id;
+    hbool_t            mapped;
+    char *             dset_name;  /* Name the dataset was opened with, for read-ahead */
+    int                read_ahead; /* DAPL read-ahead hint: 1 always, 0 never, -1 on detected traversals */
+    hbool_t            read_cache; /* DAPL: keep the regions read in the read cache */
+    pdcid_t *          member_ids; /* Objects of the members of a columnar compound dataset, NULL otherwise */
+    int                nmembers;
+    H5VL_pdc_meta_t *  meta;   /* Metadata shared with the other handles of the dataset */
+    H5VL_pdc_create_t *create; /* Create of the object while it is deferred, NULL once it exists */
+    /* Group object elements */
+    char *link_path; /* Absolute HDF5 path of the group */
     H5_LIST_ENTRY(H5VL_pdc_obj_t) entry;
 } H5VL_pdc_obj_t;
 
@@ -129,13 +471,6 @@ static herr_t H5VL_pdc_info_free(void *info);
 static herr_t H5VL_pdc_info_to_str(const void *info, char **str);
 static herr_t H5VL_pdc_str_to_info(const char *str, void **info);
 
-/* VOL object wrap / retrieval callbacks */
-static void * H5VL_pdc_get_object(const void *obj);
-static herr_t H5VL_pdc_get_wrap_ctx(const void *obj, void **wrap_ctx);
-static void * H5VL_pdc_wrap_object(void *obj, H5I_type_t obj_type, void *wrap_ctx);
-static void * H5VL_pdc_unwrap_object(void *obj);
-static herr_t H5VL_pdc_free_wrap_ctx(void *obj);
-
 /* File callbacks */
 static void * H5VL_pdc_file_create(const char *name, unsigned flags, hid_t fcpl_id, hid_t fapl_id,
                                    hid_t dxpl_id, void **req);
@@ -259,132 +594,287 @@ static herr_t H5VL_pdc_token_from_str(void *obj, H5I_type_t obj_type, const char
 /* Generic optional callback */
 static herr_t H5VL_pdc_optional(void *obj, H5VL_optional_args_t *args, hid_t dxpl_id, void **req);
 
+/* Property list helpers */
+static herr_t H5VL__pdc_plist_set(hid_t plist_id, const char *name, size_t size, const void *value);
+static htri_t H5VL__pdc_plist_get(hid_t plist_id, const char *name, size_t size, void *value);
+
+/* Write cache helpers */
+static herr_t H5VL__pdc_cache_conf_get(hid_t fapl_id, H5VL_pdc_cache_conf_t *conf);
+static herr_t H5VL__pdc_file_drain(H5VL_pdc_obj_t *file, size_t target);
+static herr_t H5VL__pdc_buf_conf_get(hid_t dxpl_id, H5VL_pdc_buf_conf_t *conf);
+static void   H5VL__pdc_buf_release(H5VL_pdc_buf_t *buf);
+static perr_t H5VL__pdc_xfer_wait(pdcid_t *reqs, int n, hbool_t poll);
+static int    H5VL__pdc_xfer_cmp(const void *_a, const void *_b);
+static H5VL_pdc_xfer_t *H5VL__pdc_xfer_coalesce(H5VL_pdc_xfer_t *xfers, int *nreq, size_t max_size);
+static herr_t H5VL__pdc_xfer_complete(H5VL_pdc_xfer_t *xfers, int nreq, const H5VL_pdc_chunk_conf_t *chunk,
+                                      hbool_t poll, int *nmerged, uint64_t *nxfer, uint64_t *nchunked);
+static hbool_t H5VL__pdc_xfer_overlap(const H5VL_pdc_xfer_t *xfers, int nreq, const H5VL_pdc_xfer_t *boxes,
+                                      int nbox);
+static herr_t  H5VL__pdc_file_drain_overlap(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *boxes, int nbox);
+static herr_t  H5VL__pdc_file_drain_obj(H5VL_pdc_obj_t *file, pdcid_t obj_id, const pdcid_t *member_ids,
+                                        int nmembers);
+static herr_t  H5VL__pdc_consistency_get(hid_t fapl_id, H5VL_pdc_consistency_t *mode);
+static herr_t  H5VL__pdc_cache_reserve(H5VL_pdc_obj_t *file, size_t size);
+
+/* Chunked transfer helpers */
+static herr_t   H5VL__pdc_chunk_conf_get(hid_t fapl_id, H5VL_pdc_chunk_conf_t *conf);
+static uint64_t H5VL__pdc_chunk_plan(const H5VL_pdc_xfer_t *box, size_t elem, size_t chunk_size, int *dim,
+                                     uint64_t *step);
+static size_t   H5VL__pdc_chunk_piece(const H5VL_pdc_xfer_t *box, size_t elem, int dim, uint64_t step,
+                                      uint64_t idx, H5VL_pdc_xfer_t *piece);
+static herr_t   H5VL__pdc_xfer_stream(const H5VL_pdc_chunk_conf_t *chunk, pdcid_t obj_id, pdc_access_t access,
+                                      const H5VL_pdc_xfer_t *box, void *buf, size_t elem, uint64_t first,
+                                      uint64_t last, hbool_t poll, uint64_t *nxfer);
+
+/* Write aggregation helpers */
+static herr_t H5VL__pdc_agg_conf_get(hid_t fapl_id, H5VL_pdc_agg_conf_t *conf);
+static herr_t H5VL__pdc_agg_enabled(H5VL_pdc_obj_t *file, hid_t dxpl_id, hbool_t *enabled);
+static herr_t H5VL__pdc_agg_plan(const H5VL_pdc_xfer_t *xfer, const H5VL_pdc_agg_desc_t *descs, int gsize,
+                                 H5VL_pdc_agg_plan_t *plan);
+static void   H5VL__pdc_agg_plan_free(H5VL_pdc_agg_plan_t *plan);
+static herr_t H5VL__pdc_agg_post(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *xfer,
+                                 H5VL_pdc_agg_plan_t *plan);
+static herr_t H5VL__pdc_agg_gather(H5VL_pdc_obj_t *file, H5VL_pdc_agg_plan_t *plan);
+static herr_t H5VL__pdc_agg_write(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *xfer, hbool_t failed,
+                                  hbool_t *done);
+
+/* Read-ahead helpers */
+static herr_t H5VL__pdc_prefetch_conf_get(hid_t fapl_id, size_t *size);
+static hbool_t H5VL__pdc_prefetch_step(const char *group, size_t *prefix_len, uint64_t *step, int *width);
+static void    H5VL__pdc_prefetch_release(H5VL_pdc_obj_t *file, int idx);
+static void    H5VL__pdc_prefetch_drop(H5VL_pdc_obj_t *file, const char *name);
+static void    H5VL__pdc_prefetch_issue(H5VL_pdc_obj_t *file, const char *name, const H5VL_pdc_xfer_t *box,
+                                        size_t elem);
+static void    H5VL__pdc_prefetch_note(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box,
+                                       size_t elem);
+static htri_t  H5VL__pdc_prefetch_take(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box,
+                                       size_t elem, void *buf);
+
+/* Dataset metadata cache helpers */
+static herr_t           H5VL__pdc_meta_conf_get(hid_t fapl_id, unsigned *max_closed);
+static unsigned         H5VL__pdc_meta_hash(const char *name);
+static H5VL_pdc_meta_t *H5VL__pdc_meta_lookup(H5VL_pdc_obj_t *file, const char *name);
+static herr_t           H5VL__pdc_meta_insert(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset);
+static herr_t           H5VL__pdc_meta_free(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent);
+static herr_t           H5VL__pdc_meta_unlink(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent);
+static herr_t           H5VL__pdc_meta_release(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent);
+static herr_t           H5VL__pdc_meta_invalidate(H5VL_pdc_obj_t *file, const char *name);
+
+/* Collective metadata helpers */
+static herr_t  H5VL__pdc_coll_conf_get(hid_t fapl_id, hbool_t *enabled);
+static pdcid_t H5VL__pdc_obj_open(H5VL_pdc_obj_t *file, const char *name);
+static perr_t  H5VL__pdc_tag_get(H5VL_pdc_obj_t *file, hbool_t coll, pdcid_t obj_id, pdcid_t cont_id,
+                                 const char *tag_name, void **value, pdc_var_type_t *type, psize_t *size);
+
+/* Deferred create helpers */
+static herr_t H5VL__pdc_defer_conf_get(hid_t fapl_id, hbool_t *enabled);
+static herr_t H5VL__pdc_create_defer(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, pdcid_t obj_prop,
+                                     void *type_buf, size_t type_size);
+static herr_t H5VL__pdc_create_tag(H5VL_pdc_create_t *create, pdcid_t obj_id);
+static herr_t H5VL__pdc_create_attach(H5VL_pdc_obj_t *file, H5VL_pdc_create_t *create, pdcid_t obj_id);
+static herr_t H5VL__pdc_create_one(H5VL_pdc_obj_t *file, H5VL_pdc_create_t *create);
+static herr_t H5VL__pdc_create_flush(H5VL_pdc_obj_t *file);
+
+/* Attribute cache helpers */
+static H5VL_pdc_attr_ent_t *H5VL__pdc_attr_find(H5VL_pdc_obj_t *attr, hbool_t create);
+static herr_t               H5VL__pdc_attr_fetch(H5VL_pdc_obj_t *file, H5VL_pdc_attr_ent_t *ent);
+static herr_t               H5VL__pdc_attr_convert(const H5VL_pdc_attr_ent_t *ent, hid_t src_id, hid_t dst_id,
+                                                   const void *in, void *out);
+static herr_t               H5VL__pdc_attr_push(H5VL_pdc_obj_t *file, H5VL_pdc_attr_ent_t *list);
+static herr_t               H5VL__pdc_attr_flush(H5VL_pdc_obj_t *file);
+static void                 H5VL__pdc_attr_free(H5VL_pdc_attr_ent_t *list);
+
+/* Namespace index helpers */
+static herr_t           H5VL__pdc_link_path(H5VL_pdc_obj_t *o, const char *name, char *path, size_t size);
+static unsigned         H5VL__pdc_link_hash(const char *path);
+static H5VL_pdc_link_t *H5VL__pdc_link_find(H5VL_pdc_obj_t *file, const char *path);
+static H5VL_pdc_link_t *H5VL__pdc_link_add(H5VL_pdc_obj_t *file, const char *path, H5O_type_t type);
+static void             H5VL__pdc_link_remove(H5VL_pdc_obj_t *file, H5VL_pdc_link_t *link);
+static int              H5VL__pdc_link_name_cmp(const void *_a, const void *_b);
+static herr_t           H5VL__pdc_link_list(H5VL_pdc_link_t *grp, H5_index_t idx_type, H5_iter_order_t order,
+                                            H5VL_pdc_link_t ***links);
+static H5VL_pdc_link_t *H5VL__pdc_link_loc(H5VL_pdc_obj_t *o, const H5VL_loc_params_t *loc_params);
+static void             H5VL__pdc_link_info(const H5VL_pdc_link_t *link, H5L_info2_t *linfo);
+static herr_t           H5VL__pdc_link_iterate(H5VL_pdc_link_t *grp, const char *prefix, hid_t group_id,
+                                               hsize_t *idx_p, H5VL_link_iterate_args_t *iter);
+static H5VL_pdc_link_t *H5VL__pdc_link_next(H5VL_pdc_link_t *link);
+static herr_t           H5VL__pdc_links_open(H5VL_pdc_obj_t *file, hbool_t load);
+static herr_t           H5VL__pdc_links_encode(H5VL_pdc_obj_t *file, char **buf, size_t *size);
+static herr_t           H5VL__pdc_links_decode(H5VL_pdc_obj_t *file, const char *buf, size_t size);
+static herr_t           H5VL__pdc_links_store(H5VL_pdc_obj_t *file);
+static void             H5VL__pdc_links_free(H5VL_pdc_obj_t *file);
+static H5VL_pdc_obj_t * H5VL__pdc_group_init(H5VL_pdc_obj_t *o, const char *group_name, const char *path);
+
+/* Sieving helpers */
+static void    H5VL__pdc_sieve_init(void);
+static void    H5VL__pdc_sieve_get(H5VL_pdc_sieve_t *sieve);
+static hbool_t H5VL__pdc_sieve_plan(const H5VL_pdc_block_t *blocks, size_t nblocks, size_t elem,
+                                    H5VL_pdc_block_t *box);
+static size_t  H5VL__pdc_sieve_copy(H5VL_pdc_memmap_t *map, const H5VL_pdc_xfer_t *box,
+                                    const H5VL_pdc_block_t *blocks, size_t nblocks,
+                                    const H5VL_pdc_conv_t *conv, void *buf);
+
+/* Datatype mapping helpers */
+static pdc_var_type_t H5VL__pdc_type_to_pdc(hid_t type_id);
+static hid_t          H5VL__pdc_type_from_pdc(pdc_var_type_t pdc_type);
+static hbool_t        H5VL__pdc_type_is_int(pdc_var_type_t pdc_type);
+
+/* Columnar compound helpers */
+static pdc_var_type_t H5VL__pdc_member_type(hid_t type_id, size_t *scale);
+static void           H5VL__pdc_field_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride,
+                                           size_t size, size_t n);
+static void   H5VL__pdc_columns_split(const H5VL_pdc_member_t *members, int nmembers, void **cols,
+                                      const void *src, size_t n, size_t stride);
+static void   H5VL__pdc_columns_merge(const H5VL_pdc_member_t *members, int nmembers, void *const *cols,
+                                      void *dst, size_t n, size_t stride);
+static herr_t H5VL__pdc_columnar_create(H5VL_pdc_obj_t *o, H5VL_pdc_obj_t *dset);
+static herr_t H5VL__pdc_columnar_open(H5VL_pdc_obj_t *dset);
+static herr_t H5VL__pdc_columnar_members(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hbool_t to_mem,
+                                         H5VL_pdc_member_t **members, int *nmembers);
+static herr_t H5VL__pdc_columnar_write(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hid_t mem_space_id,
+                                       hid_t file_space_id, const void *buf);
+static herr_t H5VL__pdc_columnar_read(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hid_t mem_space_id,
+                                      hid_t file_space_id, void *buf);
+
+/* Write helpers */
+static herr_t H5VL__pdc_write_block(H5VL_pdc_obj_t *file, H5VL_pdc_xfer_t *xfer, H5VL_pdc_memmap_t *map,
+                                    const H5VL_pdc_block_t *blk, size_t elem, const H5VL_pdc_conv_t *conv);
+
+/* Read cache helpers */
+static void H5VL__pdc_rcache_init(void);
+static void H5VL__pdc_rcache_evict(H5VL_pdc_rc_ent_t *ent);
+static void H5VL__pdc_rcache_drop(H5VL_pdc_obj_t *file, const char *name);
+static void H5VL__pdc_rcache_shrink(size_t size);
+static int  H5VL__pdc_rcache_lookup(H5VL_pdc_obj_t *dset, H5VL_pdc_xfer_t *box, size_t elem,
+                                    H5VL_pdc_xfer_t *missing);
+static void H5VL__pdc_rcache_insert(H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box, size_t elem,
+                                    const void *buf);
+
+/* Read helpers */
+static void   H5VL__pdc_box_copy(void *dst, const uint64_t *dst_off, const uint64_t *dst_cnt, const void *src,
+                                 const uint64_t *src_off, const uint64_t *src_cnt, const uint64_t *off,
+                                 const uint64_t *cnt, int ndim, size_t elem);
+static int    H5VL__pdc_box_subtract(const H5VL_pdc_xfer_t *box, const H5VL_pdc_xfer_t *cut,
+                                     H5VL_pdc_xfer_t *pieces);
+static int    H5VL__pdc_cache_lookup(H5VL_pdc_obj_t *file, H5VL_pdc_xfer_t *box, size_t elem,
+                                     H5VL_pdc_xfer_t *missing);
+static herr_t H5VL__pdc_read_box(H5VL_pdc_obj_t *file, pdcid_t obj_id, const H5VL_pdc_xfer_t *box,
+                                 size_t elem, void *buf);
+
+/* Flush engine helpers */
+static herr_t                H5VL__pdc_flush_conf_get(hid_t fapl_id, hbool_t *enabled);
+static herr_t                H5VL__pdc_flush_start(H5VL_pdc_obj_t *file);
+static herr_t                H5VL__pdc_flush_stop(H5VL_pdc_obj_t *file);
+static HG_THREAD_RETURN_TYPE H5VL__pdc_flush_thread(void *arg);
+
 /*******************/
 /* Local variables */
 /*******************/
 
 /* The PDC VOL plugin struct */
 static const H5VL_class_t H5VL_pdc_g = {
-    H5VL_VERSION,                       /* version */
-    (H5VL_class_value_t)H5VL_PDC_VALUE, /* value */
-    H5VL_PDC_NAME_STRING,               /* name */
-    0,                                  /* connector version */
-    H5VL_CAP_FLAG_ASYNC,                /* capability flags */
-    H5VL_pdc_init,                      /* initialize */
-    H5VL_pdc_obj_term,                  /* terminate */
-    {
-        /* info_cls */
-        sizeof(H5VL_pdc_info_t), /* info size */
-        H5VL_pdc_info_copy,      /* info copy */
-        H5VL_pdc_info_cmp,       /* info compare */
-        H5VL_pdc_info_free,      /* info free */
-        H5VL_pdc_info_to_str,    /* to_str */
-        H5VL_pdc_str_to_info,    /* from_str */
+    .version      = H5VL_VERSION,
+    .value        = (H5VL_class_value_t)H5VL_PDC_VALUE,
+    .name         = H5VL_PDC_NAME_STRING,
+    .conn_version = 0,
+    .cap_flags    = H5VL_CAP_FLAG_ASYNC,
+    .initialize   = H5VL_pdc_init,
+    .terminate    = H5VL_pdc_obj_term,
+    .info_cls = {
+        .size     = sizeof(H5VL_pdc_info_t),
+        .copy     = H5VL_pdc_info_copy,
+        .cmp      = H5VL_pdc_info_cmp,
+        .free     = H5VL_pdc_info_free,
+        .to_str   = H5VL_pdc_info_to_str,
+        .from_str = H5VL_pdc_str_to_info,
     },
-    {
-        /* wrap_cls */
-        NULL, NULL, NULL, NULL, NULL,
-        /* H5VL_pdc_get_object,    /1* get_object   *1/ */
-        /* H5VL_pdc_get_wrap_ctx,  /1* get_wrap_ctx *1/ */
-        /* H5VL_pdc_wrap_object,   /1* wrap_object  *1/ */
-        /* H5VL_pdc_unwrap_object, /1* unwrap_object *1/ */
-        /* H5VL_pdc_free_wrap_ctx  /1* free_wrap_ctx *1/ */
+    /* Objects are not wrapped: get_object, get_wrap_ctx, wrap_object, unwrap_object
+     * and free_wrap_ctx are left unset */
+    .wrap_cls = {NULL},
+    .attr_cls = {
+        .create   = H5VL_pdc_attr_create,
+        .open     = H5VL_pdc_attr_open,
+        .read     = H5VL_pdc_attr_read,
+        .write    = H5VL_pdc_attr_write,
+        .get      = H5VL_pdc_attr_get,
+        .specific = H5VL_pdc_attr_specific,
+        .optional = H5VL_pdc_attr_optional,
+        .close    = H5VL_pdc_attr_close,
     },
-    {
-        /* attribute_cls */
-        H5VL_pdc_attr_create,   /* create */
-        H5VL_pdc_attr_open,     /* open */
-        H5VL_pdc_attr_read,     /* read */
-        H5VL_pdc_attr_write,    /* write */
-        H5VL_pdc_attr_get,      /* get */
-        H5VL_pdc_attr_specific, /* specific */
-        H5VL_pdc_attr_optional, /* optional */
-        H5VL_pdc_attr_close     /* close */
+    .dataset_cls = {
+        .create   = H5VL_pdc_dataset_create,
+        .open     = H5VL_pdc_dataset_open,
+        .read     = H5VL_pdc_dataset_read,
+        .write    = H5VL_pdc_dataset_write,
+        .get      = H5VL_pdc_dataset_get,
+        .specific = H5VL_pdc_dataset_specific,
+        .optional = H5VL_pdc_dataset_optional,
+        .close    = H5VL_pdc_dataset_close,
     },
-    {
-        /* dataset_cls  */
-        H5VL_pdc_dataset_create,   /* create */
-        H5VL_pdc_dataset_open,     /* open */
-        H5VL_pdc_dataset_read,     /* read */
-        H5VL_pdc_dataset_write,    /* write */
-        H5VL_pdc_dataset_get,      /* get */
-        H5VL_pdc_dataset_specific, /* specific */
-        H5VL_pdc_dataset_optional, /* optional */
-        H5VL_pdc_dataset_close     /* close */
+    .datatype_cls = {
+        .commit   = H5VL_pdc_datatype_commit,
+        .open     = H5VL_pdc_datatype_open,
+        .get      = H5VL_pdc_datatype_get,
+        .specific = H5VL_pdc_datatype_specific,
+        .optional = H5VL_pdc_datatype_optional,
+        .close    = H5VL_pdc_datatype_close,
     },
-    {
-        /* datatype_cls */
-        H5VL_pdc_datatype_commit,   /* commit */
-        H5VL_pdc_datatype_open,     /* open */
-        H5VL_pdc_datatype_get,      /* get_size */
-        H5VL_pdc_datatype_specific, /* specific */
-        H5VL_pdc_datatype_optional, /* optional */
-        H5VL_pdc_datatype_close     /* close */
+    .file_cls = {
+        .create   = H5VL_pdc_file_create,
+        .open     = H5VL_pdc_file_open,
+        .get      = H5VL_pdc_file_get,
+        .specific = H5VL_pdc_file_specific,
+        .optional = H5VL_pdc_file_optional,
+        .close    = H5VL_pdc_file_close,
     },
-    {
-        /* file_cls     */
-        H5VL_pdc_file_create,   /* create */
-        H5VL_pdc_file_open,     /* open */
-        H5VL_pdc_file_get,      /* get */
-        H5VL_pdc_file_specific, /* specific */
-        H5VL_pdc_file_optional, /* optional */
-        H5VL_pdc_file_close     /* close */
+    .group_cls = {
+        .create   = H5VL_pdc_group_create,
+        .open     = H5VL_pdc_group_open,
+        .get      = H5VL_pdc_group_get,
+        .specific = H5VL_pdc_group_specific,
+        .optional = H5VL_pdc_group_optional,
+        .close    = H5VL_pdc_group_close,
     },
-    {
-        /* group_cls    */
-        H5VL_pdc_group_create,   /* create */
-        H5VL_pdc_group_open,     /* open */
-        H5VL_pdc_group_get,      /* get */
-        H5VL_pdc_group_specific, /* specific */
-        H5VL_pdc_group_optional, /* optional */
-        H5VL_pdc_group_close     /* close */
+    .link_cls = {
+        .create   = H5VL_pdc_link_create,
+        .copy     = H5VL_pdc_link_copy,
+        .move     = H5VL_pdc_link_move,
+        .get      = H5VL_pdc_link_get,
+        .specific = H5VL_pdc_link_specific,
+        .optional = H5VL_pdc_link_optional,
     },
-    {
-        /* link_cls     */
-        H5VL_pdc_link_create,   /* create */
-        H5VL_pdc_link_copy,     /* copy */
-        H5VL_pdc_link_move,     /* move */
-        H5VL_pdc_link_get,      /* get */
-        H5VL_pdc_link_specific, /* specific */
-        H5VL_pdc_link_optional  /* optional */
+    .object_cls = {
+        .open     = H5VL_pdc_object_open,
+        .copy     = H5VL_pdc_object_copy,
+        .get      = H5VL_pdc_object_get,
+        .specific = H5VL_pdc_object_specific,
+        .optional = H5VL_pdc_object_optional,
     },
-    {
-        /* object_cls   */
-        H5VL_pdc_object_open,     /* open */
-        H5VL_pdc_object_copy,     /* copy */
-        H5VL_pdc_object_get,      /* get */
-        H5VL_pdc_object_specific, /* specific */
-        H5VL_pdc_object_optional  /* optional */
+    .introspect_cls = {
+        .get_conn_cls  = H5VL_pdc_introspect_get_conn_cls,
+        .get_cap_flags = H5VL_pdc_introspect_get_cap_flags,
+        .opt_query     = H5VL_pdc_introspect_opt_query,
     },
-    {
-        /* introspect_cls */
-        H5VL_pdc_introspect_get_conn_cls,  /* get_conn_cls */
-        H5VL_pdc_introspect_get_cap_flags, /* get_cap_flags */
-        H5VL_pdc_introspect_opt_query      /* opt_query */
+    .request_cls = {
+        .wait     = H5VL_pdc_request_wait,
+        .notify   = H5VL_pdc_request_notify,
+        .cancel   = H5VL_pdc_request_cancel,
+        .specific = H5VL_pdc_request_specific,
+        .optional = H5VL_pdc_request_optional,
+        .free     = H5VL_pdc_request_free,
     },
-    {
-        /* request_cls  */
-        H5VL_pdc_request_wait,     /* wait */
-        H5VL_pdc_request_notify,   /* notify */
-        H5VL_pdc_request_cancel,   /* cancel */
-        H5VL_pdc_request_specific, /* specific */
-        H5VL_pdc_request_optional, /* optional */
-        H5VL_pdc_request_free      /* free */
+    .blob_cls = {
+        .put      = H5VL_pdc_blob_put,
+        .get      = H5VL_pdc_blob_get,
+        .specific = H5VL_pdc_blob_specific,
+        .optional = H5VL_pdc_blob_optional,
     },
-    {
-        /* blob_cls */
-        H5VL_pdc_blob_put,      /* put */
-        H5VL_pdc_blob_get,      /* get */
-        H5VL_pdc_blob_specific, /* specific */
-        H5VL_pdc_blob_optional  /* optional */
+    .token_cls = {
+        .cmp      = H5VL_pdc_token_cmp,
+        .to_str   = H5VL_pdc_token_to_str,
+        .from_str = H5VL_pdc_token_from_str,
     },
-    {
-        /* token_cls */
-        H5VL_pdc_token_cmp,     /* cmp */
-        H5VL_pdc_token_to_str,  /* to_str */
-        H5VL_pdc_token_from_str /* from_str */
-    },
-    H5VL_pdc_optional /* optional */
+    .optional = H5VL_pdc_optional,
 };
 
 /* The connector identification number, initialized at runtime */
@@ -395,8 +885,20 @@ static hbool_t H5VL_pdc_init_g = FALSE;
 hid_t H5VL_ERR_STACK_g = H5I_INVALID_HID;
 hid_t H5VL_ERR_CLS_g   = H5I_INVALID_HID;
 
-static pdcid_t pdc_id_g  = 0;
-static int     my_rank_g = 0;
+/* Rank printed by the log messages */
+int my_rank_g = 0;
+
+static pdcid_t           pdc_id_g = 0;
+static hg_thread_mutex_t pdc_lock_g;
+
+/* Read cache shared by all files, may be configured before the connector is
+ * initialized */
+static H5VL_pdc_rcache_t rcache_g;
+static hg_thread_mutex_t rcache_lock_g = HG_THREAD_MUTEX_INITIALIZER;
+
+/* Sieving of sparse reads, may be configured before the connector is initialized */
+static H5VL_pdc_sieve_t  sieve_g;
+static hg_thread_mutex_t sieve_lock_g = HG_THREAD_MUTEX_INITIALIZER;
 
 /*---------------------------------------------------------------------------*/
 
@@ -446,460 +948,4170 @@ done:
 }
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_init(hid_t H5VL_ATTR_UNUSED vipl_id)
+herr_t
+H5Pset_pdc_write_cache(hid_t fapl_id, size_t cache_size, unsigned high_pct, unsigned low_pct)
 {
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
-    FUNC_ENTER_VOL(herr_t, SUCCEED)
-
-    /* Check whether initialized */
-    if (H5VL_pdc_init_g)
-        HGOTO_ERROR(H5E_VOL, H5E_CANTINIT, FAIL, "attempting to initialize connector twice");
+    H5VL_pdc_cache_conf_t conf;
 
-    /* Create error stack */
-    if ((H5VL_ERR_STACK_g = H5Ecreate_stack()) < 0)
-        HGOTO_ERROR(H5E_VOL, H5E_CANTCREATE, FAIL, "can't create error stack");
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Register error class for error reporting */
-    if ((H5VL_ERR_CLS_g =
-             H5Eregister_class(H5VL_PDC_PACKAGE_NAME, H5VL_PDC_LIBRARY_NAME, H5VL_PDC_VERSION_STRING)) < 0)
-        HGOTO_ERROR(H5E_VOL, H5E_CANTREGISTER, FAIL, "can't register error class");
+    if (cache_size == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "write cache size must be positive");
+    if (high_pct == 0 || high_pct > 100 || low_pct > high_pct)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid write cache watermarks");
 
-    /* Init PDC */
-    if (pdc_id_g == 0) {
-        pdc_id_g = PDCinit("pdc");
-        if (pdc_id_g <= 0)
-            HGOTO_ERROR(H5E_VOL, H5E_CANTINIT, FAIL, "could not initialize PDC");
-        /* Initialized */
-        H5VL_pdc_init_g = TRUE;
-    }
+    conf.size     = cache_size;
+    conf.high_pct = high_pct;
+    conf.low_pct  = low_pct;
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_WRITE_CACHE_PROP, sizeof(conf), &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set write cache property");
 
 done:
     FUNC_LEAVE_VOL
-} /* end H5VL_pdc_init() */
+} /* end H5Pset_pdc_write_cache() */
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_obj_term(void)
+herr_t
+H5Pget_pdc_write_cache(hid_t fapl_id, size_t *cache_size, unsigned *high_pct, unsigned *low_pct)
 {
-    FUNC_ENTER_VOL(herr_t, SUCCEED)
+    H5VL_pdc_cache_conf_t conf;
 
-    if (!H5VL_pdc_init_g)
-        HGOTO_DONE(SUCCEED);
-
-    if (pdc_id_g > 0 && PDCclose(pdc_id_g) < 0)
-        HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, FAIL, "failed to close PDC");
-    pdc_id_g = 0;
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* "Forget" plugin id.  This should normally be called by the library
-     * when it is closing the id, so no need to close it here. */
-    H5VL_PDC_g = H5I_INVALID_HID;
+    if (H5VL__pdc_cache_conf_get(fapl_id, &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get write cache property");
 
-    H5VL_pdc_init_g = FALSE;
+    if (cache_size)
+        *cache_size = conf.size;
+    if (high_pct)
+        *high_pct = conf.high_pct;
+    if (low_pct)
+        *low_pct = conf.low_pct;
 
 done:
     FUNC_LEAVE_VOL
-} /* end H5VL_pdc_obj_term() */
+} /* end H5Pget_pdc_write_cache() */
 
 /*---------------------------------------------------------------------------*/
-static H5VL_pdc_obj_t *
-H5VL_pdc_new_obj(void *under_obj, hid_t under_vol_id)
+herr_t
+H5Pset_pdc_write_buffer(hid_t dxpl_id, H5VL_pdc_buf_mode_t mode, H5VL_pdc_buf_release_t release_cb,
+                        void *release_ctx)
 {
-    H5VL_pdc_obj_t *new_obj;
-
-    new_obj               = (H5VL_pdc_obj_t *)calloc(1, sizeof(H5VL_pdc_obj_t));
-    new_obj->under_object = under_obj;
-    new_obj->under_vol_id = under_vol_id;
-    /* H5Iinc_ref(new_obj->under_vol_id); */
+    H5VL_pdc_buf_conf_t conf;
 
-    return new_obj;
-} /* end H5VL__pdc_new_obj() */
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-/*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_free_obj(H5VL_pdc_obj_t *obj)
-{
-    hid_t err_id;
+    if (mode != H5VL_PDC_BUF_COPY && mode != H5VL_PDC_BUF_TRANSFER && mode != H5VL_PDC_BUF_STABLE)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid write buffer mode");
 
-    err_id = H5Eget_current_stack();
-    H5Eset_current_stack(err_id);
-    free(obj);
+    conf.mode        = mode;
+    conf.release_cb  = release_cb;
+    conf.release_ctx = release_ctx;
+    if (H5VL__pdc_plist_set(dxpl_id, H5VL_PDC_WRITE_BUF_PROP, sizeof(conf), &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set write buffer property");
 
-    return 0;
-} /* end H5VL__pdc_free_obj() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_write_buffer() */
 
 /*---------------------------------------------------------------------------*/
-static void *
-H5VL_pdc_info_copy(const void *_old_info)
+herr_t
+H5Pget_pdc_write_buffer(hid_t dxpl_id, H5VL_pdc_buf_mode_t *mode, H5VL_pdc_buf_release_t *release_cb,
+                        void **release_ctx)
 {
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
-    const H5VL_pdc_info_t *old_info = (const H5VL_pdc_info_t *)_old_info;
-    H5VL_pdc_info_t *      new_info = NULL;
-
-    FUNC_ENTER_VOL(void *, NULL)
+    H5VL_pdc_buf_conf_t conf;
 
-    if (NULL == (new_info = (H5VL_pdc_info_t *)malloc(sizeof(H5VL_pdc_info_t))))
-        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed");
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    new_info->under_vol_info = old_info->under_vol_info;
-    new_info->under_vol_id   = old_info->under_vol_id;
+    if (H5VL__pdc_buf_conf_get(dxpl_id, &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get write buffer property");
 
-    FUNC_RETURN_SET(new_info);
+    if (mode)
+        *mode = conf.mode;
+    if (release_cb)
+        *release_cb = conf.release_cb;
+    if (release_ctx)
+        *release_ctx = conf.release_ctx;
 
 done:
-    if (FUNC_ERRORED) {
-        /* cleanup */
-        if (new_info && H5VL_pdc_info_free(new_info) < 0)
-            HDONE_ERROR(H5E_PLIST, H5E_CANTFREE, NULL, "can't free fapl");
-    }
-
     FUNC_LEAVE_VOL
-} /* end H5VL_pdc_info_copy() */
+} /* end H5Pget_pdc_write_buffer() */
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_info_cmp(int *cmp_value, const void *_info1, const void *_info2)
+herr_t
+H5Pset_pdc_flush_thread(hid_t fapl_id, hbool_t enable)
 {
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    const H5VL_pdc_info_t *info1 = (const H5VL_pdc_info_t *)_info1;
-    const H5VL_pdc_info_t *info2 = (const H5VL_pdc_info_t *)_info2;
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_FLUSH_THREAD_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set flush thread property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_flush_thread() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_flush_thread(hid_t fapl_id, hbool_t *enable)
+{
+    hbool_t enabled;
 
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    assert(info1);
-    assert(info2);
+    if (H5VL__pdc_flush_conf_get(fapl_id, &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get flush thread property");
 
-    *cmp_value = memcmp(info1, info2, sizeof(H5VL_pdc_info_t));
+    if (enable)
+        *enable = enabled;
 
+done:
     FUNC_LEAVE_VOL
-}
+} /* end H5Pget_pdc_flush_thread() */
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_info_free(void *_info)
+herr_t
+H5Pset_pdc_consistency(hid_t fapl_id, H5VL_pdc_consistency_t mode)
 {
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
-
-    H5VL_pdc_info_t *info = (H5VL_pdc_info_t *)_info;
-
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    assert(info);
+    if (mode != H5VL_PDC_CONSISTENCY_STRICT && mode != H5VL_PDC_CONSISTENCY_OVERLAP)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid consistency mode");
 
-    /* free the struct */
-    free(info);
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_CONSISTENCY_PROP, sizeof(mode), &mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set consistency property");
 
+done:
     FUNC_LEAVE_VOL
-} /* end H5VL_pdc_info_free() */
+} /* end H5Pset_pdc_consistency() */
 
-static herr_t
-H5VL_pdc_info_to_str(const void *_info, char **str)
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_consistency(hid_t fapl_id, H5VL_pdc_consistency_t *mode)
 {
-    const H5VL_pdc_info_t *info              = (const H5VL_pdc_info_t *)_info;
-    H5VL_class_value_t     under_value       = (H5VL_class_value_t)-1;
-    char *                 under_vol_string  = NULL;
-    size_t                 under_vol_str_len = 0;
-
-    /* Get value and string for underlying VOL connector */
-    H5VLget_value(info->under_vol_id, &under_value);
-    H5VLconnector_info_to_str(info->under_vol_info, info->under_vol_id, &under_vol_string);
+    H5VL_pdc_consistency_t conf;
 
-    /* Determine length of underlying VOL info string */
-    if (under_vol_string)
-        under_vol_str_len = strlen(under_vol_string);
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Allocate space for our info */
-    *str = (char *)H5allocate_memory(32 + under_vol_str_len, (hbool_t)0);
-    assert(*str);
+    if (H5VL__pdc_consistency_get(fapl_id, &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get consistency property");
 
-    /* Encode our info
-     * Normally we'd use snprintf() here for a little extra safety, but that
-     * call had problems on Windows until recently. So, to be as platform-independent
-     * as we can, we're using sprintf() instead.
-     */
-    sprintf(*str, "under_vol=%u;under_info={%s}", (unsigned)under_value,
-            (under_vol_string ? under_vol_string : ""));
+    if (mode)
+        *mode = conf;
 
-    return 0;
-} /* end H5VL_pdc_obj_to_str() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_consistency() */
 
-hid_t
-H5VL_pdc_register(void)
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_chunking(hid_t fapl_id, size_t chunk_size, unsigned window)
 {
-    /* Singleton register the pass-through VOL connector ID */
-    if (H5VL_PDC_g < 0)
-        H5VL_PDC_g = H5VLregister_connector(&H5VL_pdc_g, H5P_DEFAULT);
+    H5VL_pdc_chunk_conf_t conf;
 
-    return H5VL_PDC_g;
-} /* end H5VL_pdc_register() */
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-static herr_t
-H5VL_pdc_str_to_info(const char *str, void **_info)
-{
-    H5VL_pdc_info_t *info;
-    unsigned         under_vol_value;
-    const char *     under_vol_info_start, *under_vol_info_end;
-    hid_t            under_vol_id;
-    void *           under_vol_info = NULL;
+    if (chunk_size == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk size must be positive");
+    if (window == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "transfer window must be positive");
 
-    /* Retrieve the underlying VOL connector value and info */
-    sscanf(str, "under_vol=%u;", &under_vol_value);
-    under_vol_id         = H5VLregister_connector_by_value((H5VL_class_value_t)under_vol_value, H5P_DEFAULT);
-    under_vol_info_start = strchr(str, '{');
-    under_vol_info_end   = strrchr(str, '}');
-    assert(under_vol_info_end > under_vol_info_start);
-    if (under_vol_info_end != (under_vol_info_start + 1)) {
-        char *under_vol_info_str;
+    conf.size   = chunk_size;
+    conf.window = window;
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_CHUNK_PROP, sizeof(conf), &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunking property");
 
-        under_vol_info_str = (char *)malloc((size_t)(under_vol_info_end - under_vol_info_start));
-        memcpy(under_vol_info_str, under_vol_info_start + 1,
-               (size_t)((under_vol_info_end - under_vol_info_start) - 1));
-        *(under_vol_info_str + (under_vol_info_end - under_vol_info_start)) = '\0';
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_chunking() */
 
-        H5VLconnector_str_to_info(under_vol_info_str, under_vol_id, &under_vol_info);
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_chunking(hid_t fapl_id, size_t *chunk_size, unsigned *window)
+{
+    H5VL_pdc_chunk_conf_t conf;
 
-        free(under_vol_info_str);
-    } /* end else */
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Allocate new pass-through VOL connector info and set its fields */
-    info                 = (H5VL_pdc_info_t *)calloc(1, sizeof(H5VL_pdc_info_t));
-    info->under_vol_id   = under_vol_id;
-    info->under_vol_info = under_vol_info;
+    if (H5VL__pdc_chunk_conf_get(fapl_id, &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunking property");
 
-    /* Set return value */
-    *_info = info;
+    if (chunk_size)
+        *chunk_size = conf.size;
+    if (window)
+        *window = conf.window;
 
-    return 0;
-} /* end H5VL_pdc_str_to_info() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_chunking() */
 
 /*---------------------------------------------------------------------------*/
-static void *
-H5VL_pdc_get_object(const void *obj)
+herr_t
+H5Pset_pdc_aggregators(hid_t fapl_id, unsigned naggr, hbool_t collective)
 {
-    const H5VL_pdc_obj_t *o = (const H5VL_pdc_obj_t *)obj;
-    return H5VLget_object(o->under_object, o->under_vol_id);
-} /* end H5VL_pdc_get_object() */
+    H5VL_pdc_agg_conf_t conf;
 
-/*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_get_wrap_ctx(const void *obj, void **wrap_ctx)
-{
-    const H5VL_pdc_obj_t *o_pdc        = (const H5VL_pdc_obj_t *)obj;
-    hid_t                 under_vol_id = 0;
-    void *                under_object = NULL;
-    H5VL_pdc_wrap_ctx_t * new_wrap_ctx;
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Allocate new VOL object wrapping context for the pdc connector */
-    new_wrap_ctx = (H5VL_pdc_wrap_ctx_t *)calloc(1, sizeof(H5VL_pdc_wrap_ctx_t));
-    if (new_wrap_ctx == NULL) {
-        fprintf(stderr, "  [PDC VOL ERROR] with allocation in %s\n", __func__);
-        return -1;
-    }
+    conf.naggr      = naggr;
+    conf.collective = collective;
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_AGG_PROP, sizeof(conf), &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set aggregation property");
 
-    if (o_pdc->under_vol_id > 0) {
-        under_vol_id = o_pdc->under_vol_id;
-    }
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_aggregators() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_aggregators(hid_t fapl_id, unsigned *naggr, hbool_t *collective)
+{
+    H5VL_pdc_agg_conf_t conf;
 
-    /* Increment reference count on underlying VOL ID, and copy the VOL info */
-    new_wrap_ctx->under_vol_id = under_vol_id;
-    H5Iinc_ref(new_wrap_ctx->under_vol_id);
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    under_object = o_pdc->under_object;
-    if (under_object) {
-        H5VLget_wrap_ctx(under_object, under_vol_id, &new_wrap_ctx->under_wrap_ctx);
-    }
+    if (H5VL__pdc_agg_conf_get(fapl_id, &conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get aggregation property");
 
-    /* Set wrap context to return */
-    *wrap_ctx = new_wrap_ctx;
+    if (naggr)
+        *naggr = conf.naggr;
+    if (collective)
+        *collective = conf.collective;
 
-    return 0;
-} /* end H5VL_pdc_get_wrap_ctx() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_aggregators() */
 
 /*---------------------------------------------------------------------------*/
-static void *
-H5VL_pdc_wrap_object(void *obj, H5I_type_t obj_type, void *_wrap_ctx)
+herr_t
+H5Pset_pdc_aggregation(hid_t dxpl_id, hbool_t enable)
 {
-    H5VL_pdc_wrap_ctx_t *wrap_ctx = (H5VL_pdc_wrap_ctx_t *)_wrap_ctx;
-    H5VL_pdc_obj_t *     new_obj;
-    void *               under;
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Wrap the object with the underlying VOL */
-    under = H5VLwrap_object(obj, obj_type, wrap_ctx->under_vol_id, wrap_ctx->under_wrap_ctx);
-    if (under) {
-        if ((new_obj = H5VL_pdc_new_obj(under, wrap_ctx->under_vol_id)) == NULL) {
-            fprintf(stderr, "  [PDC VOL ERROR] %s with request object calloc\n", __func__);
-            return NULL;
-        }
-    }
-    else
-        new_obj = NULL;
+    if (H5VL__pdc_plist_set(dxpl_id, H5VL_PDC_AGG_XFER_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set aggregation property");
 
-    return new_obj;
-} /* end H5VL_pdc_wrap_object() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_aggregation() */
 
 /*---------------------------------------------------------------------------*/
-static void *
-H5VL_pdc_unwrap_object(void *obj)
+herr_t
+H5Pget_pdc_aggregation(hid_t dxpl_id, hbool_t *enable)
 {
-    H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)obj;
-    void *          under;
+    hbool_t enabled = FALSE;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    /* Unrap the object with the underlying VOL */
-    under = H5VLunwrap_object(o->under_object, o->under_vol_id);
+    if (H5VL__pdc_plist_get(dxpl_id, H5VL_PDC_AGG_XFER_PROP, sizeof(enabled), &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get aggregation property");
 
-    if (under)
-        H5VL_pdc_free_obj(o);
+    if (enable)
+        *enable = enabled;
 
-    return under;
-} /* end H5VL_pdc_unwrap_object() */
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_aggregation() */
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL_pdc_free_wrap_ctx(void *_wrap_ctx)
+herr_t
+H5Pset_pdc_prefetch(hid_t fapl_id, size_t max_size)
 {
-    H5VL_pdc_wrap_ctx_t *wrap_ctx = (H5VL_pdc_wrap_ctx_t *)_wrap_ctx;
-    hid_t                err_id;
-
-    err_id = H5Eget_current_stack();
-
-    /* Release underlying VOL ID and wrap context */
-    if (wrap_ctx->under_wrap_ctx)
-        H5VLfree_wrap_ctx(wrap_ctx->under_wrap_ctx, wrap_ctx->under_vol_id);
-    H5Idec_ref(wrap_ctx->under_vol_id);
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    H5Eset_current_stack(err_id);
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_PREFETCH_PROP, sizeof(max_size), &max_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set read-ahead property");
 
-    /* Free pdc wrap context object itself */
-    free(wrap_ctx);
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_prefetch() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_prefetch(hid_t fapl_id, size_t *max_size)
+{
+    size_t size;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_prefetch_conf_get(fapl_id, &size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get read-ahead property");
+
+    if (max_size)
+        *max_size = size;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_prefetch() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_meta_cache(hid_t fapl_id, unsigned max_closed)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_META_CACHE_PROP, sizeof(max_closed), &max_closed) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set metadata cache property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_meta_cache() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_meta_cache(hid_t fapl_id, unsigned *max_closed)
+{
+    unsigned nclosed;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_meta_conf_get(fapl_id, &nclosed) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata cache property");
+
+    if (max_closed)
+        *max_closed = nclosed;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_meta_cache() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_coll_metadata(hid_t fapl_id, hbool_t enable)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_COLL_META_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set collective metadata property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_coll_metadata() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_coll_metadata(hid_t fapl_id, hbool_t *enable)
+{
+    hbool_t enabled;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_coll_conf_get(fapl_id, &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get collective metadata property");
+
+    if (enable)
+        *enable = enabled;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_coll_metadata() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_defer_create(hid_t fapl_id, hbool_t enable)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(fapl_id, H5VL_PDC_DEFER_CREATE_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set deferred create property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_defer_create() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_defer_create(hid_t fapl_id, hbool_t *enable)
+{
+    hbool_t enabled;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_defer_conf_get(fapl_id, &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get deferred create property");
+
+    if (enable)
+        *enable = enabled;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_defer_create() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_read_ahead(hid_t dapl_id, hbool_t enable)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(dapl_id, H5VL_PDC_READ_AHEAD_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set read-ahead property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_read_ahead() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_read_ahead(hid_t dapl_id, hbool_t *enable)
+{
+    hbool_t enabled = FALSE;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_get(dapl_id, H5VL_PDC_READ_AHEAD_PROP, sizeof(enabled), &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get read-ahead property");
+
+    if (enable)
+        *enable = enabled;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_read_ahead() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_read_cache(hid_t dapl_id, hbool_t enable)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(dapl_id, H5VL_PDC_READ_CACHE_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set read cache property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_read_cache() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_read_cache(hid_t dapl_id, hbool_t *enable)
+{
+    hbool_t enabled = FALSE;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_get(dapl_id, H5VL_PDC_READ_CACHE_PROP, sizeof(enabled), &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get read cache property");
+
+    if (enable)
+        *enable = enabled;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_read_cache() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pset_pdc_columnar(hid_t dcpl_id, hbool_t enable)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_set(dcpl_id, H5VL_PDC_COLUMNAR_PROP, sizeof(enable), &enable) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set columnar property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pset_pdc_columnar() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5Pget_pdc_columnar(hid_t dcpl_id, hbool_t *enable)
+{
+    hbool_t enabled = FALSE;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_plist_get(dcpl_id, H5VL_PDC_COLUMNAR_PROP, sizeof(enabled), &enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get columnar property");
+
+    if (enable)
+        *enable = enabled;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5Pget_pdc_columnar() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5VLpdc_get_stats(hid_t obj_id, H5VL_pdc_stats_t *stats)
+{
+    H5VL_pdc_obj_t *o, *file;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (stats == NULL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "NULL stats pointer");
+    if (NULL == (o = (H5VL_pdc_obj_t *)H5VLobject(obj_id)) || NULL == (file = o->file_obj_ptr))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a PDC VOL object");
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    *stats = file->stats;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VLpdc_get_stats() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5VLpdc_set_read_cache(size_t max_size)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    H5VL__pdc_rcache_init();
+    hg_thread_mutex_lock(&rcache_lock_g);
+    rcache_g.max_size = max_size;
+
+    /* Apply a lower budget right away */
+    H5VL__pdc_rcache_shrink(max_size);
+    hg_thread_mutex_unlock(&rcache_lock_g);
+
+    FUNC_LEAVE_VOL
+} /* end H5VLpdc_set_read_cache() */
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5VLpdc_set_sieve(size_t max_size, size_t region_cost)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    hg_thread_mutex_lock(&sieve_lock_g);
+    H5VL__pdc_sieve_init();
+    sieve_g.max_size = max_size;
+    sieve_g.cost     = region_cost;
+    hg_thread_mutex_unlock(&sieve_lock_g);
+
+    FUNC_LEAVE_VOL
+} /* end H5VLpdc_set_sieve() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL_pdc_init(hid_t H5VL_ATTR_UNUSED vipl_id)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Check whether initialized */
+    if (H5VL_pdc_init_g)
+        HGOTO_ERROR(H5E_VOL, H5E_CANTINIT, FAIL, "attempting to initialize connector twice");
+
+    /* Create error stack */
+    if ((H5VL_ERR_STACK_g = H5Ecreate_stack()) < 0)
+        HGOTO_ERROR(H5E_VOL, H5E_CANTCREATE, FAIL, "can't create error stack");
+
+    /* Register error class for error reporting */
+    if ((H5VL_ERR_CLS_g =
+             H5Eregister_class(H5VL_PDC_PACKAGE_NAME, H5VL_PDC_LIBRARY_NAME, H5VL_PDC_VERSION_STRING)) < 0)
+        HGOTO_ERROR(H5E_VOL, H5E_CANTREGISTER, FAIL, "can't register error class");
+
+    /* Init PDC */
+    if (pdc_id_g == 0) {
+        hg_thread_mutex_init(&pdc_lock_g);
+        pdc_id_g = PDCinit("pdc");
+        if (pdc_id_g <= 0)
+            HGOTO_ERROR(H5E_VOL, H5E_CANTINIT, FAIL, "could not initialize PDC");
+        /* Initialized */
+        H5VL_pdc_init_g = TRUE;
+    }
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL_pdc_init() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL_pdc_obj_term(void)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (!H5VL_pdc_init_g)
+        HGOTO_DONE(SUCCEED);
+
+    if (pdc_id_g > 0 && PDCclose(pdc_id_g) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, FAIL, "failed to close PDC");
+    pdc_id_g = 0;
+    hg_thread_mutex_destroy(&pdc_lock_g);
+
+    H5VL__pdc_pool_term();
+    H5VL__pdc_copy_term();
+
+    /* "Forget" plugin id.  This should normally be called by the library
+     * when it is closing the id, so no need to close it here. */
+    H5VL_PDC_g = H5I_INVALID_HID;
+
+    H5VL_pdc_init_g = FALSE;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL_pdc_obj_term() */
+
+/*---------------------------------------------------------------------------*/
+static H5VL_pdc_obj_t *
+H5VL_pdc_new_obj(void *under_obj, hid_t under_vol_id)
+{
+    H5VL_pdc_obj_t *new_obj;
+
+    new_obj               = (H5VL_pdc_obj_t *)calloc(1, sizeof(H5VL_pdc_obj_t));
+    new_obj->under_object = under_obj;
+    new_obj->under_vol_id = under_vol_id;
+    /* H5Iinc_ref(new_obj->under_vol_id); */
+
+    return new_obj;
+} /* end H5VL__pdc_new_obj() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_plist_set(hid_t plist_id, const char *name, size_t size, const void *value)
+{
+    htri_t exists;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if ((exists = H5Pexist(plist_id, name)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't check if property exists");
+
+    /* Connector properties are inserted on first use and copied along with the list */
+    if (exists) {
+        if (H5Pset(plist_id, name, value) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set property value");
+    }
+    else if (H5Pinsert2(plist_id, name, size, (void *)value, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_plist_set() */
+
+/*---------------------------------------------------------------------------*/
+static htri_t
+H5VL__pdc_plist_get(hid_t plist_id, const char *name, size_t size, void *value)
+{
+    htri_t exists;
+    size_t prop_size;
+
+    FUNC_ENTER_VOL(htri_t, TRUE)
+
+    if (plist_id <= 0)
+        HGOTO_DONE(FALSE);
+    if ((exists = H5Pexist(plist_id, name)) <= 0)
+        HGOTO_DONE(exists);
+
+    if (H5Pget_size(plist_id, name, &prop_size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get property size");
+    if (prop_size != size)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "unexpected property size");
+    if (H5Pget(plist_id, name, value) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get property value");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_plist_get() */
+
+/*---------------------------------------------------------------------------*/
+size_t
+H5VL__pdc_parse_size(const char *str)
+{
+    char *             end;
+    unsigned long long value = strtoull(str, &end, 10);
+
+    /* Accept an optional binary unit suffix, e.g. "512M" */
+    switch (*end) {
+        case 'k':
+        case 'K':
+            value <<= 10;
+            break;
+        case 'm':
+        case 'M':
+            value <<= 20;
+            break;
+        case 'g':
+        case 'G':
+            value <<= 30;
+            break;
+        default:
+            break;
+    }
+
+    return (size_t)value;
+} /* end H5VL__pdc_parse_size() */
+
+/*---------------------------------------------------------------------------*/
+static void *
+H5VL_pdc_info_copy(const void *_old_info)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+    const H5VL_pdc_info_t *old_info = (const H5VL_pdc_info_t *)_old_info;
+    H5VL_pdc_info_t *      new_info = NULL;
+
+    FUNC_ENTER_VOL(void *, NULL)
+
+    if (NULL == (new_info = (H5VL_pdc_info_t *)malloc(sizeof(H5VL_pdc_info_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed");
+
+    new_info->under_vol_info = old_info->under_vol_info;
+    new_info->under_vol_id   = old_info->under_vol_id;
+
+    FUNC_RETURN_SET(new_info);
+
+done:
+    if (FUNC_ERRORED) {
+        /* cleanup */
+        if (new_info && H5VL_pdc_info_free(new_info) < 0)
+            HDONE_ERROR(H5E_PLIST, H5E_CANTFREE, NULL, "can't free fapl");
+    }
+
+    FUNC_LEAVE_VOL
+} /* end H5VL_pdc_info_copy() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL_pdc_info_cmp(int *cmp_value, const void *_info1, const void *_info2)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+
+    const H5VL_pdc_info_t *info1 = (const H5VL_pdc_info_t *)_info1;
+    const H5VL_pdc_info_t *info2 = (const H5VL_pdc_info_t *)_info2;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    assert(info1);
+    assert(info2);
+
+    *cmp_value = memcmp(info1, info2, sizeof(H5VL_pdc_info_t));
+
+    FUNC_LEAVE_VOL
+}
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL_pdc_info_free(void *_info)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+
+    H5VL_pdc_info_t *info = (H5VL_pdc_info_t *)_info;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    assert(info);
+
+    /* free the struct */
+    free(info);
+
+    FUNC_LEAVE_VOL
+} /* end H5VL_pdc_info_free() */
+
+static herr_t
+H5VL_pdc_info_to_str(const void *_info, char **str)
+{
+    const H5VL_pdc_info_t *info              = (const H5VL_pdc_info_t *)_info;
+    H5VL_class_value_t     under_value       = (H5VL_class_value_t)-1;
+    char *                 under_vol_string  = NULL;
+    size_t                 under_vol_str_len = 0;
+
+    /* Get value and string for underlying VOL connector */
+    H5VLget_value(info->under_vol_id, &under_value);
+    H5VLconnector_info_to_str(info->under_vol_info, info->under_vol_id, &under_vol_string);
+
+    /* Determine length of underlying VOL info string */
+    if (under_vol_string)
+        under_vol_str_len = strlen(under_vol_string);
+
+    /* Allocate space for our info */
+    *str = (char *)H5allocate_memory(32 + under_vol_str_len, (hbool_t)0);
+    assert(*str);
+
+    /* Encode our info
+     * Normally we'd use snprintf() here for a little extra safety, but that
+     * call had problems on Windows until recently. So, to be as platform-independent
+     * as we can, we're using sprintf() instead.
+     */
+    sprintf(*str, "under_vol=%u;under_info={%s}", (unsigned)under_value,
+            (under_vol_string ? under_vol_string : ""));
+
+    return 0;
+} /* end H5VL_pdc_obj_to_str() */
+
+hid_t
+H5VL_pdc_register(void)
+{
+    /* Singleton register the pass-through VOL connector ID */
+    if (H5VL_PDC_g < 0)
+        H5VL_PDC_g = H5VLregister_connector(&H5VL_pdc_g, H5P_DEFAULT);
+
+    return H5VL_PDC_g;
+} /* end H5VL_pdc_register() */
+
+static herr_t
+H5VL_pdc_str_to_info(const char *str, void **_info)
+{
+    H5VL_pdc_info_t *info;
+    unsigned         under_vol_value;
+    const char *     under_vol_info_start, *under_vol_info_end;
+    hid_t            under_vol_id;
+    void *           under_vol_info = NULL;
+
+    /* Retrieve the underlying VOL connector value and info */
+    sscanf(str, "under_vol=%u;", &under_vol_value);
+    under_vol_id         = H5VLregister_connector_by_value((H5VL_class_value_t)under_vol_value, H5P_DEFAULT);
+    under_vol_info_start = strchr(str, '{');
+    under_vol_info_end   = strrchr(str, '}');
+    assert(under_vol_info_end > under_vol_info_start);
+    if (under_vol_info_end != (under_vol_info_start + 1)) {
+        char *under_vol_info_str;
+
+        under_vol_info_str = (char *)malloc((size_t)(under_vol_info_end - under_vol_info_start));
+        memcpy(under_vol_info_str, under_vol_info_start + 1,
+               (size_t)((under_vol_info_end - under_vol_info_start) - 1));
+        *(under_vol_info_str + (under_vol_info_end - under_vol_info_start)) = '\0';
+
+        H5VLconnector_str_to_info(under_vol_info_str, under_vol_id, &under_vol_info);
+
+        free(under_vol_info_str);
+    } /* end else */
+
+    /* Allocate new pass-through VOL connector info and set its fields */
+    info                 = (H5VL_pdc_info_t *)calloc(1, sizeof(H5VL_pdc_info_t));
+    info->under_vol_id   = under_vol_id;
+    info->under_vol_info = under_vol_info;
+
+    /* Set return value */
+    *_info = info;
 
     return 0;
-} /* end H5VL_pdc_free_wrap_ctx() */
+} /* end H5VL_pdc_str_to_info() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_cache_conf_get(hid_t fapl_id, H5VL_pdc_cache_conf_t *conf)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time defaults, overridden by the environment, overridden by the FAPL */
+    conf->size     = (size_t)MAX_WRITE_CACHE_SIZE_GB * 1073741824llu;
+    conf->high_pct = H5VL_PDC_CACHE_HIGH_PCT;
+    conf->low_pct  = H5VL_PDC_CACHE_LOW_PCT;
+
+    if ((env = getenv(H5VL_PDC_CACHE_SIZE_ENV)) != NULL && H5VL__pdc_parse_size(env) > 0)
+        conf->size = H5VL__pdc_parse_size(env);
+    if ((env = getenv(H5VL_PDC_CACHE_HIGH_ENV)) != NULL && atoi(env) > 0 && atoi(env) <= 100)
+        conf->high_pct = (unsigned)atoi(env);
+    if ((env = getenv(H5VL_PDC_CACHE_LOW_ENV)) != NULL && atoi(env) >= 0)
+        conf->low_pct = (unsigned)atoi(env);
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_WRITE_CACHE_PROP, sizeof(*conf), conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get write cache property");
+
+    if (conf->low_pct > conf->high_pct)
+        conf->low_pct = conf->high_pct;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_cache_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Wait for region transfers, called without the PDC lock. The flush threads
+ * poll their transfers and only hold the lock for each check, so that the
+ * application can make its own PDC calls meanwhile; the application blocks in
+ * PDCregion_transfer_wait_all() with the lock held. */
+static perr_t
+H5VL__pdc_xfer_wait(pdcid_t *reqs, int n, hbool_t poll)
+{
+    pdc_transfer_status_t status;
+    perr_t                ret = SUCCEED;
+    int                   i;
+
+    if (n <= 0)
+        return SUCCEED;
+
+    if (!poll) {
+        H5VL_PDC_LOCK();
+        ret = n == 1 ? PDCregion_transfer_wait(reqs[0]) : PDCregion_transfer_wait_all(reqs, n);
+        H5VL_PDC_UNLOCK();
+        return ret;
+    }
+
+    for (i = 0; i < n && ret == SUCCEED;) {
+        H5VL_PDC_LOCK();
+        ret = PDCregion_transfer_status(reqs[i], &status);
+        H5VL_PDC_UNLOCK();
+        if (ret == SUCCEED && status == PDC_TRANSFER_STATUS_PENDING)
+            usleep(H5VL_PDC_FLUSH_POLL_US);
+        else
+            i++;
+    }
+
+    return ret;
+} /* end H5VL__pdc_xfer_wait() */
+
+/*---------------------------------------------------------------------------*/
+/* Order deferred writes by object, then by block shape and position along the
+ * first dimension, keeping submission order for identical keys */
+static int
+H5VL__pdc_xfer_cmp(const void *_a, const void *_b)
+{
+    const H5VL_pdc_xfer_t *a = *(const H5VL_pdc_xfer_t *const *)_a;
+    const H5VL_pdc_xfer_t *b = *(const H5VL_pdc_xfer_t *const *)_b;
+    int                    i;
+
+    if (a->obj_id != b->obj_id)
+        return a->obj_id < b->obj_id ? -1 : 1;
+    if (a->ndim != b->ndim)
+        return a->ndim < b->ndim ? -1 : 1;
+    for (i = 1; i < a->ndim; i++) {
+        if (a->offset[i] != b->offset[i])
+            return a->offset[i] < b->offset[i] ? -1 : 1;
+        if (a->count[i] != b->count[i])
+            return a->count[i] < b->count[i] ? -1 : 1;
+    }
+    if (a->ndim > 0 && a->offset[0] != b->offset[0])
+        return a->offset[0] < b->offset[0] ? -1 : 1;
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+} /* end H5VL__pdc_xfer_cmp() */
+
+/*---------------------------------------------------------------------------*/
+/* Merge deferred writes to the same object whose blocks follow each other
+ * along the first dimension into one request with a single staged buffer.
+ * Only buffers owned by the write cache are merged, so that zero-copy
+ * requests are never copied. The requests of a batch are started together
+ * and complete in no particular order, so sorting them is safe. The merged
+ * batch is returned in a new array and *nreq is updated; the descriptors of
+ * the input batch are left in place, except for the buffers that were merged
+ * which are released. A merged request never exceeds max_size bytes, so that
+ * it is not split up again when it is started. Returns NULL, with nothing
+ * merged, on allocation failure. */
+static H5VL_pdc_xfer_t *
+H5VL__pdc_xfer_coalesce(H5VL_pdc_xfer_t *xfers, int *nreq, size_t max_size)
+{
+    H5VL_pdc_xfer_t **sorted = NULL, *merged = NULL, *run;
+    int               i, j, k, n = *nreq, nout = 0;
+    size_t            size, pos;
+    char *            stage;
+
+    if (NULL == (sorted = (H5VL_pdc_xfer_t **)malloc(n * sizeof(H5VL_pdc_xfer_t *))) ||
+        NULL == (merged = (H5VL_pdc_xfer_t *)malloc(n * sizeof(H5VL_pdc_xfer_t)))) {
+        free(sorted);
+        return NULL;
+    }
+    for (i = 0; i < n; i++)
+        sorted[i] = &xfers[i];
+    qsort(sorted, n, sizeof(H5VL_pdc_xfer_t *), H5VL__pdc_xfer_cmp);
+
+    for (i = 0; i < n; i = j) {
+        run  = sorted[i];
+        size = run->buf.size;
+        for (j = i + 1; j < n; j++) {
+            H5VL_pdc_xfer_t *prev = sorted[j - 1], *next = sorted[j];
+
+            if (!prev->buf.cached || !next->buf.cached || next->obj_id != run->obj_id ||
+                next->ndim != run->ndim || next->ndim == 0 ||
+                next->offset[0] != prev->offset[0] + prev->count[0] || size + next->buf.size > max_size)
+                break;
+            for (k = 1; k < run->ndim; k++)
+                if (next->offset[k] != run->offset[k] || next->count[k] != run->count[k])
+                    break;
+            if (k < run->ndim)
+                break;
+            size += next->buf.size;
+        }
+
+        merged[nout] = *run;
+        if (j - i > 1 && NULL != (stage = (char *)H5VL__pdc_pool_alloc(size))) {
+            for (k = i, pos = 0; k < j; k++) {
+                memcpy(stage + pos, sorted[k]->buf.buf, sorted[k]->buf.size);
+                pos += sorted[k]->buf.size;
+                if (k > i)
+                    merged[nout].count[0] += sorted[k]->count[0];
+                H5VL__pdc_buf_release(&sorted[k]->buf);
+            }
+            merged[nout].buf.buf        = stage;
+            merged[nout].buf.size       = size;
+            merged[nout].buf.mode       = H5VL_PDC_BUF_COPY;
+            merged[nout].buf.release_cb = NULL;
+            nout++;
+        }
+        else {
+            /* Single request, or no memory to stage the run */
+            for (k = i + 1; k < j; k++)
+                merged[++nout] = *sorted[k];
+            nout++;
+        }
+    }
+
+    free(sorted);
+    *nreq = nout;
+
+    return merged;
+} /* end H5VL__pdc_xfer_coalesce() */
+
+/*---------------------------------------------------------------------------*/
+/* Coalesce a batch of deferred writes, create their transfers, start them,
+ * wait for them, close them and release their buffers. Requests larger than a
+ * chunk are streamed as sub-regions once the others have been started.
+ * *nmerged is set to the number of requests merged into another one, *nxfer
+ * to the number of transfers that were issued and *nchunked to the number of
+ * requests that were split. This also runs on the flush threads, which set
+ * poll (see H5VL__pdc_xfer_wait()). */
+static herr_t
+H5VL__pdc_xfer_complete(H5VL_pdc_xfer_t *xfers, int nreq, const H5VL_pdc_chunk_conf_t *chunk, hbool_t poll,
+                        int *nmerged, uint64_t *nxfer, uint64_t *nchunked)
+{
+    H5VL_pdc_xfer_t *merged;
+    pdcid_t *        reqs = NULL, *regions = NULL;
+    uint64_t         zero[H5VL_PDC_MAX_RANK] = {0};
+    uint64_t         nelem, npiece, step;
+    int              i, d, dim, nbatch = 0, n = nreq;
+    perr_t           ret = SUCCEED;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (nreq > 1 && NULL != (merged = H5VL__pdc_xfer_coalesce(xfers, &n, chunk->size)))
+        xfers = merged;
+    else
+        merged = NULL;
+    *nmerged  = nreq - n;
+    *nxfer    = 0;
+    *nchunked = 0;
+
+    if (NULL == (reqs = (pdcid_t *)calloc(n, sizeof(pdcid_t))) ||
+        NULL == (regions = (pdcid_t *)calloc(2 * n, sizeof(pdcid_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate transfer list");
+
+    H5VL_PDC_LOCK();
+    for (i = 0; i < n; i++) {
+        for (d = 0, nelem = 1; d < xfers[i].ndim; d++)
+            nelem *= xfers[i].count[d];
+        if (nelem > 0 &&
+            H5VL__pdc_chunk_plan(&xfers[i], xfers[i].buf.size / nelem, chunk->size, &dim, &step) > 1)
+            continue;
+
+        regions[2 * nbatch]     = PDCregion_create(xfers[i].ndim, zero, xfers[i].count);
+        regions[2 * nbatch + 1] = PDCregion_create(xfers[i].ndim, xfers[i].offset, xfers[i].count);
+        reqs[nbatch] = PDCregion_transfer_create(xfers[i].buf.buf, PDC_WRITE, xfers[i].obj_id,
+                                                 regions[2 * nbatch], regions[2 * nbatch + 1]);
+        nbatch++;
+    }
+    if (nbatch > 0)
+        ret = PDCregion_transfer_start_all(reqs, nbatch);
+    H5VL_PDC_UNLOCK();
+    *nxfer += (uint64_t)nbatch;
+    if (ret != SUCCEED)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "failed to start region transfers");
+
+    /* Stream the large requests while the batch is in progress */
+    for (i = 0; i < n; i++) {
+        for (d = 0, nelem = 1; d < xfers[i].ndim; d++)
+            nelem *= xfers[i].count[d];
+        if (nelem == 0 || (npiece = H5VL__pdc_chunk_plan(&xfers[i], xfers[i].buf.size / nelem, chunk->size,
+                                                         &dim, &step)) <= 1)
+            continue;
+
+        (*nchunked)++;
+        if (H5VL__pdc_xfer_stream(chunk, xfers[i].obj_id, PDC_WRITE, &xfers[i], xfers[i].buf.buf,
+                                  xfers[i].buf.size / nelem, 0, npiece, poll, nxfer) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "failed to stream region transfers");
+    }
+
+    if (ret == SUCCEED && (ret = H5VL__pdc_xfer_wait(reqs, nbatch, poll)) != SUCCEED)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "failed to complete region transfers");
+
+    H5VL_PDC_LOCK();
+    for (i = 0; i < nbatch; i++) {
+        if (PDCregion_transfer_close(reqs[i]) != SUCCEED || PDCregion_close(regions[2 * i]) != SUCCEED ||
+            PDCregion_close(regions[2 * i + 1]) != SUCCEED)
+            ret = FAIL;
+    }
+    H5VL_PDC_UNLOCK();
+    if (ret != SUCCEED && !FUNC_ERRORED)
+        HDONE_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "failed to close region transfers");
+
+done:
+    for (i = 0; i < n; i++)
+        H5VL__pdc_buf_release(&xfers[i].buf);
+    free(merged);
+    free(regions);
+    free(reqs);
+
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_xfer_complete() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_chunk_conf_get(hid_t fapl_id, H5VL_pdc_chunk_conf_t *conf)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time defaults, overridden by the environment, overridden by the FAPL */
+    conf->size   = H5VL_PDC_CHUNK_SIZE;
+    conf->window = H5VL_PDC_CHUNK_WINDOW;
+
+    if ((env = getenv(H5VL_PDC_CHUNK_SIZE_ENV)) != NULL && H5VL__pdc_parse_size(env) > 0)
+        conf->size = H5VL__pdc_parse_size(env);
+    if ((env = getenv(H5VL_PDC_CHUNK_WINDOW_ENV)) != NULL && atoi(env) > 0)
+        conf->window = (unsigned)atoi(env);
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_CHUNK_PROP, sizeof(*conf), conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunking property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_chunk_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Plan the split of a block into sub-blocks of at most chunk_size bytes that
+ * are contiguous in its row-major buffer: the sub-blocks span one index of
+ * every dimension before *dim, at most *step indices along *dim and the
+ * whole block after it. Returns the number of sub-blocks. */
+static uint64_t
+H5VL__pdc_chunk_plan(const H5VL_pdc_xfer_t *box, size_t elem, size_t chunk_size, int *dim, uint64_t *step)
+{
+    uint64_t max_elem, inner = 1, outer = 1;
+    int      d;
+
+    *dim  = 0;
+    *step = 1;
+    if (box->ndim == 0)
+        return 1;
+    for (d = 0; d < box->ndim; d++)
+        if (box->count[d] == 0)
+            return 0;
+
+    max_elem = elem > 0 ? chunk_size / elem : chunk_size;
+    if (max_elem > H5VL_PDC_CHUNK_MAX_ELEM)
+        max_elem = H5VL_PDC_CHUNK_MAX_ELEM;
+    if (max_elem == 0)
+        max_elem = 1;
+
+    /* Cut along the slowest dimension whose rows still fit in a chunk */
+    for (d = box->ndim - 1; d > 0 && inner * box->count[d] <= max_elem; d--)
+        inner *= box->count[d];
+    for (*dim = d; d > 0; d--)
+        outer *= box->count[d - 1];
+
+    *step = max_elem / inner;
+    if (*step > box->count[*dim])
+        *step = box->count[*dim];
+
+    return outer * ((box->count[*dim] + *step - 1) / *step);
+} /* end H5VL__pdc_chunk_plan() */
+
+/*---------------------------------------------------------------------------*/
+/* Get sub-block idx of a block split with H5VL__pdc_chunk_plan(); returns its
+ * byte offset in the buffer of the block */
+static size_t
+H5VL__pdc_chunk_piece(const H5VL_pdc_xfer_t *box, size_t elem, int dim, uint64_t step, uint64_t idx,
+                      H5VL_pdc_xfer_t *piece)
+{
+    uint64_t nstep, outer, pos = 0;
+    int      d;
+
+    *piece = *box;
+    if (box->ndim == 0)
+        return 0;
+
+    nstep              = (box->count[dim] + step - 1) / step;
+    outer              = idx / nstep;
+    piece->offset[dim] = box->offset[dim] + (idx % nstep) * step;
+    piece->count[dim]  = box->offset[dim] + box->count[dim] - piece->offset[dim];
+    if (piece->count[dim] > step)
+        piece->count[dim] = step;
+    for (d = dim - 1; d >= 0; d--) {
+        piece->offset[d] = box->offset[d] + outer % box->count[d];
+        piece->count[d]  = 1;
+        outer /= box->count[d];
+    }
+
+    for (d = 0; d < box->ndim; d++)
+        pos = pos * box->count[d] + (piece->offset[d] - box->offset[d]);
+
+    return (size_t)(pos * elem);
+} /* end H5VL__pdc_chunk_piece() */
+
+/*---------------------------------------------------------------------------*/
+/* Transfer sub-blocks [first, last) of a block between an object and the
+ * buffer holding the block, in place and with at most a window of them in
+ * flight; *nxfer is increased by the number of transfers issued. Like
+ * H5VL__pdc_xfer_complete(), this may run on a flush thread, which sets poll. */
+static herr_t
+H5VL__pdc_xfer_stream(const H5VL_pdc_chunk_conf_t *chunk, pdcid_t obj_id, pdc_access_t access,
+                      const H5VL_pdc_xfer_t *box, void *buf, size_t elem, uint64_t first, uint64_t last,
+                      hbool_t poll, uint64_t *nxfer)
+{
+    H5VL_pdc_xfer_t piece;
+    pdcid_t *       reqs = NULL, *regions = NULL;
+    uint64_t        zero[H5VL_PDC_MAX_RANK] = {0};
+    uint64_t        next, head, step;
+    size_t          off;
+    int             dim, s, window = (int)chunk->window;
+    perr_t          ret = SUCCEED;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (first >= last)
+        HGOTO_DONE(SUCCEED);
+    if (window < 1)
+        window = 1;
+
+    if (NULL == (reqs = (pdcid_t *)calloc(window, sizeof(pdcid_t))) ||
+        NULL == (regions = (pdcid_t *)calloc(2 * window, sizeof(pdcid_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate transfer window");
+
+    H5VL__pdc_chunk_plan(box, elem, chunk->size, &dim, &step);
+    for (next = head = first; next < last || head < next;) {
+        if (next < last && ret == SUCCEED && next - head < (uint64_t)window) {
+            /* Room in the window, start the next sub-block */
+            s   = (int)(next % window);
+            off = H5VL__pdc_chunk_piece(box, elem, dim, step, next, &piece);
+            H5VL_PDC_LOCK();
+            regions[2 * s]     = PDCregion_create(piece.ndim, zero, piece.count);
+            regions[2 * s + 1] = PDCregion_create(piece.ndim, piece.offset, piece.count);
+            reqs[s] = PDCregion_transfer_create((char *)buf + off, access, obj_id, regions[2 * s],
+                                                regions[2 * s + 1]);
+            ret     = PDCregion_transfer_start(reqs[s]);
+            H5VL_PDC_UNLOCK();
+            next++;
+            (*nxfer)++;
+            continue;
+        }
+        if (next < last && ret != SUCCEED)
+            last = next;
+
+        /* Retire the oldest sub-block */
+        s = (int)(head % window);
+        if (ret == SUCCEED)
+            ret = H5VL__pdc_xfer_wait(&reqs[s], 1, poll);
+        H5VL_PDC_LOCK();
+        if (PDCregion_transfer_close(reqs[s]) != SUCCEED || PDCregion_close(regions[2 * s]) != SUCCEED ||
+            PDCregion_close(regions[2 * s + 1]) != SUCCEED)
+            ret = FAIL;
+        H5VL_PDC_UNLOCK();
+        head++;
+    }
+
+    if (ret != SUCCEED)
+        HGOTO_ERROR(H5E_DATASET, access == PDC_READ ? H5E_READERROR : H5E_WRITEERROR, FAIL,
+                    "failed to complete region transfers");
+
+done:
+    free(regions);
+    free(reqs);
+
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_xfer_stream() */
+
+/*---------------------------------------------------------------------------*/
+/* Whether any of the given requests intersects one of the boxes, requests of
+ * a different rank than an intersecting box of the same object are assumed to
+ * overlap it */
+static hbool_t
+H5VL__pdc_xfer_overlap(const H5VL_pdc_xfer_t *xfers, int nreq, const H5VL_pdc_xfer_t *boxes, int nbox)
+{
+    int i, b, d;
+
+    for (i = 0; i < nreq; i++)
+        for (b = 0; b < nbox; b++) {
+            if (xfers[i].obj_id != boxes[b].obj_id)
+                continue;
+            if (xfers[i].ndim != boxes[b].ndim)
+                return TRUE;
+            for (d = 0; d < boxes[b].ndim; d++)
+                if (xfers[i].offset[d] >= boxes[b].offset[d] + boxes[b].count[d] ||
+                    boxes[b].offset[d] >= xfers[i].offset[d] + xfers[i].count[d])
+                    break;
+            if (d == boxes[b].ndim)
+                return TRUE;
+        }
+
+    return FALSE;
+} /* end H5VL__pdc_xfer_overlap() */
+
+/*---------------------------------------------------------------------------*/
+/* Complete only the deferred writes of a file that intersect the given boxes,
+ * leaving the others deferred */
+static herr_t
+H5VL__pdc_file_drain_overlap(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *boxes, int nbox)
+{
+    H5VL_pdc_xfer_t *sel = NULL;
+    int              nsel = 0, nkeep = 0, nmerged, i;
+    uint64_t         nxfer, nchunked;
+    size_t           done_size = 0;
+    hbool_t          failed;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (file->flush.enabled) {
+        /* Requests are started as soon as queued, wait until no overlapping one is left */
+        hg_thread_mutex_lock(&file->flush.mutex);
+        while (!file->flush.failed &&
+               (H5VL__pdc_xfer_overlap(file->xfers, file->req_cnt, boxes, nbox) ||
+                H5VL__pdc_xfer_overlap(file->flush.xfers, file->flush.cnt, boxes, nbox)))
+            hg_thread_cond_wait(&file->flush.done, &file->flush.mutex);
+        failed             = file->flush.failed;
+        file->flush.failed = FALSE;
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+        if (failed)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "background region transfers failed");
+        HGOTO_DONE(SUCCEED);
+    }
+
+    if (file->req_cnt == 0)
+        HGOTO_DONE(SUCCEED);
+
+    if (NULL == (sel = (H5VL_pdc_xfer_t *)malloc(file->req_cnt * sizeof(H5VL_pdc_xfer_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate request list");
+
+    /* Move the overlapping requests out, keeping the others in submission order */
+    for (i = 0; i < file->req_cnt; i++) {
+        if (H5VL__pdc_xfer_overlap(&file->xfers[i], 1, boxes, nbox)) {
+            if (file->xfers[i].buf.cached)
+                done_size += file->xfers[i].buf.size;
+            sel[nsel++] = file->xfers[i];
+        }
+        else
+            file->xfers[nkeep++] = file->xfers[i];
+    }
+    file->req_cnt = nkeep;
+    if (nsel == 0)
+        HGOTO_DONE(SUCCEED);
+
+    if (H5VL__pdc_xfer_complete(sel, nsel, &file->chunk, FALSE, &nmerged, &nxfer, &nchunked) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to complete region transfers");
+
+    file->cache.cur_size -= done_size;
+    file->stats.bytes_out += done_size;
+    file->stats.nxfer += nxfer;
+    file->stats.nmerge += (uint64_t)nmerged;
+    file->stats.nchunked += nchunked;
+
+done:
+    free(sel);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_file_drain_overlap() */
+
+/*---------------------------------------------------------------------------*/
+/* Complete the deferred writes of a file to an object and to its member
+ * objects, before they are closed. A box without dimensions stands for the
+ * whole object. */
+static herr_t
+H5VL__pdc_file_drain_obj(H5VL_pdc_obj_t *file, pdcid_t obj_id, const pdcid_t *member_ids, int nmembers)
+{
+    H5VL_pdc_xfer_t *boxes = NULL;
+    int              m;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (NULL == (boxes = (H5VL_pdc_xfer_t *)calloc(nmembers + 1, sizeof(H5VL_pdc_xfer_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate object list");
+    boxes[0].obj_id = obj_id;
+    for (m = 0; m < nmembers; m++)
+        boxes[m + 1].obj_id = member_ids[m];
+
+    if (H5VL__pdc_file_drain_overlap(file, boxes, nmembers + 1) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete write requests of object");
+
+done:
+    free(boxes);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_file_drain_obj() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_consistency_get(hid_t fapl_id, H5VL_pdc_consistency_t *mode)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Strict by default, overridden by the environment, overridden by the FAPL */
+    *mode = H5VL_PDC_CONSISTENCY_STRICT;
+    if ((env = getenv(H5VL_PDC_CONSISTENCY_ENV)) != NULL && strcmp(env, "overlap") == 0)
+        *mode = H5VL_PDC_CONSISTENCY_OVERLAP;
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_CONSISTENCY_PROP, sizeof(*mode), mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get consistency property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_consistency_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Make room for size more bytes in the write cache of a file: above the high
+ * watermark, the oldest deferred writes are drained down to the low watermark */
+static herr_t
+H5VL__pdc_cache_reserve(H5VL_pdc_obj_t *file, size_t size)
+{
+    size_t target;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (file->cache.cur_size + size <= file->cache.high_mark)
+        HGOTO_DONE(SUCCEED);
+
+    target = size < file->cache.max_size ? file->cache.max_size - size : 0;
+    if (file->cache.low_mark < target)
+        target = file->cache.low_mark;
+    file->stats.nflush++;
+    if (H5VL__pdc_file_drain(file, target) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't flush write cache");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_cache_reserve() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy the block at off/cnt from a buffer holding the block at src_off/src_cnt
+ * to a buffer holding the block at dst_off/dst_cnt, all in row-major order;
+ * the copied block must be inside both */
+static void
+H5VL__pdc_box_copy(void *dst, const uint64_t *dst_off, const uint64_t *dst_cnt, const void *src,
+                   const uint64_t *src_off, const uint64_t *src_cnt, const uint64_t *off, const uint64_t *cnt,
+                   int ndim, size_t elem)
+{
+    uint64_t idx[H5VL_PDC_MAX_RANK] = {0};
+    size_t   row, dst_pos, src_pos;
+    int      d;
+
+    if (ndim == 0) {
+        memcpy(dst, src, elem);
+        return;
+    }
+
+    row = cnt[ndim - 1] * elem;
+    for (;;) {
+        /* Linear positions of the start of the current row in both buffers */
+        dst_pos = src_pos = 0;
+        for (d = 0; d < ndim; d++) {
+            uint64_t coord = off[d] + (d < ndim - 1 ? idx[d] : 0);
+
+            dst_pos = dst_pos * dst_cnt[d] + (coord - dst_off[d]);
+            src_pos = src_pos * src_cnt[d] + (coord - src_off[d]);
+        }
+        memcpy((char *)dst + dst_pos * elem, (const char *)src + src_pos * elem, row);
+
+        /* Next row */
+        for (d = ndim - 2; d >= 0; d--) {
+            if (++idx[d] < cnt[d])
+                break;
+            idx[d] = 0;
+        }
+        if (d < 0)
+            break;
+    }
+} /* end H5VL__pdc_box_copy() */
+
+/*---------------------------------------------------------------------------*/
+/* Split the part of box outside of cut, which must be inside box, into at
+ * most 2 * ndim disjoint pieces; returns the number of pieces */
+static int
+H5VL__pdc_box_subtract(const H5VL_pdc_xfer_t *box, const H5VL_pdc_xfer_t *cut, H5VL_pdc_xfer_t *pieces)
+{
+    H5VL_pdc_xfer_t rest = *box;
+    int             d, n = 0;
+
+    for (d = 0; d < box->ndim; d++) {
+        uint64_t cut_end = cut->offset[d] + cut->count[d], rest_end = rest.offset[d] + rest.count[d];
+
+        if (cut->offset[d] > rest.offset[d]) {
+            pieces[n]           = rest;
+            pieces[n++].count[d] = cut->offset[d] - rest.offset[d];
+        }
+        if (cut_end < rest_end) {
+            pieces[n]            = rest;
+            pieces[n].offset[d]  = cut_end;
+            pieces[n++].count[d] = rest_end - cut_end;
+        }
+
+        /* The remaining pieces only span the cut along this dimension */
+        rest.offset[d] = cut->offset[d];
+        rest.count[d]  = cut->count[d];
+    }
+
+    return n;
+} /* end H5VL__pdc_box_subtract() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy the parts of a read block still held by deferred writes into its
+ * buffer, newest writes first. The parts that must be fetched from the
+ * servers are returned in missing; returns their number. When a deferred
+ * write can't be used, or would split the missing parts into more than
+ * H5VL_PDC_MAX_BOXES boxes, the parts it overlaps and those of older writes
+ * are left missing so that they are read once it completes. Writes the flush
+ * thread has in flight overlapping the block are waited for first, their
+ * buffers are released by that thread without the file mutex and can't be
+ * copied from; the pending list is then pinned, so that the copies are made
+ * without the mutex. */
+static int
+H5VL__pdc_cache_lookup(H5VL_pdc_obj_t *file, H5VL_pdc_xfer_t *box, size_t elem, H5VL_pdc_xfer_t *missing)
+{
+    H5VL_pdc_xfer_t next[H5VL_PDC_MAX_BOXES], pieces[2 * H5VL_PDC_MAX_RANK], cut;
+    uint64_t        nelem;
+    size_t          copied = 0;
+    int             nmissing = 1, nnext, i, b, d, k;
+    hbool_t         usable, full = FALSE;
+
+    missing[0] = *box;
+
+    if (file->flush.enabled) {
+        hg_thread_mutex_lock(&file->flush.mutex);
+        // A failure is left for the drain that follows to report
+        while (!file->flush.failed && H5VL__pdc_xfer_overlap(file->flush.xfers, file->flush.cnt, box, 1))
+            hg_thread_cond_wait(&file->flush.done, &file->flush.mutex);
+        file->flush.npin++;
+        hg_thread_mutex_unlock(&file->flush.mutex);
+    }
+
+    for (i = file->req_cnt - 1; i >= 0 && nmissing > 0 && !full; i--) {
+        const H5VL_pdc_xfer_t *w = &file->xfers[i];
+
+        if (w->obj_id != box->obj_id || !H5VL__pdc_xfer_overlap(w, 1, missing, nmissing))
+            continue;
+
+        for (d = 0, nelem = 1; d < w->ndim; d++)
+            nelem *= w->count[d];
+        usable = w->ndim == box->ndim && nelem > 0 && w->buf.size == nelem * elem && w->buf.buf != NULL;
+        if (!usable)
+            break;
+
+        nnext = 0;
+        for (b = 0; b < nmissing; b++) {
+            if (!H5VL__pdc_xfer_overlap(w, 1, &missing[b], 1)) {
+                next[nnext++] = missing[b];
+                continue;
+            }
+
+            /* The intersection is copied and what is left of the missing block
+             * kept, if it fits along with the blocks still to look at */
+            cut = missing[b];
+            for (d = 0; d < box->ndim; d++) {
+                uint64_t lo = w->offset[d] > cut.offset[d] ? w->offset[d] : cut.offset[d];
+                uint64_t hi = w->offset[d] + w->count[d] < cut.offset[d] + cut.count[d]
+                                  ? w->offset[d] + w->count[d]
+                                  : cut.offset[d] + cut.count[d];
+
+                cut.offset[d] = lo;
+                cut.count[d]  = hi - lo;
+            }
+            k = H5VL__pdc_box_subtract(&missing[b], &cut, pieces);
+            if (nnext + k + (nmissing - b - 1) > H5VL_PDC_MAX_BOXES) {
+                next[nnext++] = missing[b];
+                full          = TRUE;
+                continue;
+            }
+
+            H5VL__pdc_box_copy(box->buf.buf, box->offset, box->count, w->buf.buf, w->offset, w->count,
+                               cut.offset, cut.count, box->ndim, elem);
+            for (d = 0, nelem = 1; d < box->ndim; d++)
+                nelem *= cut.count[d];
+            copied += nelem * elem;
+            for (d = 0; d < k; d++)
+                next[nnext++] = pieces[d];
+        }
+        memcpy(missing, next, nnext * sizeof(H5VL_pdc_xfer_t));
+        nmissing = nnext;
+    }
+
+    if (file->flush.enabled) {
+        hg_thread_mutex_lock(&file->flush.mutex);
+        if (--file->flush.npin == 0 && file->req_cnt > 0)
+            hg_thread_cond_signal(&file->flush.queued);
+    }
+
+    if (nmissing == 0)
+        file->stats.nhit++;
+    else if (copied > 0)
+        file->stats.npartial++;
+    else
+        file->stats.nmiss++;
+    file->stats.hit_bytes += copied;
+
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+    return nmissing;
+} /* end H5VL__pdc_cache_lookup() */
+
+/*---------------------------------------------------------------------------*/
+/* Resolve the read cache budget on first use */
+static void
+H5VL__pdc_rcache_init(void)
+{
+    const char *env;
+
+    hg_thread_mutex_lock(&rcache_lock_g);
+    if (!rcache_g.init) {
+        rcache_g.max_size = H5VL_PDC_READ_CACHE_SIZE;
+        if ((env = getenv(H5VL_PDC_READ_CACHE_SIZE_ENV)) != NULL)
+            rcache_g.max_size = H5VL__pdc_parse_size(env);
+        rcache_g.init = TRUE;
+    }
+    hg_thread_mutex_unlock(&rcache_lock_g);
+} /* end H5VL__pdc_rcache_init() */
+
+/*---------------------------------------------------------------------------*/
+/* Remove a region from the read cache and release its buffer, with the read
+ * cache lock held */
+static void
+H5VL__pdc_rcache_evict(H5VL_pdc_rc_ent_t *ent)
+{
+    if (ent->prev)
+        ent->prev->next = ent->next;
+    else
+        rcache_g.head = ent->next;
+    if (ent->next)
+        ent->next->prev = ent->prev;
+    else
+        rcache_g.tail = ent->prev;
+
+    rcache_g.cur_size -= ent->box.buf.size;
+    H5VL__pdc_pool_free(ent->box.buf.buf, ent->box.buf.size);
+    free(ent);
+} /* end H5VL__pdc_rcache_evict() */
+
+/*---------------------------------------------------------------------------*/
+/* Drop the cached regions of a dataset of a file, or of all of its datasets
+ * when name is NULL */
+static void
+H5VL__pdc_rcache_drop(H5VL_pdc_obj_t *file, const char *name)
+{
+    H5VL_pdc_rc_ent_t *ent, *next;
+
+    hg_thread_mutex_lock(&rcache_lock_g);
+    for (ent = rcache_g.head; ent != NULL; ent = next) {
+        next = ent->next;
+        if (ent->file == file && (name == NULL || strcmp(ent->name, name) == 0))
+            H5VL__pdc_rcache_evict(ent);
+    }
+    hg_thread_mutex_unlock(&rcache_lock_g);
+} /* end H5VL__pdc_rcache_drop() */
+
+/*---------------------------------------------------------------------------*/
+/* Evict the least recently used regions until at most size bytes are held,
+ * with the read cache lock held */
+static void
+H5VL__pdc_rcache_shrink(size_t size)
+{
+    while (rcache_g.tail != NULL && rcache_g.cur_size > size)
+        H5VL__pdc_rcache_evict(rcache_g.tail);
+} /* end H5VL__pdc_rcache_shrink() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy the parts of a read block held by the read cache into its buffer,
+ * most recently used regions first. The parts still to be read are returned
+ * in missing and their number is returned, or -1 when no cached region was
+ * used or the cache is disabled. Regions that serve the read become the most
+ * recently used. */
+static int
+H5VL__pdc_rcache_lookup(H5VL_pdc_obj_t *dset, H5VL_pdc_xfer_t *box, size_t elem, H5VL_pdc_xfer_t *missing)
+{
+    H5VL_pdc_obj_t *   file = dset->file_obj_ptr;
+    H5VL_pdc_xfer_t    next[H5VL_PDC_MAX_BOXES], pieces[2 * H5VL_PDC_MAX_RANK], reg, cut;
+    H5VL_pdc_rc_ent_t *ent, *next_ent, *used = NULL;
+    uint64_t           nelem;
+    size_t             copied   = 0;
+    int                nmissing = 1, nnext, b, d, k;
+
+    missing[0] = *box;
+
+    hg_thread_mutex_lock(&rcache_lock_g);
+    if (rcache_g.max_size == 0) {
+        hg_thread_mutex_unlock(&rcache_lock_g);
+        return -1;
+    }
+
+    for (ent = rcache_g.head; ent != NULL && nmissing > 0; ent = next_ent) {
+        next_ent = ent->next;
+        if (ent->file != file || ent->elem != elem || ent->box.ndim != box->ndim ||
+            strcmp(ent->name, dset->obj_name) != 0)
+            continue;
+
+        /* The region may have been read through another handle of the dataset */
+        reg        = ent->box;
+        reg.obj_id = box->obj_id;
+        if (!H5VL__pdc_xfer_overlap(&reg, 1, missing, nmissing))
+            continue;
+
+        nnext = 0;
+        for (b = 0; b < nmissing && nnext >= 0; b++) {
+            if (!H5VL__pdc_xfer_overlap(&reg, 1, &missing[b], 1)) {
+                next[nnext++] = missing[b];
+                continue;
+            }
+
+            /* Copy the intersection and keep what is left of the missing block */
+            cut = missing[b];
+            for (d = 0; d < box->ndim; d++) {
+                uint64_t lo = reg.offset[d] > cut.offset[d] ? reg.offset[d] : cut.offset[d];
+                uint64_t hi = reg.offset[d] + reg.count[d] < cut.offset[d] + cut.count[d]
+                                  ? reg.offset[d] + reg.count[d]
+                                  : cut.offset[d] + cut.count[d];
+
+                cut.offset[d] = lo;
+                cut.count[d]  = hi - lo;
+            }
+            H5VL__pdc_box_copy(box->buf.buf, box->offset, box->count, reg.buf.buf, reg.offset, reg.count,
+                               cut.offset, cut.count, box->ndim, elem);
+            for (d = 0, nelem = 1; d < box->ndim; d++)
+                nelem *= cut.count[d];
+            copied += nelem * elem;
+
+            k = H5VL__pdc_box_subtract(&missing[b], &cut, pieces);
+            if (nnext + k > H5VL_PDC_MAX_BOXES)
+                nnext = -1;
+            else
+                for (d = 0; d < k; d++)
+                    next[nnext++] = pieces[d];
+        }
+
+        /* Too fragmented, read the whole block from the servers */
+        if (nnext < 0) {
+            missing[0] = *box;
+            nmissing   = 1;
+            copied     = 0;
+            break;
+        }
+        memcpy(missing, next, nnext * sizeof(H5VL_pdc_xfer_t));
+        nmissing = nnext;
+
+        /* Move the region in front of the regions already used by this read */
+        if (ent->prev != used) {
+            ent->prev->next = ent->next;
+            if (ent->next)
+                ent->next->prev = ent->prev;
+            else
+                rcache_g.tail = ent->prev;
+            ent->prev       = used;
+            ent->next       = used ? used->next : rcache_g.head;
+            ent->next->prev = ent;
+            if (used)
+                used->next = ent;
+            else
+                rcache_g.head = ent;
+        }
+        used = ent;
+    }
+    hg_thread_mutex_unlock(&rcache_lock_g);
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    if (nmissing == 0)
+        file->stats.nrc_hit++;
+    else if (copied > 0)
+        file->stats.nrc_partial++;
+    else
+        file->stats.nrc_miss++;
+    file->stats.rc_hit_bytes += copied;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+    return copied > 0 ? nmissing : -1;
+} /* end H5VL__pdc_rcache_lookup() */
+
+/*---------------------------------------------------------------------------*/
+/* Keep a copy of a block just read in the read cache, replacing the regions
+ * of the dataset it contains and evicting the least recently used ones to
+ * stay within the budget. The copy is made before the lock is taken. */
+static void
+H5VL__pdc_rcache_insert(H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box, size_t elem, const void *buf)
+{
+    H5VL_pdc_rc_ent_t *ent, *cur, *next;
+    uint64_t           nelem;
+    size_t             size;
+    int                d;
+
+    H5VL__pdc_rcache_init();
+
+    for (d = 0, nelem = 1; d < box->ndim; d++)
+        nelem *= box->count[d];
+    if ((size = nelem * elem) == 0)
+        return;
+
+    /* The cache is best effort, a region that can't be kept is read again */
+    if (NULL == (ent = (H5VL_pdc_rc_ent_t *)calloc(1, sizeof(H5VL_pdc_rc_ent_t))))
+        return;
+    ent->box          = *box;
+    ent->box.buf.size = size;
+    if (NULL == (ent->box.buf.buf = H5VL__pdc_pool_alloc(size))) {
+        free(ent);
+        return;
+    }
+    memcpy(ent->box.buf.buf, buf, size);
+    ent->file = dset->file_obj_ptr;
+    strcpy(ent->name, dset->obj_name);
+    ent->elem = elem;
+
+    hg_thread_mutex_lock(&rcache_lock_g);
+    if (size > rcache_g.max_size) {
+        hg_thread_mutex_unlock(&rcache_lock_g);
+        H5VL__pdc_pool_free(ent->box.buf.buf, size);
+        free(ent);
+        return;
+    }
+
+    for (cur = rcache_g.head; cur != NULL; cur = next) {
+        next = cur->next;
+        if (cur->file != dset->file_obj_ptr || cur->elem != elem || cur->box.ndim != box->ndim ||
+            strcmp(cur->name, dset->obj_name) != 0)
+            continue;
+        for (d = 0; d < box->ndim; d++)
+            if (cur->box.offset[d] < box->offset[d] ||
+                cur->box.offset[d] + cur->box.count[d] > box->offset[d] + box->count[d])
+                break;
+        if (d == box->ndim)
+            H5VL__pdc_rcache_evict(cur);
+    }
+    H5VL__pdc_rcache_shrink(rcache_g.max_size - size);
+
+    ent->next = rcache_g.head;
+    if (rcache_g.head)
+        rcache_g.head->prev = ent;
+    else
+        rcache_g.tail = ent;
+    rcache_g.head = ent;
+    rcache_g.cur_size += size;
+    hg_thread_mutex_unlock(&rcache_lock_g);
+} /* end H5VL__pdc_rcache_insert() */
+
+/*---------------------------------------------------------------------------*/
+/* Read a block of an object from the servers into a buffer holding just that
+ * block, one chunk at a time when it is larger */
+static herr_t
+H5VL__pdc_read_box(H5VL_pdc_obj_t *file, pdcid_t obj_id, const H5VL_pdc_xfer_t *box, size_t elem, void *buf)
+{
+    uint64_t npiece, step, nxfer = 0;
+    int      dim;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    npiece = H5VL__pdc_chunk_plan(box, elem, file->chunk.size, &dim, &step);
+    if (H5VL__pdc_xfer_stream(&file->chunk, obj_id, PDC_READ, box, buf, elem, 0, npiece, FALSE, &nxfer) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "Failed to complete region transfer");
+
+    if (npiece > 1) {
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nchunked++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
+    }
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_read_box() */
+
+/*---------------------------------------------------------------------------*/
+/* Complete the oldest deferred requests of a file until at most target bytes
+ * remain buffered; a target of 0 completes every pending request. With the
+ * flush engine running, requests are already in progress and this only waits. */
+static herr_t
+H5VL__pdc_file_drain(H5VL_pdc_obj_t *file, size_t target)
+{
+    int      nreq = 0, nmerged, i;
+    uint64_t nxfer, nchunked;
+    size_t   remaining, done_size = 0;
+    hbool_t  failed;
+    herr_t   ret = SUCCEED;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (file->flush.enabled) {
+        hg_thread_mutex_lock(&file->flush.mutex);
+        while (!file->flush.failed &&
+               (file->cache.cur_size > target || (target == 0 && (file->req_cnt > 0 || file->flush.cnt > 0))))
+            hg_thread_cond_wait(&file->flush.done, &file->flush.mutex);
+        failed             = file->flush.failed;
+        file->flush.failed = FALSE;
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+        if (failed)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "background region transfers failed");
+        HGOTO_DONE(SUCCEED);
+    }
+
+    if (file->req_cnt == 0)
+        HGOTO_DONE(SUCCEED);
+
+    if (target == 0)
+        nreq = file->req_cnt;
+    else {
+        remaining = file->cache.cur_size;
+        while (nreq < file->req_cnt && remaining > target) {
+            if (file->xfers[nreq].buf.cached)
+                remaining -= file->xfers[nreq].buf.size;
+            nreq++;
+        }
+    }
+    if (nreq == 0)
+        HGOTO_DONE(SUCCEED);
+
+    for (i = 0; i < nreq; i++)
+        if (file->xfers[i].buf.cached)
+            done_size += file->xfers[i].buf.size;
+
+    if (H5VL__pdc_xfer_complete(file->xfers, nreq, &file->chunk, FALSE, &nmerged, &nxfer, &nchunked) < 0)
+        ret = FAIL;
+
+    file->cache.cur_size -= done_size;
+    file->stats.bytes_out += done_size;
+    file->stats.nxfer += nxfer;
+    file->stats.nmerge += (uint64_t)nmerged;
+    file->stats.nchunked += nchunked;
+
+    /* Keep the still deferred requests in submission order */
+    file->req_cnt -= nreq;
+    if (file->req_cnt > 0)
+        memmove(file->xfers, file->xfers + nreq, file->req_cnt * sizeof(H5VL_pdc_xfer_t));
+
+    if (ret < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to complete region transfers");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_file_drain() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_flush_conf_get(hid_t fapl_id, hbool_t *enabled)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time default, overridden by the environment, overridden by the FAPL */
+    *enabled = H5VL_PDC_FLUSH_THREAD_DEFAULT ? TRUE : FALSE;
+    if ((env = getenv(H5VL_PDC_FLUSH_THREAD_ENV)) != NULL)
+        *enabled = atoi(env) != 0;
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_FLUSH_THREAD_PROP, sizeof(*enabled), enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get flush thread property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_flush_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_flush_start(H5VL_pdc_obj_t *file)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    hg_thread_mutex_init(&file->flush.mutex);
+    hg_thread_cond_init(&file->flush.queued);
+    hg_thread_cond_init(&file->flush.done);
+    file->flush.shutdown = FALSE;
+    file->flush.failed   = FALSE;
+
+    if (hg_thread_create(&file->flush.thread, H5VL__pdc_flush_thread, file) != 0) {
+        hg_thread_cond_destroy(&file->flush.done);
+        hg_thread_cond_destroy(&file->flush.queued);
+        hg_thread_mutex_destroy(&file->flush.mutex);
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, FAIL, "can't create flush thread");
+    }
+    file->flush.enabled = TRUE;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_flush_start() */
+
+/*---------------------------------------------------------------------------*/
+/* Stop the flush engine of a file, the pending requests must have been drained */
+static herr_t
+H5VL__pdc_flush_stop(H5VL_pdc_obj_t *file)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (!file->flush.enabled)
+        HGOTO_DONE(SUCCEED);
+
+    hg_thread_mutex_lock(&file->flush.mutex);
+    file->flush.shutdown = TRUE;
+    hg_thread_cond_signal(&file->flush.queued);
+    hg_thread_mutex_unlock(&file->flush.mutex);
+
+    if (hg_thread_join(file->flush.thread) != 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, FAIL, "can't join flush thread");
+
+    hg_thread_cond_destroy(&file->flush.done);
+    hg_thread_cond_destroy(&file->flush.queued);
+    hg_thread_mutex_destroy(&file->flush.mutex);
+    file->flush.enabled = FALSE;
+
+    free(file->flush.xfers);
+    file->flush.xfers = NULL;
+    file->flush.alloc = 0;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_flush_stop() */
+
+/*---------------------------------------------------------------------------*/
+/* Progress thread of a file: takes the whole pending list as the next batch,
+ * leaving an empty list for new writes, and completes it in the background */
+static HG_THREAD_RETURN_TYPE
+H5VL__pdc_flush_thread(void *arg)
+{
+    H5VL_pdc_obj_t *file      = (H5VL_pdc_obj_t *)arg;
+    hg_thread_ret_t ret_value = 0;
+    H5VL_pdc_xfer_t *xfers;
+    int              alloc, nmerged, i;
+    uint64_t         nxfer, nchunked;
+    size_t           done_size;
+    herr_t           ret;
+
+    hg_thread_mutex_lock(&file->flush.mutex);
+    for (;;) {
+        while (!file->flush.shutdown && (file->req_cnt == 0 || file->flush.npin > 0))
+            hg_thread_cond_wait(&file->flush.queued, &file->flush.mutex);
+        if (file->req_cnt == 0)
+            break;
+
+        /* Swap the pending and the (empty) in-flight lists */
+        xfers             = file->flush.xfers;
+        alloc             = file->flush.alloc;
+        file->flush.xfers = file->xfers;
+        file->flush.alloc = file->req_alloc;
+        file->flush.cnt   = file->req_cnt;
+        file->xfers       = xfers;
+        file->req_alloc   = alloc;
+        file->req_cnt     = 0;
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+        done_size = 0;
+        for (i = 0; i < file->flush.cnt; i++)
+            if (file->flush.xfers[i].buf.cached)
+                done_size += file->flush.xfers[i].buf.size;
+
+        ret = H5VL__pdc_xfer_complete(file->flush.xfers, file->flush.cnt, &file->chunk, TRUE, &nmerged,
+                                      &nxfer, &nchunked);
+
+        hg_thread_mutex_lock(&file->flush.mutex);
+        file->cache.cur_size -= done_size;
+        file->stats.bytes_out += done_size;
+        file->stats.nxfer += nxfer;
+        file->stats.nmerge += (uint64_t)nmerged;
+        file->stats.nchunked += nchunked;
+        if (ret < 0)
+            file->flush.failed = TRUE;
+        file->flush.cnt = 0;
+        hg_thread_cond_broadcast(&file->flush.done);
+    }
+    hg_thread_mutex_unlock(&file->flush.mutex);
+
+    return ret_value;
+} /* end H5VL__pdc_flush_thread() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_buf_conf_get(hid_t dxpl_id, H5VL_pdc_buf_conf_t *conf)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    conf->mode        = H5VL_PDC_BUF_COPY;
+    conf->release_cb  = NULL;
+    conf->release_ctx = NULL;
+
+    if (H5VL__pdc_plist_get(dxpl_id, H5VL_PDC_WRITE_BUF_PROP, sizeof(*conf), conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get write buffer property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_buf_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Give up the connector's use of a transfer buffer once its transfer is done */
+static void
+H5VL__pdc_buf_release(H5VL_pdc_buf_t *buf)
+{
+    if (buf->buf == NULL)
+        return;
+
+    switch (buf->mode) {
+        case H5VL_PDC_BUF_COPY:
+            H5VL__pdc_pool_free(buf->buf, buf->size);
+            break;
+        case H5VL_PDC_BUF_TRANSFER:
+            if (buf->release_cb)
+                buf->release_cb(buf->buf, buf->release_ctx);
+            else
+                free(buf->buf);
+            break;
+        case H5VL_PDC_BUF_STABLE:
+        default:
+            if (buf->release_cb)
+                buf->release_cb(buf->buf, buf->release_ctx);
+            break;
+    }
+    buf->buf = NULL;
+} /* end H5VL__pdc_buf_release() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_agg_conf_get(hid_t fapl_id, H5VL_pdc_agg_conf_t *conf)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time defaults, overridden by the environment, overridden by the FAPL */
+    conf->naggr      = 0;
+    conf->collective = FALSE;
+
+    if ((env = getenv(H5VL_PDC_AGGREGATORS_ENV)) != NULL && atoi(env) > 0)
+        conf->naggr = (unsigned)atoi(env);
+    if ((env = getenv(H5VL_PDC_AGG_ENV)) != NULL)
+        conf->collective = atoi(env) != 0;
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_AGG_PROP, sizeof(*conf), conf) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get aggregation property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Decide whether a write is aggregated: the DXPL property wins, otherwise a
+ * collective MPI-IO transfer is aggregated if the file asks for it */
+static herr_t
+H5VL__pdc_agg_enabled(H5VL_pdc_obj_t *file, hid_t dxpl_id, hbool_t *enabled)
+{
+    H5FD_mpio_xfer_t xfer_mode = H5FD_MPIO_INDEPENDENT;
+    htri_t           found;
+    herr_t           ret = FAIL;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    *enabled = FALSE;
+    if (file->comm == MPI_COMM_NULL || file->num_procs < 2)
+        HGOTO_DONE(SUCCEED);
+
+    if ((found = H5VL__pdc_plist_get(dxpl_id, H5VL_PDC_AGG_XFER_PROP, sizeof(*enabled), enabled)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get aggregation property");
+
+    if (!found && file->agg.collective && dxpl_id > 0) {
+        /* Not an MPI-IO transfer list, or no transfer mode set */
+        H5E_BEGIN_TRY
+        {
+            ret = H5Pget_dxpl_mpio(dxpl_id, &xfer_mode);
+        }
+        H5E_END_TRY;
+        *enabled = ret >= 0 && xfer_mode == H5FD_MPIO_COLLECTIVE;
+    }
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_enabled() */
+
+/*---------------------------------------------------------------------------*/
+/* Aggregator side of H5VL__pdc_agg_write(), first step: sort the blocks
+ * announced in descs and lay out one staging buffer per run of blocks that
+ * follow each other along the first dimension. Nothing is received yet, so
+ * that the group can fall back to writing its own blocks on failure. */
+static herr_t
+H5VL__pdc_agg_plan(const H5VL_pdc_xfer_t *xfer, const H5VL_pdc_agg_desc_t *descs, int gsize,
+                   H5VL_pdc_agg_plan_t *plan)
+{
+    int    i, j, k, d;
+    size_t size;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    memset(plan, 0, sizeof(*plan));
+    if (NULL == (plan->blocks = (H5VL_pdc_xfer_t *)calloc(gsize, sizeof(H5VL_pdc_xfer_t))) ||
+        NULL == (plan->sorted = (H5VL_pdc_xfer_t **)malloc(gsize * sizeof(H5VL_pdc_xfer_t *))) ||
+        NULL == (plan->runs = (H5VL_pdc_xfer_t *)calloc(gsize, sizeof(H5VL_pdc_xfer_t))) ||
+        NULL == (plan->first = (int *)malloc((gsize + 1) * sizeof(int))) ||
+        NULL == (plan->from = (int *)malloc(gsize * sizeof(int))) ||
+        NULL == (plan->reqs = (MPI_Request *)malloc(gsize * sizeof(MPI_Request))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate aggregation lists");
+
+    for (i = 0; i < gsize; i++) {
+        if (descs[i].size == 0)
+            continue;
+        plan->blocks[plan->n].obj_id = xfer->obj_id;
+        plan->blocks[plan->n].ndim   = descs[i].ndim;
+        memcpy(plan->blocks[plan->n].offset, descs[i].offset, sizeof(descs[i].offset));
+        memcpy(plan->blocks[plan->n].count, descs[i].count, sizeof(descs[i].count));
+        plan->blocks[plan->n].buf.size = descs[i].size;
+        plan->from[plan->n]            = i;
+        plan->sorted[plan->n]          = &plan->blocks[plan->n];
+        plan->n++;
+    }
+    qsort(plan->sorted, plan->n, sizeof(H5VL_pdc_xfer_t *), H5VL__pdc_xfer_cmp);
+
+    /* The blocks of a group add up to at most one chunk, so a run is never split again */
+    for (i = 0; i < plan->n; i = j) {
+        size = plan->sorted[i]->buf.size;
+        for (j = i + 1; j < plan->n; j++) {
+            const H5VL_pdc_xfer_t *prev = plan->sorted[j - 1], *next = plan->sorted[j];
+
+            if (next->ndim != prev->ndim || next->ndim == 0 ||
+                next->offset[0] != prev->offset[0] + prev->count[0])
+                break;
+            for (d = 1; d < next->ndim; d++)
+                if (next->offset[d] != prev->offset[d] || next->count[d] != prev->count[d])
+                    break;
+            if (d < next->ndim)
+                break;
+            size += next->buf.size;
+        }
+
+        plan->runs[plan->nrun]          = *plan->sorted[i];
+        plan->runs[plan->nrun].buf.size = size;
+        plan->runs[plan->nrun].buf.mode = H5VL_PDC_BUF_COPY;
+        for (k = i + 1; k < j; k++)
+            plan->runs[plan->nrun].count[0] += plan->sorted[k]->count[0];
+        plan->first[plan->nrun] = i;
+        if (NULL == (plan->runs[plan->nrun].buf.buf = H5VL__pdc_pool_alloc(size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate aggregation buffer");
+        plan->nrun++;
+    }
+    plan->first[plan->nrun] = plan->n;
+
+done:
+    if (FUNC_ERRORED)
+        H5VL__pdc_agg_plan_free(plan);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_plan() */
+
+/*---------------------------------------------------------------------------*/
+/* Release the lists of an aggregation plan, and the staging buffers of its
+ * runs unless they were handed to their transfers. Receives still posted are
+ * cancelled first, since they target the staging buffers. */
+static void
+H5VL__pdc_agg_plan_free(H5VL_pdc_agg_plan_t *plan)
+{
+    int i;
+
+    for (i = 0; i < plan->nrecv; i++)
+        MPI_Cancel(&plan->reqs[i]);
+    if (plan->nrecv > 0)
+        MPI_Waitall(plan->nrecv, plan->reqs, MPI_STATUSES_IGNORE);
+    for (i = 0; plan->runs && i < plan->nrun; i++)
+        H5VL__pdc_pool_free(plan->runs[i].buf.buf, plan->runs[i].buf.size);
+    free(plan->reqs);
+    free(plan->from);
+    free(plan->first);
+    free(plan->runs);
+    free(plan->sorted);
+    free(plan->blocks);
+    memset(plan, 0, sizeof(*plan));
+} /* end H5VL__pdc_agg_plan_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Aggregator side of H5VL__pdc_agg_write(), second step: post the receives of
+ * the blocks of a plan straight into the staging buffers of their runs, and
+ * copy the block of the aggregator itself. This is done before the other
+ * ranks are told to send, so that a failure here leaves them free to write
+ * their own blocks; the receives already posted are then cancelled. */
+static herr_t
+H5VL__pdc_agg_post(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *xfer, H5VL_pdc_agg_plan_t *plan)
+{
+    int    r, k;
+    size_t pos;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    for (r = 0; r < plan->nrun; r++) {
+        for (k = plan->first[r], pos = 0; k < plan->first[r + 1]; k++) {
+            H5VL_pdc_xfer_t *blk  = plan->sorted[k];
+            int              from = plan->from[blk - plan->blocks];
+
+            if (from == 0)
+                H5VL__pdc_copy((char *)plan->runs[r].buf.buf + pos, xfer->buf.buf, blk->buf.size);
+            else if (MPI_Irecv((char *)plan->runs[r].buf.buf + pos, (int)blk->buf.size, MPI_BYTE, from,
+                               H5VL_PDC_AGG_TAG, file->agg_comm, &plan->reqs[plan->nrecv]) != MPI_SUCCESS)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't receive aggregated block");
+            else
+                plan->nrecv++;
+            pos += blk->buf.size;
+        }
+    }
+
+done:
+    if (FUNC_ERRORED) {
+        for (k = 0; k < plan->nrecv; k++)
+            MPI_Cancel(&plan->reqs[k]);
+        if (plan->nrecv > 0)
+            MPI_Waitall(plan->nrecv, plan->reqs, MPI_STATUSES_IGNORE);
+        plan->nrecv = 0;
+    }
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_post() */
+
+/*---------------------------------------------------------------------------*/
+/* Aggregator side of H5VL__pdc_agg_write(), third step: wait for the blocks
+ * posted by H5VL__pdc_agg_post(), then write the runs. The buffers are handed
+ * to the transfers once they are started. */
+static herr_t
+H5VL__pdc_agg_gather(H5VL_pdc_obj_t *file, H5VL_pdc_agg_plan_t *plan)
+{
+    int      r, nrecv, nmerged;
+    uint64_t nxfer, nchunked;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    nrecv       = plan->nrecv;
+    plan->nrecv = 0;
+    if (MPI_Waitall(nrecv, plan->reqs, MPI_STATUSES_IGNORE) != MPI_SUCCESS)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't receive aggregated blocks");
+
+    /* Older deferred writes of this rank to the same blocks must land first */
+    if (H5VL__pdc_file_drain_overlap(file, plan->blocks, plan->n) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete overlapping write requests");
+
+    /* The transfers release the staging buffers from here on */
+    r          = plan->nrun;
+    plan->nrun = 0;
+    if (H5VL__pdc_xfer_complete(plan->runs, r, &file->chunk, FALSE, &nmerged, &nxfer, &nchunked) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write aggregated blocks");
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    file->stats.nxfer += nxfer;
+    file->stats.nagg += (uint64_t)nrecv;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_gather() */
+
+/*---------------------------------------------------------------------------*/
+/* Two-phase write of a block, called by every rank of the file for the same
+ * dataset once it is known from the transfer property list and the file
+ * communicator that the write is aggregated, whatever the rank has to write.
+ * Each group of neighbouring ranks announces its blocks to the first rank of
+ * the group, which receives them, merges the adjacent ones into larger
+ * regions and writes them on behalf of their ranks. *done is set when the
+ * block was written this way; blocks too large to be gathered, and all
+ * blocks when the aggregator can't take them, are left to the caller. A rank
+ * with nothing to announce passes an empty block, and one that already
+ * failed sets failed and may pass a NULL xfer; the status of every rank is
+ * then reduced over the file communicator, so that the write fails on all
+ * ranks or on none. */
+static herr_t
+H5VL__pdc_agg_write(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *xfer, hbool_t failed, hbool_t *done)
+{
+    H5VL_pdc_agg_desc_t desc;
+    H5VL_pdc_agg_plan_t plan;
+    int                 naggr, group, grank, gsize, go = 0, status, all;
+    size_t              max_block;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    *done = FALSE;
+    memset(&plan, 0, sizeof(plan));
+
+    /* The groups are made at the first aggregated write, all ranks agree on whether they could be */
+    if (file->agg_comm == MPI_COMM_NULL) {
+        naggr = file->agg.naggr > 0 ? (int)file->agg.naggr
+                                    : (file->num_procs + H5VL_PDC_AGG_GROUP - 1) / H5VL_PDC_AGG_GROUP;
+        if (naggr > file->num_procs)
+            naggr = file->num_procs;
+        group = (file->num_procs + naggr - 1) / naggr;
+        if (MPI_Comm_split(file->comm, file->my_rank / group, file->my_rank, &file->agg_comm) != MPI_SUCCESS)
+            HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, FAIL, "can't create aggregation communicator");
+        MPI_Comm_rank(file->agg_comm, &grank);
+        MPI_Comm_size(file->agg_comm, &gsize);
+
+        status = 0;
+        if (grank == 0 && NULL == (file->agg_descs = (H5VL_pdc_agg_desc_t *)malloc(gsize * sizeof(desc))))
+            status = -1;
+        if (MPI_Allreduce(&status, &all, 1, MPI_INT, MPI_MIN, file->comm) != MPI_SUCCESS)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't get aggregation status");
+        if (all < 0) {
+            free(file->agg_descs);
+            file->agg_descs = NULL;
+            MPI_Comm_free(&file->agg_comm);
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate aggregation list");
+        }
+    }
+    MPI_Comm_rank(file->agg_comm, &grank);
+    MPI_Comm_size(file->agg_comm, &gsize);
+
+    /* An aggregator gathers at most one chunk per write */
+    max_block = file->chunk.size / gsize;
+    if (max_block > INT_MAX)
+        max_block = INT_MAX;
+
+    memset(&desc, 0, sizeof(desc));
+    if (xfer && !failed) {
+        desc.ndim = xfer->ndim;
+        memcpy(desc.offset, xfer->offset, sizeof(desc.offset));
+        memcpy(desc.count, xfer->count, sizeof(desc.count));
+        desc.size = xfer->buf.size <= max_block ? xfer->buf.size : 0;
+
+        /* Older deferred writes of this rank to the block must land first */
+        if (desc.size > 0 && H5VL__pdc_file_drain_overlap(file, xfer, 1) < 0) {
+            desc.size = 0;
+            failed    = TRUE;
+        }
+    }
+    status = failed ? -1 : 0;
+
+    if (MPI_Gather(&desc, (int)sizeof(desc), MPI_BYTE, file->agg_descs, (int)sizeof(desc), MPI_BYTE, 0,
+                   file->agg_comm) != MPI_SUCCESS)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't gather aggregated blocks");
+
+    /* The blocks are only sent once the aggregator has room for them all and waits for them,
+     * otherwise every rank of the group writes its own */
+    if (grank == 0 && !failed)
+        go = H5VL__pdc_agg_plan(xfer, file->agg_descs, gsize, &plan) >= 0 &&
+             H5VL__pdc_agg_post(file, xfer, &plan) >= 0;
+    if (MPI_Bcast(&go, 1, MPI_INT, 0, file->agg_comm) != MPI_SUCCESS)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't get aggregation plan");
+
+    if (go && grank == 0) {
+        if (H5VL__pdc_agg_gather(file, &plan) < 0)
+            status = -1;
+    }
+    else if (go && desc.size > 0 && MPI_Send(xfer->buf.buf, (int)desc.size, MPI_BYTE, 0, H5VL_PDC_AGG_TAG,
+                                             file->agg_comm) != MPI_SUCCESS)
+        status = -1;
+
+    /* The blocks are written once every aggregator is done, a failed send still joins in */
+    if (MPI_Allreduce(&status, &all, 1, MPI_INT, MPI_MIN, file->comm) != MPI_SUCCESS)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't get aggregated write status");
+    if (all < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "aggregated write failed");
+
+    *done = go && desc.size > 0;
+
+done:
+    H5VL__pdc_agg_plan_free(&plan);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_agg_write() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_prefetch_conf_get(hid_t fapl_id, size_t *size)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time default, overridden by the environment, overridden by the FAPL */
+    *size = H5VL_PDC_PREFETCH_SIZE;
+    if ((env = getenv(H5VL_PDC_PREFETCH_SIZE_ENV)) != NULL)
+        *size = H5VL__pdc_parse_size(env);
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_PREFETCH_PROP, sizeof(*size), size) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get read-ahead property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_prefetch_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Split a group name ending with a step number, such as "Timestep_12", into
+ * the length of its prefix, the step and the width of the number so that zero
+ * padding is kept. Returns FALSE when the name does not end with a number. */
+static hbool_t
+H5VL__pdc_prefetch_step(const char *group, size_t *prefix_len, uint64_t *step, int *width)
+{
+    size_t len = strlen(group), i = len;
+
+    while (i > 0 && group[i - 1] >= '0' && group[i - 1] <= '9')
+        i--;
+    if (i == len || len - i > 18)
+        return FALSE;
+
+    *prefix_len = i;
+    *width      = (int)(len - i);
+    *step       = strtoull(group + i, NULL, 10);
+
+    return TRUE;
+} /* end H5VL__pdc_prefetch_step() */
+
+/*---------------------------------------------------------------------------*/
+/* Finish and free the block read ahead at index idx of a file; reading ahead
+ * is best effort, errors only mean that the block is not used */
+static void
+H5VL__pdc_prefetch_release(H5VL_pdc_obj_t *file, int idx)
+{
+    H5VL_pdc_ra_t *ra = &file->prefetch.blocks[idx];
+
+    if (ra->req != 0)
+        H5VL__pdc_xfer_wait(&ra->req, 1, FALSE);
+    H5VL_PDC_LOCK();
+    if (ra->req != 0)
+        PDCregion_transfer_close(ra->req);
+    PDCregion_close(ra->regions[0]);
+    PDCregion_close(ra->regions[1]);
+    PDCobj_close(ra->obj_id);
+    H5VL_PDC_UNLOCK();
+
+    H5VL__pdc_pool_free(ra->box.buf.buf, ra->box.buf.size);
+    file->prefetch.cur_size -= ra->box.buf.size;
+    memmove(ra, ra + 1, (file->prefetch.cnt - idx - 1) * sizeof(H5VL_pdc_ra_t));
+    file->prefetch.cnt--;
+} /* end H5VL__pdc_prefetch_release() */
+
+/*---------------------------------------------------------------------------*/
+/* Drop the blocks read ahead from the named dataset, or all of them */
+static void
+H5VL__pdc_prefetch_drop(H5VL_pdc_obj_t *file, const char *name)
+{
+    int i;
+
+    for (i = file->prefetch.cnt - 1; i >= 0; i--)
+        if (name == NULL || strcmp(file->prefetch.blocks[i].name, name) == 0)
+            H5VL__pdc_prefetch_release(file, i);
+} /* end H5VL__pdc_prefetch_drop() */
+
+/*---------------------------------------------------------------------------*/
+/* Start reading a block of the named dataset into a read-ahead buffer,
+ * making room by dropping the oldest blocks. Blocks larger than a chunk are
+ * not read ahead, nor is anything while writes are still deferred, since the
+ * block could then miss them. */
+static void
+H5VL__pdc_prefetch_issue(H5VL_pdc_obj_t *file, const char *name, const H5VL_pdc_xfer_t *box, size_t elem)
+{
+    H5VL_pdc_prefetch_t *pf = &file->prefetch;
+    H5VL_pdc_ra_t *      ra, *tmp;
+    uint64_t             zero[H5VL_PDC_MAX_RANK] = {0};
+    size_t               size = elem;
+    hbool_t              pending;
+    perr_t               ret;
+    int                  d;
+
+    for (d = 0; d < box->ndim; d++)
+        size *= box->count[d];
+    if (size == 0 || size > file->chunk.size || size > pf->max_size)
+        return;
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    pending = file->req_cnt > 0 || file->flush.cnt > 0;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+    if (pending)
+        return;
+
+    while (pf->cnt > 0 && pf->cur_size + size > pf->max_size)
+        H5VL__pdc_prefetch_release(file, 0);
+    if (pf->cnt == pf->alloc) {
+        if (NULL == (tmp = (H5VL_pdc_ra_t *)realloc(pf->blocks, (pf->alloc + 8) * sizeof(H5VL_pdc_ra_t))))
+            return;
+        pf->blocks = tmp;
+        pf->alloc += 8;
+    }
+
+    ra = &pf->blocks[pf->cnt];
+    memset(ra, 0, sizeof(*ra));
+    strncpy(ra->name, name, ADDR_MAX - 1);
+    ra->box          = *box;
+    ra->elem         = elem;
+    ra->box.buf.size = size;
+    if (NULL == (ra->box.buf.buf = H5VL__pdc_pool_alloc(size)))
+        return;
+
+    H5VL_PDC_LOCK();
+    if ((ra->obj_id = PDCobj_open(name, pdc_id_g)) <= 0) {
+        /* Past the last step */
+        H5VL_PDC_UNLOCK();
+        H5VL__pdc_pool_free(ra->box.buf.buf, size);
+        return;
+    }
+    ra->regions[0] = PDCregion_create(ra->box.ndim, zero, ra->box.count);
+    ra->regions[1] = PDCregion_create(ra->box.ndim, ra->box.offset, ra->box.count);
+    if (ra->regions[0] > 0 && ra->regions[1] > 0)
+        ra->req = PDCregion_transfer_create(ra->box.buf.buf, PDC_READ, ra->obj_id, ra->regions[0],
+                                            ra->regions[1]);
+    ret = ra->req > 0 ? PDCregion_transfer_start(ra->req) : FAIL;
+
+    /* Reading ahead is skipped when the transfer can't be started */
+    if (ret != SUCCEED) {
+        if (ra->req > 0)
+            PDCregion_transfer_close(ra->req);
+        if (ra->regions[0] > 0)
+            PDCregion_close(ra->regions[0]);
+        if (ra->regions[1] > 0)
+            PDCregion_close(ra->regions[1]);
+        PDCobj_close(ra->obj_id);
+        H5VL_PDC_UNLOCK();
+        H5VL__pdc_pool_free(ra->box.buf.buf, size);
+        return;
+    }
+    H5VL_PDC_UNLOCK();
+
+    pf->cnt++;
+    pf->cur_size += size;
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    file->stats.nprefetch++;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+} /* end H5VL__pdc_prefetch_issue() */
+
+/*---------------------------------------------------------------------------*/
+/* Record a read of a dataset in a group named <prefix><k>. Once the same
+ * selection of the same dataset was read in step k - 1 as well, or if the
+ * dataset was opened with the read-ahead hint, the selection is read ahead
+ * from step k + 1. */
+static void
+H5VL__pdc_prefetch_note(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box, size_t elem)
+{
+    H5VL_pdc_prefetch_t *pf = &file->prefetch;
+    H5VL_pdc_ra_hist_t * h  = NULL;
+    char                 key[ADDR_MAX], group[ADDR_MAX], name[ADDR_MAX];
+    size_t               prefix_len;
+    uint64_t             step;
+    hbool_t              predicted;
+    int                  width, i;
+
+    if (pf->max_size == 0 || dset->read_ahead == 0 || dset->dset_name == NULL || dset->group_name == NULL ||
+        !H5VL__pdc_prefetch_step(dset->group_name, &prefix_len, &step, &width))
+        return;
+
+    snprintf(key, sizeof(key), "%s/%.*s", dset->dset_name, (int)prefix_len, dset->group_name);
+    if (pf->hist == NULL &&
+        NULL == (pf->hist = (H5VL_pdc_ra_hist_t *)calloc(H5VL_PDC_PREFETCH_HIST, sizeof(H5VL_pdc_ra_hist_t))))
+        return;
+    for (i = 0; i < pf->nhist; i++)
+        if (strcmp(pf->hist[i].key, key) == 0) {
+            h = &pf->hist[i];
+            break;
+        }
+
+    predicted = dset->read_ahead == 1 ||
+                (h && h->step + 1 == step && h->elem == elem && h->box.ndim == box->ndim &&
+                 memcmp(h->box.offset, box->offset, sizeof(box->offset)) == 0 &&
+                 memcmp(h->box.count, box->count, sizeof(box->count)) == 0);
+
+    if (h == NULL) {
+        if (pf->nhist < H5VL_PDC_PREFETCH_HIST)
+            h = &pf->hist[pf->nhist++];
+        else {
+            h             = &pf->hist[pf->hist_next];
+            pf->hist_next = (pf->hist_next + 1) % H5VL_PDC_PREFETCH_HIST;
+        }
+        strcpy(h->key, key);
+    }
+    h->step = step;
+    h->box  = *box;
+    h->elem = elem;
+
+    if (!predicted)
+        return;
+
+    /* Same naming as H5VL_pdc_dataset_open() */
+    snprintf(group, sizeof(group), "%.*s%0*llu", (int)prefix_len, dset->group_name, width,
+             (unsigned long long)(step + 1));
+    if ((size_t)snprintf(name, sizeof(name), "%s/%s/%s", dset->dset_name, group, file->file_name) >=
+        sizeof(name))
+        return;
+    replace_multi_slash(name);
+
+    for (i = 0; i < pf->cnt; i++)
+        if (strcmp(pf->blocks[i].name, name) == 0 && pf->blocks[i].box.ndim == box->ndim &&
+            memcmp(pf->blocks[i].box.offset, box->offset, sizeof(box->offset)) == 0 &&
+            memcmp(pf->blocks[i].box.count, box->count, sizeof(box->count)) == 0)
+            return;
+
+    H5VL__pdc_prefetch_issue(file, name, box, elem);
+} /* end H5VL__pdc_prefetch_note() */
+
+/*---------------------------------------------------------------------------*/
+/* Serve a read from a block read ahead with the same selection, waiting for
+ * its transfer if needed. Returns TRUE if buf was filled. */
+static htri_t
+H5VL__pdc_prefetch_take(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, const H5VL_pdc_xfer_t *box, size_t elem,
+                        void *buf)
+{
+    H5VL_pdc_ra_t *ra;
+    perr_t         ret;
+    int            i;
+
+    for (i = 0; i < file->prefetch.cnt; i++) {
+        ra = &file->prefetch.blocks[i];
+        if (strcmp(ra->name, dset->obj_name) != 0 || ra->elem != elem || ra->box.ndim != box->ndim ||
+            memcmp(ra->box.offset, box->offset, sizeof(box->offset)) != 0 ||
+            memcmp(ra->box.count, box->count, sizeof(box->count)) != 0)
+            continue;
+
+        ret = H5VL__pdc_xfer_wait(&ra->req, 1, FALSE);
+        H5VL_PDC_LOCK();
+        PDCregion_transfer_close(ra->req);
+        H5VL_PDC_UNLOCK();
+        ra->req = 0;
+
+        if (ret == SUCCEED)
+            memcpy(buf, ra->box.buf.buf, ra->box.buf.size);
+        H5VL__pdc_prefetch_release(file, i);
+        if (ret != SUCCEED)
+            return FALSE;
+
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nra_hit++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
+        return TRUE;
+    }
+
+    return FALSE;
+} /* end H5VL__pdc_prefetch_take() */
+
+/*---------------------------------------------------------------------------*/
+static H5VL_pdc_obj_t *
+H5VL__pdc_file_init(const char *name, unsigned flags __attribute__((unused)),
+                    H5VL_pdc_info_t *info __attribute__((unused)), hid_t fapl_id)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+
+    H5VL_pdc_obj_t *      file = NULL;
+    hid_t                 under_vol_id, driver;
+    H5VL_pdc_cache_conf_t cache_conf;
+    hbool_t               flush_thread;
+    int                   comm_cmp;
+
+    FUNC_ENTER_VOL(void *, NULL)
+
+    H5Pget_vol_id(fapl_id, &under_vol_id);
+
+    /* allocate the file object that is returned to the user */
+    if (NULL == (file = calloc(1, sizeof(H5VL_pdc_obj_t))))
+        HGOTO_ERROR(H5E_FILE, H5E_CANTALLOC, NULL, "can't allocate PDC file struct");
+    memset(file, 0, sizeof(H5VL_pdc_obj_t));
+    file->info     = MPI_INFO_NULL;
+    file->comm     = MPI_COMM_NULL;
+    file->agg_comm = MPI_COMM_NULL;
+
+    /* Fill in fields of file we know */
+    file->under_object = file;
+    file->under_vol_id = under_vol_id;
+    file->h5i_type     = H5I_FILE;
+    /* file->h5o_type     = H5O_TYPE_FILE; */
+    file->file_obj_ptr = file;
+    file->req_cnt      = 0;
+
+    if (NULL == (file->file_name = strdup(name)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "can't copy file name");
+
+    driver = H5Pget_driver(fapl_id);
+    if (driver == H5FD_MPIO) {
+#ifdef ENABLE_LOGGING
+        fprintf(stderr, "Rank %d: %s MPI-IO driver detected\n", my_rank_g, __func__);
+#endif
+        /* Duplicate communicator and Info object. */
+        H5Pget_fapl_mpio(fapl_id, &file->comm, &file->info);
+
+        /* Obtain the process rank and size from the communicator attached to the
+         * fapl ID */
+        //
+        MPI_Comm_rank(file->comm, &file->my_rank);
+        MPI_Comm_size(file->comm, &file->num_procs);
+    }
+    else {
+#ifdef ENABLE_LOGGING
+        fprintf(stderr, "Rank %d: %s non-MPI-IO driver\n", my_rank_g, __func__);
+#endif
+    }
+
+    my_rank_g  = file->my_rank;
+    file->nobj = 0;
+
+    /* Set up the write cache budget and watermarks */
+    if (H5VL__pdc_cache_conf_get(fapl_id, &cache_conf) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get write cache configuration");
+    file->cache.max_size  = cache_conf.size;
+    file->cache.high_mark = cache_conf.size / 100 * cache_conf.high_pct;
+    file->cache.low_mark  = cache_conf.size / 100 * cache_conf.low_pct;
+
+    /* Start completing deferred writes in the background */
+    if (H5VL__pdc_flush_conf_get(fapl_id, &flush_thread) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get flush thread configuration");
+    if (flush_thread && H5VL__pdc_flush_start(file) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't start flush thread");
+
+    if (H5VL__pdc_consistency_get(fapl_id, &file->consistency) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get consistency mode");
+    if (H5VL__pdc_chunk_conf_get(fapl_id, &file->chunk) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get chunking configuration");
+    if (H5VL__pdc_agg_conf_get(fapl_id, &file->agg) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get aggregation configuration");
+    if (H5VL__pdc_prefetch_conf_get(fapl_id, &file->prefetch.max_size) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get read-ahead configuration");
+    if (H5VL__pdc_meta_conf_get(fapl_id, &file->mcache.max_closed) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get metadata cache configuration");
+
+    /* Lookups are only shared between the ranks of a communicator, and PDC
+     * only opens handles collectively over all of its clients */
+    if (H5VL__pdc_coll_conf_get(fapl_id, &file->coll_meta) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get collective metadata configuration");
+    if (file->comm == MPI_COMM_NULL || file->num_procs < 2)
+        file->coll_meta = FALSE;
+    if (file->coll_meta && MPI_Comm_compare(file->comm, MPI_COMM_WORLD, &comm_cmp) == MPI_SUCCESS)
+        file->coll_world = comm_cmp == MPI_IDENT || comm_cmp == MPI_CONGRUENT;
+    if (H5VL__pdc_defer_conf_get(fapl_id, &file->defer_create) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTGET, NULL, "can't get deferred create configuration");
+
+    H5_LIST_INIT(&file->ids);
+
+    FUNC_RETURN_SET((void *)file);
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_file_init() */
+
+/*---------------------------------------------------------------------------*/
+static herr_t
+H5VL__pdc_file_close(H5VL_pdc_obj_t *file)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
+#endif
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    assert(file);
+
+    // Complete existing write requests
+    if (H5VL__pdc_file_drain(file, 0) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete deferred write requests");
+    if (H5VL__pdc_flush_stop(file) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, FAIL, "can't stop flush thread");
+    H5VL__pdc_prefetch_drop(file, NULL);
+    H5VL__pdc_rcache_drop(file, NULL);
+
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: write cache in %lu bytes, out %lu bytes, %lu flushes\n", my_rank_g,
+            file->stats.bytes_in, file->stats.bytes_out, file->stats.nflush);
+    fprintf(stderr, "Rank %d: %lu write requests, %lu transfers, %lu merged\n", my_rank_g, file->stats.nreq,
+            file->stats.nxfer, file->stats.nmerge);
+    fprintf(stderr, "Rank %d: reads from write cache %lu hits, %lu partial, %lu misses, %lu bytes\n",
+            my_rank_g, file->stats.nhit, file->stats.npartial, file->stats.nmiss, file->stats.hit_bytes);
+    fprintf(stderr, "Rank %d: %lu requests split into chunks\n", my_rank_g, file->stats.nchunked);
+    fprintf(stderr, "Rank %d: %lu blocks written for other ranks\n", my_rank_g, file->stats.nagg);
+    fprintf(stderr, "Rank %d: %lu blocks read ahead, %lu reads served from them\n", my_rank_g,
+            file->stats.nprefetch, file->stats.nra_hit);
+    fprintf(stderr, "Rank %d: reads from read cache %lu hits, %lu partial, %lu misses, %lu bytes\n",
+            my_rank_g, file->stats.nrc_hit, file->stats.nrc_partial, file->stats.nrc_miss,
+            file->stats.rc_hit_bytes);
+    fprintf(stderr, "Rank %d: dataset opens from metadata cache %lu hits, %lu misses\n", my_rank_g,
+            file->stats.nmeta_hit, file->stats.nmeta_miss);
+    fprintf(stderr, "Rank %d: %lu dataset creates deferred, made in %lu batches\n", my_rank_g,
+            file->stats.ncreate, file->stats.nbatch);
+    fprintf(stderr, "Rank %d: attributes %lu served from memory, %lu fetched\n", my_rank_g,
+            file->stats.nattr_hit, file->stats.nattr_fetch);
+#endif
+
+    /* Free file data structures */
+    free(file->xfers);
+    free(file->prefetch.blocks);
+    free(file->prefetch.hist);
+    file->req_alloc = 0;
+    if (file->file_name)
+        free(file->file_name);
+    if (file->agg_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&file->agg_comm);
+    free(file->agg_descs);
+    if (file->comm != MPI_COMM_NULL)
+        MPI_Comm_free(&file->comm);
+    file->comm = MPI_COMM_NULL;
+
+    free(file);
+    file = NULL;
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_file_close() */
+
+/*---------------------------------------------------------------------------*/
+/* Resolve the number of closed datasets a file keeps in its metadata cache */
+static herr_t
+H5VL__pdc_meta_conf_get(hid_t fapl_id, unsigned *max_closed)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Compile-time default, overridden by the environment, overridden by the FAPL */
+    *max_closed = H5VL_PDC_META_CACHE;
+    if ((env = getenv(H5VL_PDC_META_CACHE_ENV)) != NULL && atoi(env) >= 0)
+        *max_closed = (unsigned)atoi(env);
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_META_CACHE_PROP, sizeof(*max_closed), max_closed) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get metadata cache property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_meta_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Bucket of a PDC object name in the metadata cache */
+static unsigned
+H5VL__pdc_meta_hash(const char *name)
+{
+    uint32_t h = 2166136261u;
+
+    while (*name)
+        h = (h ^ (unsigned char)*name++) * 16777619u;
+
+    return h % H5VL_PDC_META_BUCKETS;
+} /* end H5VL__pdc_meta_hash() */
+
+/*---------------------------------------------------------------------------*/
+/* Find the cached metadata of the named dataset and take a reference on it,
+ * NULL when the dataset is not cached */
+static H5VL_pdc_meta_t *
+H5VL__pdc_meta_lookup(H5VL_pdc_obj_t *file, const char *name)
+{
+    H5VL_pdc_meta_cache_t *mc = &file->mcache;
+    H5VL_pdc_meta_t *      ent;
+
+    if (mc->buckets == NULL)
+        return NULL;
+
+    for (ent = mc->buckets[H5VL__pdc_meta_hash(name)]; ent; ent = ent->hnext)
+        if (strcmp(ent->name, name) == 0)
+            break;
+    if (ent == NULL)
+        return NULL;
+
+    // A closed dataset is open again, it can no longer be evicted
+    if (ent->nref++ == 0) {
+        if (ent->prev)
+            ent->prev->next = ent->next;
+        else
+            mc->head = ent->next;
+        if (ent->next)
+            ent->next->prev = ent->prev;
+        else
+            mc->tail = ent->prev;
+        ent->prev = ent->next = NULL;
+        mc->nclosed--;
+    }
+
+    return ent;
+} /* end H5VL__pdc_meta_lookup() */
+
+/*---------------------------------------------------------------------------*/
+/* Cache the metadata of a dataset that was just created or looked up on the
+ * servers. The entry takes over the objects of the dataset and holds its
+ * first reference. */
+static herr_t
+H5VL__pdc_meta_insert(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset)
+{
+    H5VL_pdc_meta_cache_t *mc  = &file->mcache;
+    H5VL_pdc_meta_t *      ent = NULL;
+    unsigned               b;
+    int                    ndim;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (mc->buckets == NULL &&
+        NULL == (mc->buckets = (H5VL_pdc_meta_t **)calloc(H5VL_PDC_META_BUCKETS, sizeof(H5VL_pdc_meta_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate metadata cache");
+    if (NULL == (ent = (H5VL_pdc_meta_t *)calloc(1, sizeof(H5VL_pdc_meta_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate metadata cache entry");
+
+    if ((ndim = H5Sget_simple_extent_dims(dset->space_id, ent->dims, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get dimensions");
+    if (dset->type_id > 0 && (ent->type_id = H5Tcopy(dset->type_id)) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCOPY, FAIL, "can't copy datatype");
+
+    strncpy(ent->name, dset->obj_name, ADDR_MAX - 1);
+    ent->obj_id        = dset->obj_id;
+    ent->pdc_type      = dset->pdc_type;
+    ent->compound_size = dset->compound_size;
+    ent->ndim          = ndim;
+    ent->member_ids    = dset->member_ids;
+    ent->nmembers      = dset->nmembers;
+    ent->nref          = 1;
+    ent->linked        = TRUE;
+
+    b              = H5VL__pdc_meta_hash(ent->name);
+    ent->hnext     = mc->buckets[b];
+    mc->buckets[b] = ent;
+    dset->meta     = ent;
+    ent            = NULL;
+
+done:
+    free(ent);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_meta_insert() */
+
+/*---------------------------------------------------------------------------*/
+/* Write back the attributes of a metadata cache entry, close its objects and
+ * free it */
+static herr_t
+H5VL__pdc_meta_free(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent)
+{
+    perr_t ret = SUCCEED;
+    int    m;
+
+    if (H5VL__pdc_attr_push(file, ent->attrs) < 0)
+        ret = FAIL;
+    H5VL__pdc_attr_free(ent->attrs);
+
+    /* The deferred writes to the objects are made while they are still open */
+    if (H5VL__pdc_file_drain_obj(file, ent->obj_id, ent->member_ids, ent->nmembers) < 0)
+        ret = FAIL;
+
+    H5VL_PDC_LOCK();
+    if (PDCobj_close(ent->obj_id) < 0)
+        ret = FAIL;
+    for (m = 0; m < ent->nmembers; m++)
+        if (ent->member_ids[m] > 0 && PDCobj_close(ent->member_ids[m]) < 0)
+            ret = FAIL;
+    H5VL_PDC_UNLOCK();
+
+    if (ent->type_id > 0)
+        H5Tclose(ent->type_id);
+    free(ent->member_ids);
+    free(ent);
+
+    return ret < 0 ? FAIL : SUCCEED;
+} /* end H5VL__pdc_meta_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Remove an entry from the metadata cache, so that it is no longer found; an
+ * entry still referenced is freed when its last handle is closed */
+static herr_t
+H5VL__pdc_meta_unlink(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent)
+{
+    H5VL_pdc_meta_cache_t *mc = &file->mcache;
+    H5VL_pdc_meta_t **     pp;
+
+    for (pp = &mc->buckets[H5VL__pdc_meta_hash(ent->name)]; *pp; pp = &(*pp)->hnext)
+        if (*pp == ent) {
+            *pp = ent->hnext;
+            break;
+        }
+    ent->linked = FALSE;
+    if (ent->nref > 0)
+        return SUCCEED;
+
+    if (ent->prev)
+        ent->prev->next = ent->next;
+    else
+        mc->head = ent->next;
+    if (ent->next)
+        ent->next->prev = ent->prev;
+    else
+        mc->tail = ent->prev;
+    mc->nclosed--;
+
+    return H5VL__pdc_meta_free(file, ent);
+} /* end H5VL__pdc_meta_unlink() */
+
+/*---------------------------------------------------------------------------*/
+/* Drop the reference of a closed dataset handle on its metadata. The last
+ * handle of a dataset leaves the entry among the recently closed ones, whose
+ * least recently closed entries are evicted beyond the file's limit. */
+static herr_t
+H5VL__pdc_meta_release(H5VL_pdc_obj_t *file, H5VL_pdc_meta_t *ent)
+{
+    H5VL_pdc_meta_cache_t *mc = &file->mcache;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (--ent->nref > 0)
+        HGOTO_DONE(SUCCEED);
+    if (!ent->linked) {
+        if (H5VL__pdc_meta_free(file, ent) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "can't close object");
+        HGOTO_DONE(SUCCEED);
+    }
+
+    ent->prev = NULL;
+    ent->next = mc->head;
+    if (mc->head)
+        mc->head->prev = ent;
+    else
+        mc->tail = ent;
+    mc->head = ent;
+    mc->nclosed++;
+
+    while (mc->nclosed > mc->max_closed)
+        if (H5VL__pdc_meta_unlink(file, mc->tail) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "can't close object");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_meta_release() */
+
+/*---------------------------------------------------------------------------*/
+/* Invalidate the cached metadata of the named dataset, or of all datasets of
+ * the file when name is NULL, after a change made through this process */
+static herr_t
+H5VL__pdc_meta_invalidate(H5VL_pdc_obj_t *file, const char *name)
+{
+    H5VL_pdc_meta_cache_t *mc = &file->mcache;
+    H5VL_pdc_meta_t *      ent, *next;
+    unsigned               b;
+    herr_t                 ret_value = SUCCEED;
+
+    if (mc->buckets == NULL)
+        return SUCCEED;
+
+    for (b = 0; b < H5VL_PDC_META_BUCKETS; b++) {
+        if (name && b != H5VL__pdc_meta_hash(name))
+            continue;
+        for (ent = mc->buckets[b]; ent; ent = next) {
+            next = ent->hnext;
+            if ((name == NULL || strcmp(ent->name, name) == 0) && H5VL__pdc_meta_unlink(file, ent) < 0)
+                ret_value = FAIL;
+        }
+    }
+
+    if (name == NULL) {
+        free(mc->buckets);
+        mc->buckets = NULL;
+    }
+
+    return ret_value;
+} /* end H5VL__pdc_meta_invalidate() */
+
+/*---------------------------------------------------------------------------*/
+/* Resolve whether the metadata lookups of a file are made collectively */
+static herr_t
+H5VL__pdc_coll_conf_get(hid_t fapl_id, hbool_t *enabled)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Off by default, overridden by the environment, overridden by the FAPL */
+    *enabled = FALSE;
+    if ((env = getenv(H5VL_PDC_COLL_META_ENV)) != NULL)
+        *enabled = atoi(env) != 0;
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_COLL_META_PROP, sizeof(*enabled), enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get collective metadata property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_coll_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Open a PDC object of a file. With collective metadata on a communicator
+ * spanning all PDC clients, rank 0 looks the object up and PDC broadcasts it,
+ * so every rank must open the object. */
+static pdcid_t
+H5VL__pdc_obj_open(H5VL_pdc_obj_t *file, const char *name)
+{
+    pdcid_t obj_id;
+
+    H5VL_PDC_LOCK();
+    if (file && file->coll_world)
+        obj_id = PDCobj_open_col(name, pdc_id_g);
+    else
+        obj_id = PDCobj_open(name, pdc_id_g);
+    H5VL_PDC_UNLOCK();
+
+    return obj_id;
+} /* end H5VL__pdc_obj_open() */
+
+/*---------------------------------------------------------------------------*/
+/* Read a tag of a PDC object, or of the container when obj_id is 0, into a
+ * value the caller frees. coll is set when the call is made on behalf of a
+ * collective operation, by every rank of the file; with collective metadata,
+ * rank 0 then reads the tag and broadcasts it. A missing tag fails with a
+ * NULL value of size 0. */
+static perr_t
+H5VL__pdc_tag_get(H5VL_pdc_obj_t *file, hbool_t coll, pdcid_t obj_id, pdcid_t cont_id, const char *tag_name,
+                  void **value, pdc_var_type_t *type, psize_t *size)
+{
+    int64_t hdr[3];
+    perr_t  ret_value = FAIL;
+
+    *value = NULL;
+    *size  = 0;
+    if (file == NULL || !file->coll_meta)
+        coll = FALSE;
+
+    if (!coll || file->my_rank == 0) {
+        H5VL_PDC_LOCK();
+        if (obj_id > 0)
+            ret_value = PDCobj_get_tag(obj_id, (char *)tag_name, value, type, size);
+        else if (cont_id > 0)
+            ret_value = PDCcont_get_tag(cont_id, (char *)tag_name, value, type, size);
+        H5VL_PDC_UNLOCK();
+        if (ret_value < 0) {
+            free(*value);
+            *value = NULL;
+            *size  = 0;
+        }
+    }
+    if (!coll)
+        return ret_value;
+
+    // The outcome, type and size go first so that the other ranks can allocate the value
+    hdr[0] = (int64_t)ret_value;
+    hdr[1] = (int64_t)*type;
+    hdr[2] = (int64_t)*size;
+    if (MPI_Bcast(hdr, 3, MPI_INT64_T, 0, file->comm) != MPI_SUCCESS)
+        return FAIL;
+    ret_value = (perr_t)hdr[0];
+    *type     = (pdc_var_type_t)hdr[1];
+    *size     = (psize_t)hdr[2];
+    if (ret_value < 0 || *size == 0)
+        return ret_value;
+
+    if (file->my_rank != 0 && NULL == (*value = malloc(*size)))
+        return FAIL;
+    if (MPI_Bcast(*value, (int)*size, MPI_BYTE, 0, file->comm) != MPI_SUCCESS) {
+        if (file->my_rank != 0) {
+            free(*value);
+            *value = NULL;
+        }
+        return FAIL;
+    }
+
+    return ret_value;
+} /* end H5VL__pdc_tag_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Resolve whether the dataset creates of a file are deferred */
+static herr_t
+H5VL__pdc_defer_conf_get(hid_t fapl_id, hbool_t *enabled)
+{
+    const char *env;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    /* Off by default, overridden by the environment, overridden by the FAPL */
+    *enabled = FALSE;
+    if ((env = getenv(H5VL_PDC_DEFER_CREATE_ENV)) != NULL)
+        *enabled = atoi(env) != 0;
+
+    if (H5VL__pdc_plist_get(fapl_id, H5VL_PDC_DEFER_CREATE_PROP, sizeof(*enabled), enabled) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get deferred create property");
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_defer_conf_get() */
+
+/*---------------------------------------------------------------------------*/
+/* Record the create of a dataset object until the next batch of creates of
+ * the file. The record takes the object property and the encoded datatype. */
+static herr_t
+H5VL__pdc_create_defer(H5VL_pdc_obj_t *file, H5VL_pdc_obj_t *dset, pdcid_t obj_prop, void *type_buf,
+                       size_t type_size)
+{
+    H5VL_pdc_create_t *create;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (NULL == (create = (H5VL_pdc_create_t *)calloc(1, sizeof(H5VL_pdc_create_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate deferred create");
+
+    strncpy(create->name, dset->obj_name, ADDR_MAX - 1);
+    create->obj_prop      = obj_prop;
+    create->type_buf      = type_buf;
+    create->type_size     = type_size;
+    create->compound_size = dset->compound_size;
+    create->dset          = dset;
+    dset->create          = create;
+
+    if (file->creates_last)
+        file->creates_last->next = create;
+    else
+        file->creates = create;
+    file->creates_last = create;
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    file->stats.ncreate++;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_create_defer() */
+
+/*---------------------------------------------------------------------------*/
+/* Write the tags of the object of a deferred create, once, by the rank that
+ * created it; must be called with the PDC lock */
+static herr_t
+H5VL__pdc_create_tag(H5VL_pdc_create_t *create, pdcid_t obj_id)
+{
+    herr_t ret_value = SUCCEED;
+
+    if (create->compound_size > 0 &&
+        PDCobj_put_tag(obj_id, "PDC_COMPOUND_DTYPE_SIZE", (void *)&create->compound_size, PDC_SIZE_T,
+                       sizeof(psize_t)) < 0)
+        ret_value = FAIL;
+    if (PDCobj_put_tag(obj_id, H5VL_PDC_DTYPE_TAG, create->type_buf, PDC_CHAR, (psize_t)create->type_size) <
+        0)
+        ret_value = FAIL;
+
+    return ret_value;
+} /* end H5VL__pdc_create_tag() */
+
+/*---------------------------------------------------------------------------*/
+/* Hand the object of a deferred create to the handle still waiting for it,
+ * which adds it to the metadata cache, or close it again when the handle was
+ * closed in the meantime. The record keeps its name only. */
+static herr_t
+H5VL__pdc_create_attach(H5VL_pdc_obj_t *file, H5VL_pdc_create_t *create, pdcid_t obj_id)
+{
+    H5VL_pdc_obj_t *dset;
+    herr_t          ret_value = obj_id > 0 ? SUCCEED : FAIL;
+
+    H5VL_PDC_LOCK();
+    if (PDCprop_close(create->obj_prop) < 0)
+        ret_value = FAIL;
+    if (obj_id > 0 && create->dset == NULL && PDCobj_close(obj_id) < 0)
+        ret_value = FAIL;
+    H5VL_PDC_UNLOCK();
+    create->obj_prop = 0;
+
+    if ((dset = create->dset) != NULL) {
+        create->dset = NULL;
+        dset->create = NULL;
+        dset->obj_id = obj_id;
+        if (obj_id > 0 && H5VL__pdc_meta_insert(file, dset) < 0)
+            ret_value = FAIL;
+    }
+    free(create->type_buf);
+    create->type_buf = NULL;
+
+    return ret_value;
+} /* end H5VL__pdc_create_attach() */
+
+/*---------------------------------------------------------------------------*/
+/* Make one deferred create ahead of its batch, for an independent operation
+ * that needs the object: the rank opens the object when another rank made it
+ * already, and creates it on its own otherwise. The record stays in the batch
+ * so that, at the next collective point, the ranks that still defer it open
+ * the object instead of creating it. */
+static herr_t
+H5VL__pdc_create_one(H5VL_pdc_obj_t *file, H5VL_pdc_create_t *create)
+{
+    pdcid_t obj_id;
+    herr_t  ret_value = SUCCEED;
+
+    H5VL_PDC_LOCK();
+    if ((obj_id = PDCobj_open(create->name, pdc_id_g)) <= 0 &&
+        (obj_id = PDCobj_create(file->cont_id, create->name, create->obj_prop)) > 0 &&
+        H5VL__pdc_create_tag(create, obj_id) < 0)
+        ret_value = FAIL;
+    H5VL_PDC_UNLOCK();
+
+    create->made = TRUE;
+    if (H5VL__pdc_create_attach(file, create, obj_id) < 0)
+        ret_value = FAIL;
+
+    return ret_value;
+} /* end H5VL__pdc_create_one() */
 
 /*---------------------------------------------------------------------------*/
-static H5VL_pdc_obj_t *
-H5VL__pdc_file_init(const char *name, unsigned flags __attribute__((unused)),
-                    H5VL_pdc_info_t *info __attribute__((unused)), hid_t fapl_id)
+/* Make the deferred dataset creates of a file, back to back, at a collective
+ * point: a file flush or close. On an MPI communicator the batch is
+ * collective, like H5Dcreate: the ranks first agree on the objects some rank
+ * already made on its own, which the others open, then the remaining creates
+ * are spread over the ranks, and each object is created and tagged by one
+ * rank while PDC broadcasts it to the others. Handles still open get their
+ * object and are added to the metadata cache; the objects of handles closed
+ * in the meantime are closed again. */
+static herr_t
+H5VL__pdc_create_flush(H5VL_pdc_obj_t *file)
 {
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
+    H5VL_pdc_create_t *create, *next, *c;
+    unsigned char      made[H5VL_PDC_CREATE_AGREE];
+    pdcid_t            obj_id;
+    uint64_t           n = 0;
+    int                root = 0, k, i;
+    herr_t             ret_value = SUCCEED;
+
+    create        = file->creates;
+    file->creates = file->creates_last = NULL;
+    if (create) {
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nbatch++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
+    }
 
-    H5VL_pdc_obj_t *file = NULL;
-    hid_t           under_vol_id, driver;
+    while (create) {
+        for (k = 0, c = create; c && k < H5VL_PDC_CREATE_AGREE; c = c->next, k++)
+            made[k] = (unsigned char)c->made;
+        if (file->comm != MPI_COMM_NULL &&
+            MPI_Allreduce(MPI_IN_PLACE, made, k, MPI_UNSIGNED_CHAR, MPI_MAX, file->comm) != MPI_SUCCESS)
+            ret_value = FAIL;
+
+        for (i = 0; i < k; i++, create = next) {
+            next = create->next;
+            if (!create->made) {
+                H5VL_PDC_LOCK();
+                if (made[i])
+                    obj_id = PDCobj_open(create->name, pdc_id_g);
+                else if (file->comm != MPI_COMM_NULL) {
+                    root   = (int)(n++ % (uint64_t)file->num_procs);
+                    obj_id =
+                        PDCobj_create_mpi(file->cont_id, create->name, create->obj_prop, root, file->comm);
+                }
+                else
+                    obj_id = PDCobj_create(file->cont_id, create->name, create->obj_prop);
+
+                // The tags are written once, by the rank that created the object
+                if (obj_id > 0 && !made[i] && file->my_rank == root &&
+                    H5VL__pdc_create_tag(create, obj_id) < 0)
+                    ret_value = FAIL;
+                H5VL_PDC_UNLOCK();
+
+                if (H5VL__pdc_create_attach(file, create, obj_id) < 0)
+                    ret_value = FAIL;
+            }
+            free(create);
+        }
+    }
 
-    FUNC_ENTER_VOL(void *, NULL)
+    return ret_value;
+} /* end H5VL__pdc_create_flush() */
 
-    H5Pget_vol_id(fapl_id, &under_vol_id);
+/*---------------------------------------------------------------------------*/
+/* Find the cached attribute of an attribute handle, in the attributes of its
+ * dataset or of its file, adding an empty entry when create is set. NULL when
+ * it is not cached or can't be added. */
+static H5VL_pdc_attr_ent_t *
+H5VL__pdc_attr_find(H5VL_pdc_obj_t *attr, hbool_t create)
+{
+    H5VL_pdc_attr_ent_t **list = attr->meta ? &attr->meta->attrs : &attr->file_obj_ptr->attrs;
+    H5VL_pdc_attr_ent_t * ent;
+
+    for (ent = *list; ent; ent = ent->next)
+        if (ent->obj_id == attr->obj_id && ent->cont_id == attr->cont_id &&
+            strcmp(ent->name, attr->attr_name) == 0)
+            return ent;
+    if (!create)
+        return NULL;
 
-    /* allocate the file object that is returned to the user */
-    if (NULL == (file = calloc(1, sizeof(H5VL_pdc_obj_t))))
-        HGOTO_ERROR(H5E_FILE, H5E_CANTALLOC, NULL, "can't allocate PDC file struct");
-    memset(file, 0, sizeof(H5VL_pdc_obj_t));
-    file->info = MPI_INFO_NULL;
-    file->comm = MPI_COMM_NULL;
+    if (NULL == (ent = (H5VL_pdc_attr_ent_t *)calloc(1, sizeof(H5VL_pdc_attr_ent_t))))
+        return NULL;
+    if (NULL == (ent->name = strdup(attr->attr_name))) {
+        free(ent);
+        return NULL;
+    }
+    ent->obj_id   = attr->obj_id;
+    ent->cont_id  = attr->cont_id;
+    ent->pdc_type = PDC_CHAR;
+    ent->next     = *list;
+    *list         = ent;
 
-    /* Fill in fields of file we know */
-    file->under_object = file;
-    file->under_vol_id = under_vol_id;
-    file->h5i_type     = H5I_FILE;
-    /* file->h5o_type     = H5O_TYPE_FILE; */
-    file->file_obj_ptr = file;
-    file->req_cnt      = 0;
+    return ent;
+} /* end H5VL__pdc_attr_find() */
 
-    if (NULL == (file->file_name = strdup(name)))
-        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "can't copy file name");
+/*---------------------------------------------------------------------------*/
+/* Fetch the value of a cached attribute from the servers. The tag copy made
+ * by PDC becomes the cached value. An attribute not created through this
+ * handle gets its datatype from the PDC type of the tag: numeric values are
+ * a one-dimensional array, anything else a single string. */
+static herr_t
+H5VL__pdc_attr_fetch(H5VL_pdc_obj_t *file, H5VL_pdc_attr_ent_t *ent)
+{
+    void *         value = NULL;
+    psize_t        size  = 0;
+    pdc_var_type_t type  = PDC_CHAR;
+    hsize_t        dims[1];
 
-    driver = H5Pget_driver(fapl_id);
-    if (driver == H5FD_MPIO) {
-#ifdef ENABLE_LOGGING
-        fprintf(stderr, "Rank %d: %s MPI-IO driver detected\n", my_rank_g, __func__);
-#endif
-        /* Duplicate communicator and Info object. */
-        H5Pget_fapl_mpio(fapl_id, &file->comm, &file->info);
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-        /* Obtain the process rank and size from the communicator attached to the
-         * fapl ID */
-        //
-        MPI_Comm_rank(file->comm, &file->my_rank);
-        MPI_Comm_size(file->comm, &file->num_procs);
-    }
-    else {
-#ifdef ENABLE_LOGGING
-        fprintf(stderr, "Rank %d: %s non-MPI-IO driver\n", my_rank_g, __func__);
-#endif
+    // Attribute operations are independent, every rank reads the tag itself
+    if (H5VL__pdc_tag_get(file, FALSE, ent->obj_id, ent->cont_id, ent->name, &value, &type, &size) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_READERROR, FAIL, "can't get attribute");
+    if (ent->type_id > 0 && size != ent->size)
+        HGOTO_ERROR(H5E_ATTR, H5E_BADSIZE, FAIL, "attribute value does not match its datatype");
+
+    if (ent->type_id <= 0) {
+        if (type == PDC_CHAR || type == PDC_STRING) {
+            if ((ent->type_id = H5Tcopy(H5T_C_S1)) < 0 || H5Tset_size(ent->type_id, size > 0 ? size : 1) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCREATE, FAIL, "can't create attribute datatype");
+            dims[0] = 1;
+        }
+        else {
+            if ((ent->type_id = H5VL__pdc_type_from_pdc(type)) <= 0)
+                HGOTO_ERROR(H5E_ATTR, H5E_UNSUPPORTED, FAIL, "unsupported attribute datatype");
+            dims[0] = size / H5Tget_size(ent->type_id);
+        }
+        if ((ent->space_id = H5Screate_simple(1, dims, NULL)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, FAIL, "can't create attribute dataspace");
     }
 
-    my_rank_g  = file->my_rank;
-    file->nobj = 0;
-
-    H5_LIST_INIT(&file->ids);
+    free(ent->value);
+    ent->value    = value;
+    ent->size     = size;
+    ent->pdc_type = type;
+    value         = NULL;
 
-    FUNC_RETURN_SET((void *)file);
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    file->stats.nattr_fetch++;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
 
 done:
+    free(value);
     FUNC_LEAVE_VOL
-} /* end H5VL__pdc_file_init() */
+} /* end H5VL__pdc_attr_fetch() */
 
 /*---------------------------------------------------------------------------*/
+/* Copy the value of a cached attribute between its stored datatype and a
+ * memory datatype, converting its elements from src_id to dst_id when the
+ * two differ */
 static herr_t
-H5VL__pdc_file_close(H5VL_pdc_obj_t *file)
+H5VL__pdc_attr_convert(const H5VL_pdc_attr_ent_t *ent, hid_t src_id, hid_t dst_id, const void *in, void *out)
 {
-    perr_t ret;
-#ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
-#endif
+    hssize_t nelem;
+    size_t   src_size, dst_size;
+    void *   tmp = NULL;
 
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    assert(file);
+    if (src_id <= 0 || dst_id <= 0 || H5Tequal(src_id, dst_id) > 0) {
+        memcpy(out, in, (size_t)ent->size);
+        HGOTO_DONE(SUCCEED);
+    }
 
-    // Complete existing write requests
-    if (file->req_cnt > 0) {
+    // The elements are converted in place, in a buffer large enough for either datatype
+    if ((nelem = H5Sget_simple_extent_npoints(ent->space_id)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't get number of attribute elements");
+    if (0 == (src_size = H5Tget_size(src_id)) || 0 == (dst_size = H5Tget_size(dst_id)))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't get datatype size");
+    if (nelem == 0)
+        HGOTO_DONE(SUCCEED);
+    if (NULL == (tmp = malloc((size_t)nelem * (src_size > dst_size ? src_size : dst_size))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate conversion buffer");
+    memcpy(tmp, in, (size_t)nelem * src_size);
+    if (H5Tconvert(src_id, dst_id, (size_t)nelem, tmp, NULL, H5P_DEFAULT) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTCONVERT, FAIL, "can't convert attribute value");
+    memcpy(out, tmp, (size_t)nelem * dst_size);
 
-        ret = PDCregion_transfer_start_all(file->xfer_requests, file->req_cnt);
-        if (ret != SUCCEED)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer start");
+done:
+    free(tmp);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_attr_convert() */
 
-        ret = PDCregion_transfer_wait_all(file->xfer_requests, file->req_cnt);
-        if (ret != SUCCEED)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer wait");
+/*---------------------------------------------------------------------------*/
+/* Write the attributes of a list written since they were last pushed back to
+ * the servers, each with the PDC type of its datatype. With collective
+ * metadata only rank 0 writes them, the other ranks holding the same values. */
+static herr_t
+H5VL__pdc_attr_push(H5VL_pdc_obj_t *file, H5VL_pdc_attr_ent_t *list)
+{
+    H5VL_pdc_attr_ent_t *ent;
+    hbool_t              writer    = !file->coll_meta || file->my_rank == 0;
+    herr_t               ret_value = SUCCEED;
+
+    H5VL_PDC_LOCK();
+    for (ent = list; ent; ent = ent->next) {
+        if (!ent->dirty)
+            continue;
+        ent->dirty = FALSE;
+        if (!writer)
+            continue;
+        if (ent->obj_id > 0) {
+            if (PDCobj_put_tag(ent->obj_id, ent->name, ent->value, ent->pdc_type, ent->size) < 0)
+                ret_value = FAIL;
+        }
+        else if (ent->cont_id > 0) {
+            if (PDCcont_put_tag(ent->cont_id, ent->name, ent->value, ent->pdc_type, ent->size) < 0)
+                ret_value = FAIL;
+        }
+    }
+    H5VL_PDC_UNLOCK();
 
-        for (int i = 0; i < file->req_cnt; i++) {
-            ret = PDCregion_transfer_close(file->xfer_requests[i]);
-            if (ret != SUCCEED)
-                HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "Failed to region transfer close");
-            if (file->bufs[i] != NULL) {
-                free(file->bufs[i]);
-                file->bufs[i] = NULL;
+    return ret_value;
+} /* end H5VL__pdc_attr_push() */
+
+/*---------------------------------------------------------------------------*/
+/* Write back the attributes of a file: those of its container and groups, and
+ * those of the datasets in its metadata cache */
+static herr_t
+H5VL__pdc_attr_flush(H5VL_pdc_obj_t *file)
+{
+    H5VL_pdc_meta_t *ent;
+    unsigned         b;
+    herr_t           ret_value = SUCCEED;
+
+    if (H5VL__pdc_attr_push(file, file->attrs) < 0)
+        ret_value = FAIL;
+    if (file->mcache.buckets)
+        for (b = 0; b < H5VL_PDC_META_BUCKETS; b++)
+            for (ent = file->mcache.buckets[b]; ent; ent = ent->hnext)
+                if (H5VL__pdc_attr_push(file, ent->attrs) < 0)
+                    ret_value = FAIL;
+
+    return ret_value;
+} /* end H5VL__pdc_attr_flush() */
+
+/*---------------------------------------------------------------------------*/
+static void
+H5VL__pdc_attr_free(H5VL_pdc_attr_ent_t *list)
+{
+    H5VL_pdc_attr_ent_t *next;
+
+    for (; list; list = next) {
+        next = list->next;
+        if (list->type_id > 0)
+            H5Tclose(list->type_id);
+        if (list->space_id > 0)
+            H5Sclose(list->space_id);
+        free(list->value);
+        free(list->name);
+        free(list);
+    }
+} /* end H5VL__pdc_attr_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Absolute HDF5 path of a name relative to a file or group handle, an empty
+ * name or "." being the location itself */
+static herr_t
+H5VL__pdc_link_path(H5VL_pdc_obj_t *o, const char *name, char *path, size_t size)
+{
+    const char *base;
+    size_t      len;
+    int         n;
+
+    if (o->h5i_type == H5I_FILE)
+        base = "/";
+    else if (o->h5i_type == H5I_GROUP && o->link_path)
+        base = o->link_path;
+    else
+        return FAIL;
+
+    if (name == NULL || strcmp(name, ".") == 0)
+        name = "";
+    while (name[0] == '.' && name[1] == '/')
+        name += 2;
+    if (name[0] == '/')
+        n = snprintf(path, size, "%s", name);
+    else
+        n = snprintf(path, size, "%s/%s", base, name);
+    if (n < 0 || (size_t)n >= size)
+        return FAIL;
+
+    // Without repeated or trailing slashes, each object has a single path
+    replace_multi_slash(path);
+    len = strlen(path);
+    if (len > 1 && path[len - 1] == '/')
+        path[len - 1] = '\0';
+
+    return SUCCEED;
+} /* end H5VL__pdc_link_path() */
+
+/*---------------------------------------------------------------------------*/
+/* Bucket of a path in the namespace index */
+static unsigned
+H5VL__pdc_link_hash(const char *path)
+{
+    uint32_t h = 2166136261u;
+
+    while (*path)
+        h = (h ^ (unsigned char)*path++) * 16777619u;
+
+    return h % H5VL_PDC_LINK_BUCKETS;
+} /* end H5VL__pdc_link_hash() */
+
+/*---------------------------------------------------------------------------*/
+static H5VL_pdc_link_t *
+H5VL__pdc_link_find(H5VL_pdc_obj_t *file, const char *path)
+{
+    H5VL_pdc_link_t *link;
+
+    if (file->links.buckets == NULL)
+        return NULL;
+
+    for (link = file->links.buckets[H5VL__pdc_link_hash(path)]; link; link = link->hnext)
+        if (strcmp(link->path, path) == 0)
+            return link;
+
+    return NULL;
+} /* end H5VL__pdc_link_find() */
+
+/*---------------------------------------------------------------------------*/
+/* Add the link of an absolute path to the namespace index, and the groups
+ * leading to it. A link already there takes the new type unless it is a group
+ * holding links. NULL when a component of the path is a dataset or the link
+ * can't be added. */
+static H5VL_pdc_link_t *
+H5VL__pdc_link_add(H5VL_pdc_obj_t *file, const char *path, H5O_type_t type)
+{
+    H5VL_pdc_links_t *links = &file->links;
+    H5VL_pdc_link_t * link, *parent;
+    char              parent_path[ADDR_MAX];
+    const char *      slash;
+    unsigned          b;
+
+    if (links->buckets == NULL || path[0] != '/')
+        return NULL;
+
+    if (NULL != (link = H5VL__pdc_link_find(file, path))) {
+        if (link->type != type) {
+            if (link->nlinks > 0)
+                return NULL;
+            link->type   = type;
+            links->dirty = TRUE;
+        }
+        return link;
+    }
+
+    // The parent is found or added first, the root always being there
+    slash = strrchr(path, '/');
+    if ((size_t)(slash - path) >= sizeof(parent_path))
+        return NULL;
+    if (slash == path)
+        strcpy(parent_path, "/");
+    else {
+        memcpy(parent_path, path, (size_t)(slash - path));
+        parent_path[slash - path] = '\0';
+    }
+    if (NULL == (parent = H5VL__pdc_link_find(file, parent_path)) &&
+        NULL == (parent = H5VL__pdc_link_add(file, parent_path, H5O_TYPE_GROUP)))
+        return NULL;
+    if (parent->type != H5O_TYPE_GROUP)
+        return NULL;
+
+    if (NULL == (link = (H5VL_pdc_link_t *)calloc(1, sizeof(H5VL_pdc_link_t))))
+        return NULL;
+    if (NULL == (link->path = strdup(path))) {
+        free(link);
+        return NULL;
+    }
+    link->name   = strrchr(link->path, '/') + 1;
+    link->type   = type;
+    link->corder = parent->max_corder++;
+    link->parent = parent;
+    if (parent->last)
+        parent->last->sibling = link;
+    else
+        parent->first = link;
+    parent->last = link;
+    parent->nlinks++;
+
+    b                 = H5VL__pdc_link_hash(link->path);
+    link->hnext       = links->buckets[b];
+    links->buckets[b] = link;
+    links->dirty      = TRUE;
+
+    return link;
+} /* end H5VL__pdc_link_add() */
+
+/*---------------------------------------------------------------------------*/
+/* Remove a link from the namespace index, and the links below it */
+static void
+H5VL__pdc_link_remove(H5VL_pdc_obj_t *file, H5VL_pdc_link_t *link)
+{
+    H5VL_pdc_link_t * parent = link->parent;
+    H5VL_pdc_link_t **pp, *prev = NULL;
+
+    while (link->first)
+        H5VL__pdc_link_remove(file, link->first);
+
+    if (parent) {
+        for (pp = &parent->first; *pp != link; pp = &(*pp)->sibling)
+            prev = *pp;
+        *pp = link->sibling;
+        if (parent->last == link)
+            parent->last = prev;
+        parent->nlinks--;
+    }
+    for (pp = &file->links.buckets[H5VL__pdc_link_hash(link->path)]; *pp != link; pp = &(*pp)->hnext)
+        ;
+    *pp = link->hnext;
+    file->links.dirty = TRUE;
+
+    free(link->path);
+    free(link);
+} /* end H5VL__pdc_link_remove() */
+
+/*---------------------------------------------------------------------------*/
+static int
+H5VL__pdc_link_name_cmp(const void *_a, const void *_b)
+{
+    const H5VL_pdc_link_t *a = *(const H5VL_pdc_link_t *const *)_a;
+    const H5VL_pdc_link_t *b = *(const H5VL_pdc_link_t *const *)_b;
+
+    return strcmp(a->name, b->name);
+} /* end H5VL__pdc_link_name_cmp() */
+
+/*---------------------------------------------------------------------------*/
+/* The links of a group in the order of an index, in an array the caller frees,
+ * NULL for an empty group. Links are kept in creation order, the name index
+ * sorts them. */
+static herr_t
+H5VL__pdc_link_list(H5VL_pdc_link_t *grp, H5_index_t idx_type, H5_iter_order_t order,
+                    H5VL_pdc_link_t ***links)
+{
+    H5VL_pdc_link_t **list, *link;
+    hsize_t           i, n = grp->nlinks;
+
+    *links = NULL;
+    if (idx_type != H5_INDEX_NAME && idx_type != H5_INDEX_CRT_ORDER)
+        return FAIL;
+    if (order != H5_ITER_INC && order != H5_ITER_DEC && order != H5_ITER_NATIVE)
+        return FAIL;
+    if (n == 0)
+        return SUCCEED;
+
+    if (NULL == (list = (H5VL_pdc_link_t **)malloc((size_t)n * sizeof(H5VL_pdc_link_t *))))
+        return FAIL;
+    for (i = 0, link = grp->first; link; link = link->sibling)
+        list[i++] = link;
+    if (idx_type == H5_INDEX_NAME)
+        qsort(list, (size_t)n, sizeof(H5VL_pdc_link_t *), H5VL__pdc_link_name_cmp);
+    if (order == H5_ITER_DEC)
+        for (i = 0; i < n / 2; i++) {
+            link            = list[i];
+            list[i]         = list[n - 1 - i];
+            list[n - 1 - i] = link;
+        }
+
+    *links = list;
+    return SUCCEED;
+} /* end H5VL__pdc_link_list() */
+
+/*---------------------------------------------------------------------------*/
+/* The link a location points to: the handle itself, a path relative to it,
+ * or link n of the group it names in the order of an index. NULL when the
+ * link is not in the namespace index. */
+static H5VL_pdc_link_t *
+H5VL__pdc_link_loc(H5VL_pdc_obj_t *o, const H5VL_loc_params_t *loc_params)
+{
+    const H5VL_loc_by_idx_t *by_idx = &loc_params->loc_data.loc_by_idx;
+    const char *             name   = NULL;
+    H5VL_pdc_link_t *        link, **links;
+    char                     path[ADDR_MAX];
+
+    if (loc_params->type == H5VL_OBJECT_BY_NAME)
+        name = loc_params->loc_data.loc_by_name.name;
+    else if (loc_params->type == H5VL_OBJECT_BY_IDX)
+        name = by_idx->name;
+    else if (loc_params->type != H5VL_OBJECT_BY_SELF)
+        return NULL;
+    if (H5VL__pdc_link_path(o, name, path, sizeof(path)) < 0 ||
+        NULL == (link = H5VL__pdc_link_find(o->file_obj_ptr, path)))
+        return NULL;
+    if (loc_params->type != H5VL_OBJECT_BY_IDX)
+        return link;
+
+    if (link->type != H5O_TYPE_GROUP || by_idx->n >= link->nlinks ||
+        H5VL__pdc_link_list(link, by_idx->idx_type, by_idx->order, &links) < 0)
+        return NULL;
+    link = links[by_idx->n];
+    free(links);
+
+    return link;
+} /* end H5VL__pdc_link_loc() */
+
+/*---------------------------------------------------------------------------*/
+/* Link info of a link. Every link is a hard link, its token is a hash of the
+ * path so that tools telling objects apart by token see distinct objects. */
+static void
+H5VL__pdc_link_info(const H5VL_pdc_link_t *link, H5L_info2_t *linfo)
+{
+    uint64_t    h = 14695981039346656037ull;
+    const char *p;
+
+    for (p = link->path; *p; p++)
+        h = (h ^ (unsigned char)*p) * 1099511628211ull;
+
+    memset(linfo, 0, sizeof(H5L_info2_t));
+    linfo->type         = H5L_TYPE_HARD;
+    linfo->corder_valid = TRUE;
+    linfo->corder       = link->corder;
+    linfo->cset         = H5T_CSET_ASCII;
+    memcpy(&linfo->u.token, &h, sizeof(h));
+} /* end H5VL__pdc_link_info() */
+
+/*---------------------------------------------------------------------------*/
+/* Call the operator of an iteration on the links of a group, from *idx_p when
+ * it is given, and on the links below them when the iteration is recursive.
+ * Names are relative to the group iterated on. Returns the value of the
+ * operator that stopped the iteration, 0 once every link was visited. */
+static herr_t
+H5VL__pdc_link_iterate(H5VL_pdc_link_t *grp, const char *prefix, hid_t group_id, hsize_t *idx_p,
+                       H5VL_link_iterate_args_t *iter)
+{
+    H5VL_pdc_link_t **links;
+    H5L_info2_t       linfo;
+    char *            name = NULL, *tmp;
+    size_t            name_size = 0, len;
+    hsize_t           i;
+    herr_t            ret_value = 0;
+
+    if (H5VL__pdc_link_list(grp, iter->idx_type, iter->order, &links) < 0)
+        return FAIL;
+
+    for (i = idx_p ? *idx_p : 0; i < grp->nlinks && ret_value == 0; i++) {
+        // Recursive names grow with the depth of the group, the buffer with them
+        len = (prefix ? strlen(prefix) + 1 : 0) + strlen(links[i]->name) + 1;
+        if (len > name_size) {
+            if (NULL == (tmp = (char *)realloc(name, len))) {
+                ret_value = FAIL;
+                break;
             }
+            name      = tmp;
+            name_size = len;
         }
-        file->req_cnt = 0;
-        free(file->xfer_requests);
-        file->req_alloc = 0;
+        if (prefix)
+            snprintf(name, name_size, "%s/%s", prefix, links[i]->name);
+        else
+            snprintf(name, name_size, "%s", links[i]->name);
+        H5VL__pdc_link_info(links[i], &linfo);
+        ret_value = iter->op(group_id, name, &linfo, iter->op_data);
+        if (ret_value == 0 && iter->recursive && links[i]->type == H5O_TYPE_GROUP)
+            ret_value = H5VL__pdc_link_iterate(links[i], name, group_id, NULL, iter);
     }
+    if (idx_p)
+        *idx_p = i;
 
-    /* Free file data structures */
-    if (file->file_name)
-        free(file->file_name);
-    if (file->comm != MPI_COMM_NULL)
-        MPI_Comm_free(&file->comm);
-    file->comm = MPI_COMM_NULL;
+    free(name);
+    free(links);
+    return ret_value;
+} /* end H5VL__pdc_link_iterate() */
+
+/*---------------------------------------------------------------------------*/
+/* Next link of the namespace index in a walk from the root that visits the
+ * parents first and the links of a group in creation order */
+static H5VL_pdc_link_t *
+H5VL__pdc_link_next(H5VL_pdc_link_t *link)
+{
+    if (link->first)
+        return link->first;
+    while (link && link->sibling == NULL)
+        link = link->parent;
+
+    return link ? link->sibling : NULL;
+} /* end H5VL__pdc_link_next() */
+
+/*---------------------------------------------------------------------------*/
+/* Set up the namespace index of a file being created or opened. An opened
+ * file loads the index stored in its container: a file written without one
+ * only lists the objects created or opened since. */
+static herr_t
+H5VL__pdc_links_open(H5VL_pdc_obj_t *file, hbool_t load)
+{
+    H5VL_pdc_links_t *links = &file->links;
+    H5VL_pdc_link_t * root;
+    char *            value = NULL;
+    pdc_var_type_t    type  = PDC_CHAR;
+    psize_t           size  = 0;
+    herr_t            ret_value = SUCCEED;
+
+    links->buckets = (H5VL_pdc_link_t **)calloc(H5VL_PDC_LINK_BUCKETS, sizeof(H5VL_pdc_link_t *));
+    if (links->buckets == NULL)
+        return FAIL;
+    if (NULL == (root = (H5VL_pdc_link_t *)calloc(1, sizeof(H5VL_pdc_link_t))))
+        return FAIL;
+    if (NULL == (root->path = strdup("/"))) {
+        free(root);
+        return FAIL;
+    }
+    root->name  = root->path + 1;
+    root->type  = H5O_TYPE_GROUP;
+    links->root = root;
+
+    links->buckets[H5VL__pdc_link_hash(root->path)] = root;
+
+    // A created file stores its index even when it stays empty, replacing an older one
+    links->dirty = !load;
+    if (!load)
+        return SUCCEED;
+
+    if (H5VL__pdc_tag_get(file, TRUE, 0, file->cont_id, H5VL_PDC_LINKS_TAG, (void **)&value, &type, &size) <
+        0)
+        return SUCCEED;
+    ret_value    = H5VL__pdc_links_decode(file, value, (size_t)size);
+    links->dirty = FALSE;
+    free(value);
+
+    return ret_value;
+} /* end H5VL__pdc_links_open() */
+
+/*---------------------------------------------------------------------------*/
+/* Encode the namespace index of a file into a new buffer the caller frees.
+ * Each link is stored as its type and its path, the parents first, and the
+ * list ends with an empty string. */
+static herr_t
+H5VL__pdc_links_encode(H5VL_pdc_obj_t *file, char **buf, size_t *size)
+{
+    H5VL_pdc_link_t *link;
+    char *           p;
+
+    *size = 1;
+    for (link = H5VL__pdc_link_next(file->links.root); link; link = H5VL__pdc_link_next(link))
+        *size += strlen(link->path) + 2;
+    if (NULL == (*buf = (char *)malloc(*size)))
+        return FAIL;
+    p = *buf;
+    for (link = H5VL__pdc_link_next(file->links.root); link; link = H5VL__pdc_link_next(link)) {
+        *p++ = link->type == H5O_TYPE_DATASET ? 'd' : 'g';
+        strcpy(p, link->path);
+        p += strlen(link->path) + 1;
+    }
+    *p = '\0';
+
+    return SUCCEED;
+} /* end H5VL__pdc_links_encode() */
+
+/*---------------------------------------------------------------------------*/
+/* Add the links of an encoded namespace index to the index of a file. Links
+ * it already holds are kept. */
+static herr_t
+H5VL__pdc_links_decode(H5VL_pdc_obj_t *file, const char *buf, size_t size)
+{
+    const char *p, *end = buf + size;
+    size_t      len;
+
+    for (p = buf; p && p < end && *p != '\0'; p += len + 2) {
+        len = strnlen(p + 1, (size_t)(end - p - 1));
+        if (p + 1 + len >= end)
+            break;
+        if (NULL == H5VL__pdc_link_add(file, p + 1, *p == 'd' ? H5O_TYPE_DATASET : H5O_TYPE_GROUP))
+            return FAIL;
+    }
+
+    return SUCCEED;
+} /* end H5VL__pdc_links_decode() */
+
+/*---------------------------------------------------------------------------*/
+/* Store the namespace index of a file in its container when it changed. The
+ * ranks of a communicator may each have created links of their own: this is
+ * then a collective call, made at file flush and close, in which every rank
+ * merges the indexes of the others into its own and rank 0 stores the
+ * result. Links must be deleted on every rank, or the merge brings them
+ * back. */
+static herr_t
+H5VL__pdc_links_store(H5VL_pdc_obj_t *file)
+{
+    char *  buf = NULL, *all = NULL;
+    size_t  size   = 0;
+    int     state[2], nproc, i, len, *lens = NULL, *displs = NULL;
+    hbool_t merged = TRUE;
+    perr_t  ret;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    // Whether any rank changed its index, and whether any rank failed to encode it
+    state[0] = file->links.root != NULL && file->links.dirty;
+    state[1] = state[0] && H5VL__pdc_links_encode(file, &buf, &size) < 0;
+    if (file->comm != MPI_COMM_NULL &&
+        MPI_Allreduce(MPI_IN_PLACE, state, 2, MPI_INT, MPI_MAX, file->comm) != MPI_SUCCESS)
+        HGOTO_ERROR(H5E_SYM, H5E_MPI, FAIL, "can't agree on namespace index state");
+    if (state[1])
+        HGOTO_ERROR(H5E_SYM, H5E_CANTENCODE, FAIL, "can't encode namespace index");
+    if (!state[0])
+        HGOTO_DONE(SUCCEED);
+
+    if (file->comm != MPI_COMM_NULL) {
+        // Each rank gets the encoded index of every rank, once they all could make room for them
+        MPI_Comm_size(file->comm, &nproc);
+        len      = buf ? (int)size : 0;
+        lens     = (int *)malloc((size_t)nproc * sizeof(int));
+        displs   = (int *)malloc((size_t)nproc * sizeof(int));
+        state[1] = lens == NULL || displs == NULL;
+        if (!state[1] && MPI_Allgather(&len, 1, MPI_INT, lens, 1, MPI_INT, file->comm) != MPI_SUCCESS)
+            state[1] = 1;
+        for (i = 0, size = 0; !state[1] && i < nproc; i++) {
+            displs[i] = (int)size;
+            size += (size_t)lens[i];
+        }
+        if (!state[1] && NULL == (all = (char *)malloc(size > 0 ? size : 1)))
+            state[1] = 1;
+        if (MPI_Allreduce(MPI_IN_PLACE, &state[1], 1, MPI_INT, MPI_MAX, file->comm) != MPI_SUCCESS ||
+            state[1])
+            HGOTO_ERROR(H5E_SYM, H5E_CANTALLOC, FAIL, "can't gather namespace indexes");
+        if (MPI_Allgatherv(buf, len, MPI_CHAR, all, lens, displs, MPI_CHAR, file->comm) != MPI_SUCCESS)
+            HGOTO_ERROR(H5E_SYM, H5E_MPI, FAIL, "can't gather namespace indexes");
+
+        for (i = 0; i < nproc; i++)
+            if (i != file->my_rank && H5VL__pdc_links_decode(file, all + displs[i], (size_t)lens[i]) < 0)
+                merged = FALSE;
+        file->links.dirty = FALSE;
+        if (!merged)
+            HGOTO_ERROR(H5E_SYM, H5E_CANTINSERT, FAIL, "can't merge namespace indexes");
+        if (file->my_rank != 0)
+            HGOTO_DONE(SUCCEED);
+
+        // The merged index of rank 0 is the one stored
+        free(buf);
+        buf = NULL;
+        if (H5VL__pdc_links_encode(file, &buf, &size) < 0)
+            HGOTO_ERROR(H5E_SYM, H5E_CANTENCODE, FAIL, "can't encode namespace index");
+    }
+
+    H5VL_PDC_LOCK();
+    ret = PDCcont_put_tag(file->cont_id, H5VL_PDC_LINKS_TAG, buf, PDC_CHAR, (psize_t)size);
+    H5VL_PDC_UNLOCK();
+    if (ret < 0)
+        HGOTO_ERROR(H5E_SYM, H5E_WRITEERROR, FAIL, "can't store namespace index");
+    file->links.dirty = FALSE;
+
+done:
+    free(buf);
+    free(all);
+    free(lens);
+    free(displs);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_links_store() */
+
+/*---------------------------------------------------------------------------*/
+static void
+H5VL__pdc_links_free(H5VL_pdc_obj_t *file)
+{
+    H5VL_pdc_link_t *link, *next;
+    unsigned         b;
+
+    if (file->links.buckets == NULL)
+        return;
+
+    for (b = 0; b < H5VL_PDC_LINK_BUCKETS; b++)
+        for (link = file->links.buckets[b]; link; link = next) {
+            next = link->hnext;
+            free(link->path);
+            free(link);
+        }
+    free(file->links.buckets);
+    file->links.buckets = NULL;
+    file->links.root    = NULL;
+} /* end H5VL__pdc_links_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Make a group handle below a file or group handle, the group name being the
+ * one PDC object names are made of and the path its place in the namespace */
+static H5VL_pdc_obj_t *
+H5VL__pdc_group_init(H5VL_pdc_obj_t *o, const char *group_name, const char *path)
+{
+    H5VL_pdc_obj_t *group;
+
+    if (NULL == (group = H5VL_pdc_new_obj(NULL, o->under_vol_id)))
+        return NULL;
+    group->h5i_type     = H5I_GROUP;
+    group->h5o_type     = H5O_TYPE_GROUP;
+    group->comm         = o->comm;
+    group->info         = o->info;
+    group->cont_id      = o->cont_id;
+    group->file_obj_ptr = o->file_obj_ptr;
 
-    free(file);
-    file = NULL;
+    if ((group_name && NULL == (group->group_name = strdup(group_name))) ||
+        NULL == (group->file_name = strdup(o->file_name)) || NULL == (group->link_path = strdup(path))) {
+        H5VL_pdc_group_close(group, H5P_DATASET_XFER_DEFAULT, NULL);
+        return NULL;
+    }
 
-done:
-    FUNC_LEAVE_VOL
-} /* end H5VL__pdc_file_close() */
+    return group;
+} /* end H5VL__pdc_group_init() */
 
 /*---------------------------------------------------------------------------*/
 static H5VL_pdc_obj_t *
@@ -923,6 +5135,7 @@ H5VL__pdc_dset_init(H5VL_pdc_obj_t *file)
     dset->mapped       = 0;
     dset->type_id      = 0;
     dset->space_id     = 0;
+    dset->read_ahead   = -1;
     dset->h5i_type     = H5I_DATASET;
     dset->h5o_type     = H5O_TYPE_DATASET;
     dset->file_obj_ptr = file->file_obj_ptr;
@@ -951,6 +5164,10 @@ H5VL__pdc_dset_free(H5VL_pdc_obj_t *dset)
         H5Tclose(dset->type_id);
     if (dset->space_id != 0 && dset->space_id != H5S_ALL)
         H5Sclose(dset->space_id);
+    free(dset->group_name);
+    free(dset->dset_name);
+    if (dset->meta == NULL)
+        free(dset->member_ids);
 
     H5_LIST_REMOVE(dset, entry);
     free(dset);
@@ -960,36 +5177,316 @@ H5VL__pdc_dset_free(H5VL_pdc_obj_t *dset)
 } /* end H5VL__pdc_dset_free() */
 
 /*---------------------------------------------------------------------------*/
-static herr_t
-H5VL__pdc_sel_to_recx_iov(hid_t space_id, size_t type_size, uint64_t *off)
+/* Resolve the sieving settings on first use, with the sieving lock held */
+static void
+H5VL__pdc_sieve_init(void)
 {
-    hid_t   sel_iter_id;           /* Selection iteration info */
-    hbool_t sel_iter_init = FALSE; /* Selection iteration info has been initialized */
-    size_t  nseq;
-    size_t  nelem;
-    size_t  len[H5VL_PDC_SEQ_LIST_LEN];
+    const char *env;
 
-    FUNC_ENTER_VOL(herr_t, SUCCEED)
+    if (sieve_g.init)
+        return;
 
-    /* Initialize selection iterator  */
-    if ((sel_iter_id = H5Ssel_iter_create(space_id, type_size, 0)) < 0)
-        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator");
-    sel_iter_init = TRUE; /* Selection iteration info has been initialized */
+    sieve_g.max_size = H5VL_PDC_SIEVE_MAX;
+    if ((env = getenv(H5VL_PDC_SIEVE_MAX_ENV)) != NULL)
+        sieve_g.max_size = H5VL__pdc_parse_size(env);
+    sieve_g.cost = H5VL_PDC_SIEVE_COST;
+    if ((env = getenv(H5VL_PDC_SIEVE_COST_ENV)) != NULL)
+        sieve_g.cost = H5VL__pdc_parse_size(env);
+    sieve_g.init = TRUE;
+} /* end H5VL__pdc_sieve_init() */
 
-    /* Generate sequences from the file space until finished */
-    do {
-        /* Get the sequences of bytes */
-        if (H5Ssel_iter_get_seq_list(sel_iter_id, (size_t)H5VL_PDC_SEQ_LIST_LEN, (size_t)-1, &nseq, &nelem,
-                                     off, len) < 0)
-            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "sequence length generation failed");
-    } while (nseq == H5VL_PDC_SEQ_LIST_LEN);
+/*---------------------------------------------------------------------------*/
+/* Get the sieving settings, resolving them on first use */
+static void
+H5VL__pdc_sieve_get(H5VL_pdc_sieve_t *sieve)
+{
+    hg_thread_mutex_lock(&sieve_lock_g);
+    H5VL__pdc_sieve_init();
+    *sieve = sieve_g;
+    hg_thread_mutex_unlock(&sieve_lock_g);
+} /* end H5VL__pdc_sieve_get() */
 
-done:
-    /* Release selection iterator */
-    if (sel_iter_init && H5Ssel_iter_close(sel_iter_id) < 0)
-        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator");
-    FUNC_LEAVE_VOL
-} /* end H5VL__pdc_sel_to_recx_iov() */
+/*---------------------------------------------------------------------------*/
+/* Whether the blocks of a selection are cheaper to read as their bounding
+ * box than one by one: the regions cost their selected bytes plus the
+ * overhead of a transfer each, the box costs its own bytes plus a single
+ * overhead. When it is, box is set to the bounding box, laid out in
+ * row-major order. */
+static hbool_t
+H5VL__pdc_sieve_plan(const H5VL_pdc_block_t *blocks, size_t nblocks, size_t elem, H5VL_pdc_block_t *box)
+{
+    H5VL_pdc_sieve_t sieve;
+    uint64_t         lo[H5VL_PDC_MAX_RANK], hi[H5VL_PDC_MAX_RANK], nelem, selected = 0, box_bytes;
+    size_t           b;
+    int              d, ndim;
+
+    H5VL__pdc_sieve_get(&sieve);
+    if (nblocks < 2 || sieve.max_size == 0)
+        return FALSE;
+
+    ndim = blocks[0].ndim;
+    for (b = 0; b < nblocks; b++) {
+        for (d = 0, nelem = 1; d < ndim; d++) {
+            if (b == 0 || blocks[b].offset[d] < lo[d])
+                lo[d] = blocks[b].offset[d];
+            if (b == 0 || blocks[b].offset[d] + blocks[b].count[d] > hi[d])
+                hi[d] = blocks[b].offset[d] + blocks[b].count[d];
+            nelem *= blocks[b].count[d];
+        }
+        selected += nelem * elem;
+    }
+    for (d = 0, box_bytes = elem; d < ndim; d++)
+        box_bytes *= hi[d] - lo[d];
+
+    if (box_bytes > sieve.max_size || sieve.cost + box_bytes >= nblocks * sieve.cost + selected)
+        return FALSE;
+
+    memset(box, 0, sizeof(*box));
+    box->ndim = ndim;
+    for (d = ndim - 1, nelem = 1; d >= 0; d--) {
+        box->offset[d] = lo[d];
+        box->count[d]  = hi[d] - lo[d];
+        box->pitch[d]  = nelem;
+        nelem *= box->count[d];
+    }
+
+    return TRUE;
+} /* end H5VL__pdc_sieve_plan() */
+
+/*---------------------------------------------------------------------------*/
+/* Gather the blocks of a selection read as its bounding box from the buffer
+ * of the box into the user buffer, converting them when conv is set, and
+ * return the bytes they hold in the box */
+static size_t
+H5VL__pdc_sieve_copy(H5VL_pdc_memmap_t *map, const H5VL_pdc_xfer_t *box, const H5VL_pdc_block_t *blocks,
+                     size_t nblocks, const H5VL_pdc_conv_t *conv, void *buf)
+{
+    uint64_t stride[H5VL_PDC_MAX_RANK], nelem, at;
+    size_t   elem = box->buf.size, selected = 0, b;
+    int      d;
+
+    /* Byte steps of the box buffer along each dimension */
+    for (d = box->ndim - 1, nelem = elem; d >= 0; d--) {
+        stride[d] = nelem;
+        nelem *= box->count[d];
+    }
+
+    for (b = 0; b < nblocks; b++) {
+        for (d = 0, at = 0, nelem = 1; d < box->ndim; d++) {
+            at += (blocks[b].offset[d] - box->offset[d]) * stride[d];
+            nelem *= blocks[b].count[d];
+        }
+        H5VL__pdc_memmap_copy(map, &blocks[b], elem, (char *)buf + at, stride, conv, TRUE);
+        selected += nelem * elem;
+    }
+
+    return selected;
+} /* end H5VL__pdc_sieve_copy() */
+
+/*---------------------------------------------------------------------------*/
+/* PDC type of the elements of a dataset of the given datatype: integers and
+ * enumerations by their size and sign, floats by their size. PDC_UNKNOWN for
+ * the other classes and for sizes PDC has no type of, such as half floats,
+ * long doubles or 128-bit integers */
+static pdc_var_type_t
+H5VL__pdc_type_to_pdc(hid_t type_id)
+{
+    hid_t          super_id = H5I_INVALID_HID;
+    H5T_class_t    tclass;
+    hbool_t        is_signed;
+    pdc_var_type_t ret_value = PDC_UNKNOWN;
+
+    if ((tclass = H5Tget_class(type_id)) == H5T_ENUM) {
+        if ((super_id = H5Tget_super(type_id)) < 0)
+            return PDC_UNKNOWN;
+        type_id = super_id;
+        tclass  = H5T_INTEGER;
+    }
+
+    if (tclass == H5T_INTEGER) {
+        is_signed = H5Tget_sign(type_id) != H5T_SGN_NONE;
+        switch (H5Tget_size(type_id)) {
+            case 1:
+                ret_value = is_signed ? PDC_INT8 : PDC_UINT8;
+                break;
+            case 2:
+                ret_value = is_signed ? PDC_INT16 : PDC_UINT16;
+                break;
+            case 4:
+                ret_value = is_signed ? PDC_INT : PDC_UINT;
+                break;
+            case 8:
+                ret_value = is_signed ? PDC_INT64 : PDC_UINT64;
+                break;
+            default:
+                break;
+        }
+    }
+    else if (tclass == H5T_FLOAT) {
+        switch (H5Tget_size(type_id)) {
+            case 4:
+                ret_value = PDC_FLOAT;
+                break;
+            case 8:
+                ret_value = PDC_DOUBLE;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (super_id >= 0)
+        H5Tclose(super_id);
+
+    return ret_value;
+} /* end H5VL__pdc_type_to_pdc() */
+
+/*---------------------------------------------------------------------------*/
+/* Native datatype of the elements of a numeric PDC object, for the objects
+ * created without the tag of their HDF5 datatype; 0 for the other objects */
+static hid_t
+H5VL__pdc_type_from_pdc(pdc_var_type_t pdc_type)
+{
+    switch (pdc_type) {
+        case PDC_INT8:
+            return H5Tcopy(H5T_NATIVE_INT8);
+        case PDC_UINT8:
+            return H5Tcopy(H5T_NATIVE_UINT8);
+        case PDC_INT16:
+            return H5Tcopy(H5T_NATIVE_INT16);
+        case PDC_UINT16:
+            return H5Tcopy(H5T_NATIVE_UINT16);
+        case PDC_INT:
+            return H5Tcopy(H5T_NATIVE_INT32);
+        case PDC_UINT:
+            return H5Tcopy(H5T_NATIVE_UINT32);
+        case PDC_INT64:
+            return H5Tcopy(H5T_NATIVE_INT64);
+        case PDC_UINT64:
+            return H5Tcopy(H5T_NATIVE_UINT64);
+        case PDC_FLOAT:
+            return H5Tcopy(H5T_NATIVE_FLOAT);
+        case PDC_DOUBLE:
+            return H5Tcopy(H5T_NATIVE_DOUBLE);
+        default:
+            return 0;
+    }
+} /* end H5VL__pdc_type_from_pdc() */
+
+/*---------------------------------------------------------------------------*/
+/* Whether a PDC object holds integers */
+static hbool_t
+H5VL__pdc_type_is_int(pdc_var_type_t pdc_type)
+{
+    switch (pdc_type) {
+        case PDC_INT:
+        case PDC_UINT:
+        case PDC_SHORT:
+        case PDC_LONG:
+        case PDC_INT8:
+        case PDC_UINT8:
+        case PDC_INT16:
+        case PDC_UINT16:
+        case PDC_INT64:
+        case PDC_UINT64:
+            return TRUE;
+        default:
+            return FALSE;
+    }
+} /* end H5VL__pdc_type_is_int() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy n fields of size bytes, src_stride bytes apart in src, to dst_stride
+ * bytes apart in dst. The common sizes are copied with fixed-size moves. */
+static void
+H5VL__pdc_field_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride, size_t size, size_t n)
+{
+    char *      d = (char *)dst;
+    const char *s = (const char *)src;
+    size_t      i;
+
+    switch (size) {
+        case 1:
+            for (i = 0; i < n; i++)
+                d[i * dst_stride] = s[i * src_stride];
+            break;
+        case 2:
+            for (i = 0; i < n; i++)
+                memcpy(d + i * dst_stride, s + i * src_stride, 2);
+            break;
+        case 4:
+            for (i = 0; i < n; i++)
+                memcpy(d + i * dst_stride, s + i * src_stride, 4);
+            break;
+        case 8:
+            for (i = 0; i < n; i++)
+                memcpy(d + i * dst_stride, s + i * src_stride, 8);
+            break;
+        default:
+            for (i = 0; i < n; i++)
+                memcpy(d + i * dst_stride, s + i * src_stride, size);
+            break;
+    }
+} /* end H5VL__pdc_field_copy() */
+
+/*---------------------------------------------------------------------------*/
+/* Split n packed compound elements of stride bytes into one column per
+ * member, converting the members that need it. The elements are split
+ * CONV_BATCH at a time, so that each batch stays in cache while all of its
+ * members are extracted. */
+static void
+H5VL__pdc_columns_split(const H5VL_pdc_member_t *members, int nmembers, void **cols, const void *src,
+                        size_t n, size_t stride)
+{
+    uint64_t    tmp[H5VL_PDC_CONV_BATCH];
+    const char *in;
+    char *      out;
+    size_t      t, nt;
+    int         m;
+
+    for (t = 0; t < n; t += nt) {
+        nt = n - t < H5VL_PDC_CONV_BATCH ? n - t : H5VL_PDC_CONV_BATCH;
+        for (m = 0; m < nmembers; m++) {
+            in  = (const char *)src + t * stride + members[m].mem_off;
+            out = (char *)cols[m] + t * members[m].file_size;
+            if (members[m].conv.src_size == 0)
+                H5VL__pdc_field_copy(out, members[m].file_size, in, stride, members[m].file_size, nt);
+            else {
+                H5VL__pdc_field_copy(tmp, members[m].mem_size, in, stride, members[m].mem_size, nt);
+                H5VL__pdc_conv_run(&members[m].conv, out, tmp, nt);
+            }
+        }
+    }
+} /* end H5VL__pdc_columns_split() */
+
+/*---------------------------------------------------------------------------*/
+/* Merge one column per member into n packed compound elements of stride
+ * bytes, the reverse of H5VL__pdc_columns_split(). Bytes of the elements
+ * that belong to no member are left as they are. */
+static void
+H5VL__pdc_columns_merge(const H5VL_pdc_member_t *members, int nmembers, void *const *cols, void *dst,
+                        size_t n, size_t stride)
+{
+    uint64_t    tmp[H5VL_PDC_CONV_BATCH];
+    const char *in;
+    char *      out;
+    size_t      t, nt;
+    int         m;
+
+    for (t = 0; t < n; t += nt) {
+        nt = n - t < H5VL_PDC_CONV_BATCH ? n - t : H5VL_PDC_CONV_BATCH;
+        for (m = 0; m < nmembers; m++) {
+            in  = (const char *)cols[m] + t * members[m].file_size;
+            out = (char *)dst + t * stride + members[m].mem_off;
+            if (members[m].conv.src_size == 0)
+                H5VL__pdc_field_copy(out, stride, in, members[m].file_size, members[m].file_size, nt);
+            else {
+                H5VL__pdc_conv_run(&members[m].conv, tmp, in, nt);
+                H5VL__pdc_field_copy(out, stride, tmp, members[m].mem_size, members[m].mem_size, nt);
+            }
+        }
+    }
+} /* end H5VL__pdc_columns_merge() */
 
 /*---------------------------------------------------------------------------*/
 void *
@@ -1003,6 +5500,7 @@ H5VL_pdc_file_create(const char *name, unsigned flags, hid_t fcpl_id __attribute
     H5VL_pdc_info_t *info;
     H5VL_pdc_obj_t * file = NULL;
     pdcid_t          cont_prop;
+    perr_t           ret = SUCCEED;
 
     FUNC_ENTER_VOL(void *, NULL)
 
@@ -1016,14 +5514,21 @@ H5VL_pdc_file_create(const char *name, unsigned flags, hid_t fcpl_id __attribute
     if (NULL == (file = H5VL__pdc_file_init(name, flags, info, fapl_id)))
         HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't init PDC file struct");
 
-    if ((cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc_id_g)) <= 0)
-        HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, NULL, "can't create container property");
+    H5VL_PDC_LOCK();
+    if ((cont_prop = PDCprop_create(PDC_CONT_CREATE, pdc_id_g)) > 0) {
+        file->cont_id = PDCcont_create(name, cont_prop);
+        ret           = PDCprop_close(cont_prop);
+    }
+    H5VL_PDC_UNLOCK();
 
-    if ((file->cont_id = PDCcont_create(name, cont_prop)) <= 0)
+    if (cont_prop <= 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, NULL, "can't create container property");
+    if (file->cont_id <= 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, NULL, "can't create container");
-
-    if ((PDCprop_close(cont_prop)) < 0)
+    if (ret < 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, NULL, "can't close container property");
+    if (H5VL__pdc_links_open(file, FALSE) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't set up namespace index");
 
     /* Free info */
     if (info && H5VL_pdc_info_free(info) < 0)
@@ -1068,9 +5573,19 @@ H5VL_pdc_file_open(const char *name, unsigned flags, hid_t fapl_id, hid_t dxpl_i
     if (NULL == (file = H5VL__pdc_file_init(name, flags, info, fapl_id)))
         HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't init PDC file struct");
 
-    if ((file->cont_id = PDCcont_open(name, pdc_id_g)) <= 0)
+    H5VL_PDC_LOCK();
+    if (file->coll_world)
+        file->cont_id = PDCcont_open_col(name, pdc_id_g);
+    else
+        file->cont_id = PDCcont_open(name, pdc_id_g);
+    H5VL_PDC_UNLOCK();
+    if (file->cont_id <= 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTOPENFILE, NULL, "failed to create container");
 
+    /* The groups and datasets of the file are listed from the index stored with it */
+    if (H5VL__pdc_links_open(file, TRUE) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTINIT, NULL, "can't load namespace index");
+
     /* Free info */
     if (info && H5VL_pdc_info_free(info) < 0)
         HGOTO_ERROR(H5E_VOL, H5E_CANTFREE, NULL, "can't free connector info");
@@ -1112,7 +5627,29 @@ H5VL_pdc_file_close(void *_file, hid_t dxpl_id __attribute__((unused)), void **r
     /*         HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "failed to free dataset"); */
     /* } */
 
-    if ((ret = PDCcont_close(file->cont_id)) < 0)
+    /* The namespace index is stored first, as every rank takes part in it */
+    if (H5VL__pdc_links_store(file) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_WRITEERROR, FAIL, "can't store namespace index");
+
+    /* Deferred creates are made, and writes may still be in flight in the background */
+    if (file->creates && H5VL__pdc_create_flush(file) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CANTCREATE, FAIL, "can't create deferred datasets");
+    if (H5VL__pdc_file_drain(file, 0) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_WRITEERROR, FAIL, "can't complete deferred write requests");
+
+    /* Write the attributes back, and close the objects kept open by the metadata cache */
+    if (H5VL__pdc_attr_flush(file) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_WRITEERROR, FAIL, "can't write attributes");
+    if (H5VL__pdc_meta_invalidate(file, NULL) < 0)
+        HGOTO_ERROR(H5E_FILE, H5E_CLOSEERROR, FAIL, "can't close cached dataset objects");
+    H5VL__pdc_attr_free(file->attrs);
+    file->attrs = NULL;
+    H5VL__pdc_links_free(file);
+
+    H5VL_PDC_LOCK();
+    ret = PDCcont_close(file->cont_id);
+    H5VL_PDC_UNLOCK();
+    if (ret < 0)
         HGOTO_ERROR(H5E_FILE, H5E_CANTCLOSEFILE, FAIL, "failed to close container");
 
     /* Close the file */
@@ -1203,6 +5740,22 @@ H5VL_pdc_file_specific(void *file, H5VL_file_specific_args_t *args, hid_t dxpl_i
     if (args->op_type != H5VL_FILE_FLUSH) {
         ret_value = H5VLfile_specific(new_o, under_vol_id, new_args, dxpl_id, req);
     }
+    else if (o->file_obj_ptr && H5VL__pdc_links_store(o->file_obj_ptr) < 0) {
+        /* Flushing stores the namespace index when it changed, first as every rank takes part in it */
+        ret_value = -1;
+    }
+    else if (o->file_obj_ptr && o->file_obj_ptr->creates && H5VL__pdc_create_flush(o->file_obj_ptr) < 0) {
+        /* makes the deferred creates of the file */
+        ret_value = -1;
+    }
+    else if (o->file_obj_ptr && H5VL__pdc_attr_flush(o->file_obj_ptr) < 0) {
+        /* and writes back the attributes written */
+        ret_value = -1;
+    }
+    else if (o->file_obj_ptr && H5VL__pdc_file_drain(o->file_obj_ptr, 0) < 0) {
+        /* Flushing completes every deferred write of the file */
+        ret_value = -1;
+    }
 
     /* Check for async request */
     if (req && *req)
@@ -1262,9 +5815,15 @@ H5VL_pdc_dataset_create(void *obj, const H5VL_loc_params_t *loc_params, const ch
     H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)obj;
     int             buff_len, ndim;
     H5T_class_t     dclass;
-    H5VL_pdc_obj_t *dset = NULL;
+    pdc_var_type_t  pdc_type = PDC_UNKNOWN;
+    H5VL_pdc_obj_t *dset     = NULL, *file;
     pdcid_t         obj_prop, obj_id;
     hsize_t         dims[H5S_MAX_RANK];
+    void *          type_buf = NULL;
+    size_t          type_size;
+    hbool_t         columnar = FALSE;
+    char            path[ADDR_MAX];
+    perr_t          ret;
 
     FUNC_ENTER_VOL(void *, NULL)
 
@@ -1303,10 +5862,42 @@ H5VL_pdc_dataset_create(void *obj, const H5VL_loc_params_t *loc_params, const ch
     if (!name)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "dataset name is NULL");
 
+    // Datatype classes PDC has no storage for are rejected before anything is set up
+    switch (dclass = H5Tget_class(type_id)) {
+        case H5T_ARRAY:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, NULL, "array datatype is not supported in PDC");
+        case H5T_REFERENCE:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, NULL, "reference datatype is not supported in PDC");
+        case H5T_OPAQUE:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, NULL, "opaque datatype is not supported in PDC");
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_ENUM:
+            // Numeric elements are stored with the PDC type of their size and sign
+            if ((pdc_type = H5VL__pdc_type_to_pdc(type_id)) == PDC_UNKNOWN)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, NULL, "datatype size has no PDC counterpart");
+            break;
+        case H5T_STRING:
+        case H5T_COMPOUND:
+            break;
+        case H5T_NO_CLASS:
+        default:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, NULL, "unknown or no datatype class");
+    }
+
     /* Init dataset */
     if (NULL == (dset = H5VL__pdc_dset_init(o)))
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, NULL, "can't init PDC dataset struct");
 
+    // The dataset is listed by its group from now on
+    if (H5VL__pdc_link_path(o, name, path, sizeof(path)) < 0 ||
+        NULL == H5VL__pdc_link_add(dset->file_obj_ptr, path, H5O_TYPE_DATASET))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "can't add dataset to namespace index");
+
+    // A dataset of the same name opened before is replaced by this one
+    if (H5VL__pdc_meta_invalidate(dset->file_obj_ptr, new_name) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, NULL, "can't close replaced dataset");
+
     /* Finish setting up dataset struct */
     if ((dset->type_id = H5Tcopy(type_id)) < 0)
         HGOTO_ERROR(H5E_SYM, H5E_CANTCOPY, NULL, "failed to copy datatype");
@@ -1317,26 +5908,28 @@ H5VL_pdc_dataset_create(void *obj, const H5VL_loc_params_t *loc_params, const ch
     dset->dcpl_id = H5Pcopy(dcpl_id);
     dset->dapl_id = H5Pcopy(dapl_id);
     dset->dxpl_id = H5Pcopy(dxpl_id);
-
+    if (H5VL__pdc_plist_get(dapl_id, H5VL_PDC_READ_CACHE_PROP, sizeof(hbool_t), &dset->read_cache) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get read cache property");
+    if (dset->read_cache)
+        H5VL__pdc_rcache_init();
+
+    // The full datatype is kept in a tag of the object, so that the dataset is opened with it
+    if (H5Tencode(type_id, NULL, &type_size) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTENCODE, NULL, "can't get encoded datatype size");
+    if (NULL == (type_buf = malloc(type_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "can't allocate encoded datatype");
+    if (H5Tencode(type_id, type_buf, &type_size) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTENCODE, NULL, "can't encode datatype");
+
+    H5VL_PDC_LOCK();
     obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc_id_g);
 
-    dclass = H5Tget_class(type_id);
     switch (dclass) {
         case H5T_INTEGER:
-            /* printf("Datatype class: Integer\n"); */
-            PDCprop_set_obj_type(obj_prop, PDC_INT);
-            dset->pdc_type = PDC_INT;
-            break;
         case H5T_FLOAT:
-            /* printf("Datatype class: Float\n"); */
-            if (H5Tequal(H5T_NATIVE_DOUBLE, type_id) == TRUE) {
-                PDCprop_set_obj_type(obj_prop, PDC_DOUBLE);
-                dset->pdc_type = PDC_DOUBLE;
-            }
-            else {
-                PDCprop_set_obj_type(obj_prop, PDC_FLOAT);
-                dset->pdc_type = PDC_FLOAT;
-            }
+        case H5T_ENUM:
+            dset->pdc_type = pdc_type;
+            PDCprop_set_obj_type(obj_prop, dset->pdc_type);
             break;
         case H5T_STRING:
             /* printf("Datatype class: String\n"); */
@@ -1347,25 +5940,10 @@ H5VL_pdc_dataset_create(void *obj, const H5VL_loc_params_t *loc_params, const ch
             PDCprop_set_obj_type(obj_prop, PDC_CHAR);
             dset->pdc_type = PDC_CHAR;
             break;
-        case H5T_ARRAY:
-            printf("Datatype class: Array is not supported in PDC\n");
-            break;
-        case H5T_ENUM:
-            /* printf("Datatype class: Enum\n"); */
-            PDCprop_set_obj_type(obj_prop, PDC_INT);
-            dset->pdc_type = PDC_INT;
-            break;
-        case H5T_REFERENCE:
-            printf("Datatype class: Reference is not supported in PDC\n");
-            break;
-        case H5T_OPAQUE:
-            printf("Datatype class: Opaque is not supported in PDC\n");
-            break;
-        case H5T_NO_CLASS:
         default:
-            printf("Unknown or no datatype class\n");
             break;
     }
+    H5VL_PDC_UNLOCK();
 
     /* Get dataspace extent */
     if ((ndim = H5Sget_simple_extent_ndims(space_id)) < 0)
@@ -1378,58 +5956,85 @@ H5VL_pdc_dataset_create(void *obj, const H5VL_loc_params_t *loc_params, const ch
     //       Multiple the last dimension by the compound dtype size so we can write the
     //       correct amount of total data, and add a tag to record for future read.
     if (dclass == H5T_COMPOUND) {
-        o->compound_size = H5Tget_size(type_id);
+        o->compound_size    = H5Tget_size(type_id);
+        dset->compound_size = o->compound_size;
         dims[ndim - 1] *= o->compound_size;
     }
 
+    H5VL_PDC_LOCK();
     PDCprop_set_obj_dims(obj_prop, ndim, dims);
+    H5VL_PDC_UNLOCK();
 
-    /* Create PDC object */
-    if (o->comm != MPI_COMM_NULL) {
-#ifdef ENABLE_LOGGING
-        fprintf(stderr, "Rank %d: PDC obj create mpi [%s]\n", o->my_rank, new_name);
-#endif
-        obj_id = PDCobj_create_mpi(o->cont_id, new_name, obj_prop, 0, o->comm);
+    dset->h5i_type = H5I_DATASET;
+    dset->h5o_type = H5O_TYPE_DATASET;
+    strcpy(dset->obj_name, new_name);
+    o->nobj++;
+    H5_LIST_INSERT_HEAD(&o->ids, dset, entry);
+
+    // Compound members can be stored in objects of their own, so that they are read on their own
+    if (dclass == H5T_COMPOUND &&
+        H5VL__pdc_plist_get(dcpl_id, H5VL_PDC_COLUMNAR_PROP, sizeof(columnar), &columnar) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get columnar property");
+
+    // The object is created with the next batch of creates of the file, unless the dataset is
+    // columnar: its members are created right away
+    file = dset->file_obj_ptr;
+    if (file->defer_create && !columnar) {
+        if (H5VL__pdc_create_defer(file, dset, obj_prop, type_buf, type_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't defer dataset create");
+        type_buf = NULL;
     }
     else {
+        H5VL_PDC_LOCK();
+        /* Create PDC object */
+        if (o->comm != MPI_COMM_NULL) {
 #ifdef ENABLE_LOGGING
-        fprintf(stderr, "Rank %d: PDC obj create [%s]\n", o->my_rank, new_name);
+            fprintf(stderr, "Rank %d: PDC obj create mpi [%s]\n", o->my_rank, new_name);
 #endif
-        obj_id = PDCobj_create(o->cont_id, new_name, obj_prop);
-    }
-
+            obj_id = PDCobj_create_mpi(o->cont_id, new_name, obj_prop, 0, o->comm);
+        }
+        else {
 #ifdef ENABLE_LOGGING
-    fprintf(stderr, "Rank %d: PDC obj id %lu, dims %lu\n", o->my_rank, obj_id, dims[0]);
+            fprintf(stderr, "Rank %d: PDC obj create [%s]\n", o->my_rank, new_name);
 #endif
+            obj_id = PDCobj_create(o->cont_id, new_name, obj_prop);
+        }
 
-    // TODO: temporary workaround for writing compound data, as current PDC doesn't support
-    //       compound datatype
-    if (dclass == H5T_COMPOUND)
-        PDCobj_put_tag(obj_id, "PDC_COMPOUND_DTYPE_SIZE", (void *)&o->compound_size, PDC_SIZE_T,
-                       sizeof(psize_t));
-
-    dset->obj_id   = obj_id;
-    dset->h5i_type = H5I_DATASET;
-    dset->h5o_type = H5O_TYPE_DATASET;
-    strcpy(dset->obj_name, name);
-    o->nobj++;
-    H5_LIST_INSERT_HEAD(&o->ids, dset, entry);
+#ifdef ENABLE_LOGGING
+        fprintf(stderr, "Rank %d: PDC obj id %lu, dims %lu\n", o->my_rank, obj_id, dims[0]);
+#endif
 
-    if ((PDCprop_close(obj_prop)) < 0)
-        HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't close object property");
+        // TODO: temporary workaround for writing compound data, as current PDC doesn't support
+        //       compound datatype
+        if (dclass == H5T_COMPOUND)
+            PDCobj_put_tag(obj_id, "PDC_COMPOUND_DTYPE_SIZE", (void *)&o->compound_size, PDC_SIZE_T,
+                           sizeof(psize_t));
+        PDCobj_put_tag(obj_id, H5VL_PDC_DTYPE_TAG, type_buf, PDC_CHAR, (psize_t)type_size);
+        dset->obj_id = obj_id;
+
+        ret = PDCprop_close(obj_prop);
+        H5VL_PDC_UNLOCK();
+        if (ret < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't close object property");
+
+        if (columnar && H5VL__pdc_columnar_create(o, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't create compound member objects");
+        if (H5VL__pdc_meta_insert(file, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "can't cache dataset metadata");
+    }
 
     /* Set return value */
     FUNC_RETURN_SET((void *)dset);
 
 done:
+    free(type_buf);
     FUNC_LEAVE_VOL
 }
 
 /*---------------------------------------------------------------------------*/
 static void *
-H5VL_pdc_dataset_open(void *obj, const H5VL_loc_params_t *loc_params, const char *_name,
-                      hid_t dapl_id __attribute__((unused)), hid_t dxpl_id __attribute__((unused)),
-                      void **req __attribute__((unused)))
+H5VL_pdc_dataset_open(void *obj, const H5VL_loc_params_t *loc_params, const char *_name, hid_t dapl_id,
+                      hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
@@ -1438,8 +6043,16 @@ H5VL_pdc_dataset_open(void *obj, const H5VL_loc_params_t *loc_params, const char
     FUNC_ENTER_VOL(void *, NULL)
 
     H5VL_pdc_obj_t *     o    = (H5VL_pdc_obj_t *)obj;
-    H5VL_pdc_obj_t *     dset = NULL;
+    H5VL_pdc_obj_t *     dset = NULL, *file;
+    H5VL_pdc_meta_t *    meta;
+    H5VL_pdc_create_t *  create;
     struct pdc_obj_info *obj_info;
+    hbool_t              read_ahead;
+    htri_t               hinted;
+    void *               type_buf  = NULL;
+    psize_t              type_size = 0;
+    pdc_var_type_t       type_tag;
+    char                 path[ADDR_MAX];
 
     int buff_len;
     if (o->group_name) {
@@ -1478,31 +6091,107 @@ H5VL_pdc_dataset_open(void *obj, const H5VL_loc_params_t *loc_params, const char
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, NULL, "can't init PDC dataset struct");
 
     strcpy(dset->obj_name, name);
-    dset->obj_id = PDCobj_open(name, pdc_id_g);
-    if (dset->obj_id <= 0) {
-        free(dset);
-        return NULL;
-    }
     dset->under_vol_id = o->under_vol_id;
     dset->under_object = dset;
-    /* pdcid_t id_name    = (pdcid_t)name; */
-    obj_info       = PDCobj_get_info(dset->obj_id);
-    dset->pdc_type = obj_info->obj_pt->type;
 
-    // TODO: temporary workaround for writing compound data, as current PDC doesn't support
-    //       compound datatype
-    if (dset->pdc_type == PDC_CHAR) {
-        psize_t        value_size;
-        pdc_var_type_t value_type;
-        psize_t *      value;
-        PDCobj_get_tag(dset->obj_id, "PDC_COMPOUND_DTYPE_SIZE", (void **)&value, &value_type, &value_size);
-        if (value_size > 0) {
-            dset->compound_size = *value;
-            obj_info->obj_pt->dims[obj_info->obj_pt->ndim - 1] /= *value;
+    // A dataset whose create is still deferred is made on its own first
+    file = dset->file_obj_ptr;
+    for (create = file->creates; create; create = create->next)
+        if (!create->made && !strcmp(create->name, name))
+            break;
+    if (create && H5VL__pdc_create_one(file, create) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't create deferred dataset");
+
+    // A dataset that is open, or was closed recently, is opened from its cached metadata
+    if (NULL != (meta = H5VL__pdc_meta_lookup(file, name))) {
+        dset->meta          = meta;
+        dset->obj_id        = meta->obj_id;
+        dset->pdc_type      = meta->pdc_type;
+        dset->compound_size = meta->compound_size;
+        dset->member_ids    = meta->member_ids;
+        dset->nmembers      = meta->nmembers;
+        if (meta->type_id > 0 && (dset->type_id = H5Tcopy(meta->type_id)) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCOPY, NULL, "failed to copy datatype");
+        if ((dset->space_id = H5Screate_simple(meta->ndim, meta->dims, NULL)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, NULL, "can't create dataspace");
+    }
+    else {
+        // The open is collective on a communicator spanning all PDC clients, the tags of the object
+        // are then read by rank 0 and broadcast as well
+        dset->obj_id = H5VL__pdc_obj_open(file, name);
+        if (dset->obj_id <= 0) {
+            free(dset);
+            return NULL;
+        }
+        /* pdcid_t id_name    = (pdcid_t)name; */
+        H5VL_PDC_LOCK();
+        obj_info = PDCobj_get_info(dset->obj_id);
+        H5VL_PDC_UNLOCK();
+        dset->pdc_type = obj_info->obj_pt->type;
+
+        // TODO: temporary workaround for writing compound data, as current PDC doesn't support
+        //       compound datatype
+        if (dset->pdc_type == PDC_CHAR) {
+            psize_t        value_size;
+            pdc_var_type_t value_type;
+            psize_t *      value;
+            H5VL__pdc_tag_get(file, file->coll_world, dset->obj_id, 0, "PDC_COMPOUND_DTYPE_SIZE",
+                              (void **)&value, &value_type, &value_size);
+            if (value_size > 0) {
+                dset->compound_size = *value;
+                obj_info->obj_pt->dims[obj_info->obj_pt->ndim - 1] /= *value;
+            }
+            free(value);
         }
+        if (H5VL__pdc_tag_get(file, file->coll_world, dset->obj_id, 0, H5VL_PDC_DTYPE_TAG, &type_buf,
+                              &type_tag, &type_size) < 0)
+            type_size = 0;
+
+        // Objects created without the tag of their datatype get the native type of their elements
+        if (type_buf && type_size > 0) {
+            dset->type_id = H5Tdecode(type_buf);
+            free(type_buf);
+            if (dset->type_id < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTDECODE, NULL, "can't decode datatype");
+        }
+        else
+            dset->type_id = H5VL__pdc_type_from_pdc(dset->pdc_type);
+        if (H5VL__pdc_columnar_open(dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, NULL, "can't open compound member objects");
+
+        dset->space_id = H5Screate_simple(obj_info->obj_pt->ndim, obj_info->obj_pt->dims, NULL);
+
+        if (H5VL__pdc_meta_insert(file, dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "can't cache dataset metadata");
     }
 
-    dset->space_id = H5Screate_simple(obj_info->obj_pt->ndim, obj_info->obj_pt->dims, NULL);
+    // A dataset found on the servers is listed from now on, in files stored without their index
+    if (H5VL__pdc_link_path(o, _name, path, sizeof(path)) >= 0 && NULL == H5VL__pdc_link_find(file, path))
+        H5VL__pdc_link_add(file, path, H5O_TYPE_DATASET);
+
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+    if (meta)
+        file->stats.nmeta_hit++;
+    else
+        file->stats.nmeta_miss++;
+    if (file->flush.enabled)
+        hg_thread_mutex_unlock(&file->flush.mutex);
+
+    /* Where the dataset sits in a sequence of groups, for read-ahead */
+    dset->dset_name = strdup(_name);
+    if (o->group_name)
+        dset->group_name = strdup(o->group_name);
+    if ((hinted = H5VL__pdc_plist_get(dapl_id, H5VL_PDC_READ_AHEAD_PROP, sizeof(read_ahead),
+                                      &read_ahead)) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get read-ahead property");
+    if (hinted)
+        dset->read_ahead = read_ahead ? 1 : 0;
+    if (H5VL__pdc_plist_get(dapl_id, H5VL_PDC_READ_CACHE_PROP, sizeof(hbool_t), &dset->read_cache) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, NULL, "can't get read cache property");
+    if (dset->read_cache)
+        H5VL__pdc_rcache_init();
+
     o->nobj++;
     H5_LIST_INSERT_HEAD(&o->ids, dset, entry);
 
@@ -1513,13 +6202,20 @@ done:
     FUNC_LEAVE_VOL
 } /* end H5VL_pdc_dataset_open() */
 
+/*---------------------------------------------------------------------------*/
+/* Whether elements of a memory datatype can be copied as they are to or from
+ * a dataset, when no conversion kernel was set up for them: its class must
+ * match the PDC type of the dataset and its size the stored size */
 int
-_check_mem_type_id(H5T_class_t h5_dclass, pdc_var_type_t pdc_dtype)
+_check_mem_type_id(hid_t mem_type_id, const H5VL_pdc_obj_t *dset)
 {
-    int is_match = 0;
-    switch (h5_dclass) {
+    pdc_var_type_t pdc_dtype = dset->pdc_type;
+    int            is_match  = 0;
+
+    switch (H5Tget_class(mem_type_id)) {
         case H5T_INTEGER:
-            if (pdc_dtype == PDC_INT)
+        case H5T_ENUM:
+            if (H5VL__pdc_type_is_int(pdc_dtype))
                 is_match = 1;
             break;
         case H5T_FLOAT:
@@ -1535,84 +6231,615 @@ _check_mem_type_id(H5T_class_t h5_dclass, pdc_var_type_t pdc_dtype)
             if (pdc_dtype == PDC_CHAR)
                 is_match = 1;
             break;
-        case H5T_ARRAY:
-            printf("Datatype class: Array is not supported in PDC\n");
-            break;
-        case H5T_ENUM:
-            if (pdc_dtype == PDC_INT)
-                is_match = 1;
-            break;
-        case H5T_REFERENCE:
-            printf("Datatype class: Reference is not supported in PDC\n");
-            break;
-        case H5T_OPAQUE:
-            printf("Datatype class: Opaque is not supported in PDC\n");
-            break;
-        case H5T_NO_CLASS:
         default:
-            printf("Unknown or no datatype class\n");
+            // Array, reference and opaque datatypes have no PDC counterpart
             break;
     }
 
-    return is_match;
-}
+    // Objects stored without their datatype only know the size of compound elements
+    if (is_match && dset->type_id > 0)
+        is_match = H5Tget_size(mem_type_id) == H5Tget_size(dset->type_id);
+    else if (is_match && dset->compound_size > 0)
+        is_match = H5Tget_size(mem_type_id) == dset->compound_size;
+
+    return is_match;
+}
+
+/*---------------------------------------------------------------------------*/
+herr_t
+_add_xfer_request(H5VL_pdc_obj_t *file, const H5VL_pdc_xfer_t *xfer)
+{
+    H5VL_pdc_xfer_t *xfers;
+    int              alloc;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (file == NULL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "empty file pointer");
+
+    /* The flush thread may be swapping the pending list out */
+    if (file->flush.enabled)
+        hg_thread_mutex_lock(&file->flush.mutex);
+
+    if (file->req_cnt == file->req_alloc) {
+        alloc = file->req_alloc > 0 ? 2 * file->req_alloc : 64;
+        if (NULL == (xfers = (H5VL_pdc_xfer_t *)realloc(file->xfers, alloc * sizeof(H5VL_pdc_xfer_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate request list");
+        file->xfers     = xfers;
+        file->req_alloc = alloc;
+    }
+
+    file->xfers[file->req_cnt] = *xfer;
+    file->req_cnt++;
+    file->stats.nreq++;
+
+    /* Only buffers owned by the connector count against the write cache */
+    if (xfer->buf.cached) {
+        file->cache.cur_size += xfer->buf.size;
+        file->stats.bytes_in += xfer->buf.size;
+    }
+
+done:
+    if (file && file->flush.enabled) {
+        if (!FUNC_ERRORED)
+            hg_thread_cond_signal(&file->flush.queued);
+        hg_thread_mutex_unlock(&file->flush.mutex);
+    }
+    FUNC_LEAVE_VOL
+}
+
+/*---------------------------------------------------------------------------*/
+/* Write one block of a selection. xfer->buf.buf points at its data when the
+ * block is contiguous in the user buffer and is NULL otherwise, in which case
+ * the block is gathered from the user buffer, and converted when conv is set,
+ * while it is staged. Blocks larger than a chunk are streamed, the others are
+ * deferred in the write cache, or written through when they can never fit in
+ * it. */
+static herr_t
+H5VL__pdc_write_block(H5VL_pdc_obj_t *file, H5VL_pdc_xfer_t *xfer, H5VL_pdc_memmap_t *map,
+                      const H5VL_pdc_block_t *blk, size_t elem, const H5VL_pdc_conv_t *conv)
+{
+    H5VL_pdc_xfer_t piece;
+    uint64_t        npiece, ntail, step, nxfer, p;
+    size_t          size = xfer->buf.size, off;
+    void *          stage = NULL;
+    const void *    src;
+    hbool_t         staged = FALSE;
+    int             dim, d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    npiece = H5VL__pdc_chunk_plan(xfer, elem, file->chunk.size, &dim, &step);
+    if (xfer->buf.mode == H5VL_PDC_BUF_COPY && npiece > 1) {
+        // Larger than a chunk: write all but the last window of chunks from the user buffer,
+        // then stage and defer the rest so that H5Dwrite returns while they are in flight
+        if (H5VL__pdc_file_drain_overlap(file, xfer, 1) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete overlapping write requests");
+
+        if ((src = xfer->buf.buf) == NULL) {
+            if (NULL == (stage = H5VL__pdc_pool_alloc(size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+            H5VL__pdc_memmap_copy(map, blk, elem, stage, NULL, conv, FALSE);
+            src = stage;
+        }
+
+        ntail = npiece < file->chunk.window ? npiece : file->chunk.window;
+        nxfer = 0;
+        if (H5VL__pdc_xfer_stream(&file->chunk, xfer->obj_id, PDC_WRITE, xfer, (void *)src, elem, 0,
+                                  npiece - ntail, FALSE, &nxfer) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write dataset");
+
+        for (p = npiece - ntail; p < npiece; p++) {
+            off            = H5VL__pdc_chunk_piece(xfer, elem, dim, step, p, &piece);
+            piece.buf.size = elem;
+            for (d = 0; d < xfer->ndim; d++)
+                piece.buf.size *= piece.count[d];
+
+            if (H5VL__pdc_cache_reserve(file, piece.buf.size) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't flush write cache");
+            if (NULL == (piece.buf.buf = H5VL__pdc_pool_alloc(piece.buf.size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate write cache buffer");
+            H5VL__pdc_copy(piece.buf.buf, (const char *)src + off, piece.buf.size);
+            piece.buf.cached = TRUE;
+
+            if (_add_xfer_request(file, &piece) < 0) {
+                H5VL__pdc_pool_free(piece.buf.buf, piece.buf.size);
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't add transfer request");
+            }
+        }
+
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nxfer += nxfer;
+        file->stats.nchunked++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
+    }
+    else if (xfer->buf.mode != H5VL_PDC_BUF_STABLE && size > file->cache.max_size) {
+        // Request can never fit in the write cache, write it through along with the
+        // existing transfer requests
+        if (xfer->buf.buf == NULL) {
+            if (NULL == (xfer->buf.buf = H5VL__pdc_pool_alloc(size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+            H5VL__pdc_memmap_copy(map, blk, elem, xfer->buf.buf, NULL, conv, FALSE);
+            staged = TRUE;
+        }
+        else if (xfer->buf.mode == H5VL_PDC_BUF_COPY) {
+            xfer->buf.mode       = H5VL_PDC_BUF_STABLE;
+            xfer->buf.release_cb = NULL;
+        }
+        if (_add_xfer_request(file, xfer) < 0) {
+            if (staged)
+                H5VL__pdc_pool_free(xfer->buf.buf, size);
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't add transfer request");
+        }
+
+        if (H5VL__pdc_file_drain(file, 0) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete write requests");
+    }
+    else if (xfer->buf.mode == H5VL_PDC_BUF_STABLE) {
+        // The user keeps the buffer unchanged until the next flush point
+        if (_add_xfer_request(file, xfer) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't add transfer request");
+    }
+    else {
+        // Above the high watermark, drain the oldest requests down to the low watermark
+        if (H5VL__pdc_cache_reserve(file, size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't flush write cache");
+
+        // Cache the user buffer, unless the connector was given ownership of it
+        if (xfer->buf.mode == H5VL_PDC_BUF_COPY) {
+            src = xfer->buf.buf;
+            if (NULL == (xfer->buf.buf = H5VL__pdc_pool_alloc(size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate write cache buffer");
+            if (src)
+                H5VL__pdc_copy(xfer->buf.buf, src, size);
+            else
+                H5VL__pdc_memmap_copy(map, blk, elem, xfer->buf.buf, NULL, conv, FALSE);
+        }
+        xfer->buf.cached = TRUE;
+
+        if (_add_xfer_request(file, xfer) < 0) {
+            if (xfer->buf.mode == H5VL_PDC_BUF_COPY)
+                H5VL__pdc_pool_free(xfer->buf.buf, size);
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't add transfer request");
+        }
+    }
+
+done:
+    if (stage)
+        H5VL__pdc_pool_free(stage, size);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_write_block() */
+
+/*---------------------------------------------------------------------------*/
+/* PDC type of the object holding a member of a columnar compound dataset.
+ * Numeric members are stored with the PDC type of their size, the others as
+ * bytes; scale is set to the number of object elements per member. */
+static pdc_var_type_t
+H5VL__pdc_member_type(hid_t type_id, size_t *scale)
+{
+    pdc_var_type_t pdc_type = H5VL__pdc_type_to_pdc(type_id);
+    size_t         size     = H5Tget_size(type_id);
+
+    if (pdc_type != PDC_UNKNOWN && PDC_get_var_type_size(pdc_type) == size) {
+        *scale = 1;
+        return pdc_type;
+    }
+
+    *scale = size;
+    return PDC_CHAR;
+} /* end H5VL__pdc_member_type() */
+
+/*---------------------------------------------------------------------------*/
+/* Create one PDC object per member of a compound dataset, named after the
+ * object of the dataset, and record their number in a tag of that object */
+static herr_t
+H5VL__pdc_columnar_create(H5VL_pdc_obj_t *o, H5VL_pdc_obj_t *dset)
+{
+    hsize_t        dims[H5S_MAX_RANK];
+    uint64_t       mdims[H5S_MAX_RANK];
+    char           name[ADDR_MAX + 16];
+    hid_t          mtype_id;
+    pdcid_t        obj_prop;
+    pdc_var_type_t pdc_type;
+    size_t         scale;
+    int            ndim, nmembers, m, d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if ((nmembers = H5Tget_nmembers(dset->type_id)) <= 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't get number of compound members");
+    if ((ndim = H5Sget_simple_extent_dims(dset->space_id, dims, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get dimensions");
+    if (NULL == (dset->member_ids = (pdcid_t *)calloc(nmembers, sizeof(pdcid_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member objects");
+    dset->nmembers = nmembers;
+
+    for (m = 0; m < nmembers; m++) {
+        if ((mtype_id = H5Tget_member_type(dset->type_id, (unsigned)m)) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't get compound member type");
+        pdc_type = H5VL__pdc_member_type(mtype_id, &scale);
+        H5Tclose(mtype_id);
+
+        // Members stored as bytes take scale bytes per element along the last dimension
+        for (d = 0; d < ndim; d++)
+            mdims[d] = dims[d];
+        if (ndim > 0)
+            mdims[ndim - 1] *= scale;
+        snprintf(name, sizeof(name), "%s#%d", dset->obj_name, m);
+
+        H5VL_PDC_LOCK();
+        obj_prop = PDCprop_create(PDC_OBJ_CREATE, pdc_id_g);
+        PDCprop_set_obj_type(obj_prop, pdc_type);
+        PDCprop_set_obj_dims(obj_prop, ndim, mdims);
+        if (o->comm != MPI_COMM_NULL)
+            dset->member_ids[m] = PDCobj_create_mpi(o->cont_id, name, obj_prop, 0, o->comm);
+        else
+            dset->member_ids[m] = PDCobj_create(o->cont_id, name, obj_prop);
+        PDCprop_close(obj_prop);
+        H5VL_PDC_UNLOCK();
+        if (dset->member_ids[m] <= 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create member object");
+    }
+
+    H5VL_PDC_LOCK();
+    if (PDCobj_put_tag(dset->obj_id, H5VL_PDC_COLUMNAR_TAG, &nmembers, PDC_INT, sizeof(int)) < 0) {
+        H5VL_PDC_UNLOCK();
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't tag columnar dataset");
+    }
+    H5VL_PDC_UNLOCK();
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_columnar_create() */
+
+/*---------------------------------------------------------------------------*/
+/* Open the member objects of a dataset created columnar; datasets without the
+ * columnar tag are left as they are */
+static herr_t
+H5VL__pdc_columnar_open(H5VL_pdc_obj_t *dset)
+{
+    char           name[ADDR_MAX + 16];
+    void *         value      = NULL;
+    psize_t        value_size = 0;
+    pdc_var_type_t value_type;
+    int            nmembers, m;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5VL__pdc_tag_get(dset->file_obj_ptr, dset->file_obj_ptr->coll_world, dset->obj_id, 0,
+                          H5VL_PDC_COLUMNAR_TAG, &value, &value_type, &value_size) < 0)
+        value_size = 0;
+    if (value == NULL || value_size != sizeof(int))
+        HGOTO_DONE(SUCCEED);
+    nmembers = *(int *)value;
+    if (nmembers <= 0)
+        HGOTO_DONE(SUCCEED);
+
+    if (NULL == (dset->member_ids = (pdcid_t *)calloc(nmembers, sizeof(pdcid_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member objects");
+    dset->nmembers = nmembers;
+
+    for (m = 0; m < nmembers; m++) {
+        snprintf(name, sizeof(name), "%s#%d", dset->obj_name, m);
+        if ((dset->member_ids[m] = H5VL__pdc_obj_open(dset->file_obj_ptr, name)) <= 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENOBJ, FAIL, "can't open member object");
+    }
+
+done:
+    free(value);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_columnar_open() */
 
 /*---------------------------------------------------------------------------*/
-herr_t
-_add_xfer_request(H5VL_pdc_obj_t *file, pdcid_t transfer_request, void *buf)
+/* Match the members of a columnar dataset with the members of a compound
+ * memory datatype by name. Members missing from the memory datatype are not
+ * transferred, as HDF5 does for compound conversions. */
+static herr_t
+H5VL__pdc_columnar_members(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hbool_t to_mem,
+                           H5VL_pdc_member_t **members, int *nmembers)
 {
-    if (file == NULL) {
-        fprintf(stderr, "Rank %d: error with %s, empty file ptr\n", my_rank_g, __func__);
-        return FAIL;
+    H5VL_pdc_member_t *list     = NULL, *mb;
+    hid_t              ftype_id = H5I_INVALID_HID, mtype_id = H5I_INVALID_HID;
+    char *             name;
+    int                idx, m, n = 0;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (H5Tget_class(mem_type_id) != H5T_COMPOUND)
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "vol-pdc does not support datatype conversion");
+    if (NULL == (list = (H5VL_pdc_member_t *)calloc(dset->nmembers, sizeof(H5VL_pdc_member_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate compound members");
+
+    for (m = 0; m < dset->nmembers; m++) {
+        if (NULL == (name = H5Tget_member_name(dset->type_id, (unsigned)m)))
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't get compound member name");
+        idx = H5Tget_member_index(mem_type_id, name);
+        H5free_memory(name);
+        if (idx < 0)
+            continue;
+
+        if ((ftype_id = H5Tget_member_type(dset->type_id, (unsigned)m)) < 0 ||
+            (mtype_id = H5Tget_member_type(mem_type_id, (unsigned)idx)) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't get compound member type");
+
+        mb            = &list[n++];
+        mb->idx       = m;
+        mb->mem_off   = H5Tget_member_offset(mem_type_id, (unsigned)idx);
+        mb->mem_size  = H5Tget_size(mtype_id);
+        mb->file_size = H5Tget_size(ftype_id);
+        H5VL__pdc_member_type(ftype_id, &mb->scale);
+
+        // Numeric members are converted, the others are copied as they are
+        if (!(to_mem ? H5VL__pdc_conv_init(ftype_id, mtype_id, &mb->conv)
+                     : H5VL__pdc_conv_init(mtype_id, ftype_id, &mb->conv)) &&
+            (mb->mem_size != mb->file_size || H5Tget_class(mtype_id) != H5Tget_class(ftype_id)))
+            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "vol-pdc does not support datatype conversion");
+
+        H5Tclose(ftype_id);
+        H5Tclose(mtype_id);
+        ftype_id = mtype_id = H5I_INVALID_HID;
     }
 
-    if (file->req_alloc == 0) {
-        file->req_alloc     = 64;
-        file->req_cnt       = 0;
-        file->xfer_requests = (pdcid_t *)calloc(file->req_alloc, sizeof(pdcid_t));
-        file->bufs          = (void **)calloc(file->req_alloc, sizeof(void *));
+    *members  = list;
+    *nmembers = n;
+    list      = NULL;
+
+done:
+    if (ftype_id >= 0)
+        H5Tclose(ftype_id);
+    if (mtype_id >= 0)
+        H5Tclose(mtype_id);
+    free(list);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_columnar_members() */
+
+/*---------------------------------------------------------------------------*/
+/* Write a selection of a columnar compound dataset: every block is split into
+ * one column per member, each written to the object of its member. Blocks
+ * contiguous in the user buffer are split straight from it, the others are
+ * gathered first. */
+static herr_t
+H5VL__pdc_columnar_write(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hid_t mem_space_id, hid_t file_space_id,
+                         const void *buf)
+{
+    H5VL_pdc_obj_t *   file    = dset->file_obj_ptr;
+    H5VL_pdc_member_t *members = NULL;
+    H5VL_pdc_block_t * blocks  = NULL, blk;
+    H5VL_pdc_memmap_t  map;
+    H5VL_pdc_xfer_t    xfer;
+    void **            cols  = NULL;
+    void *             stage = NULL;
+    const void *       src;
+    uint64_t *         perm     = NULL;
+    uint64_t           nelem    = 0;
+    size_t             nblocks  = 0, elem, b;
+    int                nmembers = 0, m, d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    memset(&map, 0, sizeof(map));
+    if (H5VL__pdc_columnar_members(dset, mem_type_id, FALSE, &members, &nmembers) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't match compound members");
+    if (nmembers == 0)
+        HGOTO_DONE(SUCCEED);
+    if (NULL == (cols = (void **)calloc(nmembers, sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member columns");
+
+    if (H5VL__pdc_sel_blocks(file_space_id, &blocks, &nblocks, &perm) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't translate file selection");
+    elem = H5Tget_size(mem_type_id);
+    if (H5VL__pdc_memmap_build(mem_space_id, (void *)buf, elem, perm, &map) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't map memory selection");
+
+    for (b = 0; b < nblocks; b++) {
+        for (d = 0, nelem = 1; d < blocks[b].ndim; d++)
+            nelem *= blocks[b].count[d];
+
+        if (!H5VL__pdc_block_dense(&blocks[b]) ||
+            NULL == (src = H5VL__pdc_memmap_addr(&map, blocks[b].base * elem, nelem * elem))) {
+            if (NULL == (stage = H5VL__pdc_pool_alloc(nelem * elem)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+            H5VL__pdc_memmap_copy(&map, &blocks[b], elem, stage, NULL, NULL, FALSE);
+            src = stage;
+        }
+
+        for (m = 0; m < nmembers; m++)
+            if (NULL == (cols[m] = malloc(nelem * members[m].file_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member column");
+        H5VL__pdc_columns_split(members, nmembers, cols, src, nelem, elem);
+        if (stage) {
+            H5VL__pdc_pool_free(stage, nelem * elem);
+            stage = NULL;
+        }
+
+        // The columns are handed over to the write cache, which frees them once written
+        for (m = 0; m < nmembers; m++) {
+            blk = blocks[b];
+            H5VL__pdc_block_scale(&blk, 1, members[m].scale);
+            memset(&xfer, 0, sizeof(xfer));
+            xfer.obj_id = dset->member_ids[members[m].idx];
+            xfer.ndim   = blk.ndim;
+            memcpy(xfer.offset, blk.offset, sizeof(xfer.offset));
+            memcpy(xfer.count, blk.count, sizeof(xfer.count));
+            xfer.buf.buf  = cols[m];
+            xfer.buf.size = nelem * members[m].file_size;
+            xfer.buf.mode = H5VL_PDC_BUF_TRANSFER;
+            cols[m]       = NULL;
+            if (H5VL__pdc_write_block(file, &xfer, NULL, &blk, members[m].file_size / members[m].scale,
+                                      NULL) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write compound member");
+        }
     }
 
-    if (file->req_cnt > file->req_alloc - 2) {
-        file->req_alloc *= 2;
-        file->xfer_requests = (pdcid_t *)realloc(file->xfer_requests, file->req_alloc * sizeof(pdcid_t));
-        file->bufs          = (void **)realloc(file->bufs, file->req_alloc * sizeof(void *));
+done:
+    for (m = 0; cols && m < nmembers; m++)
+        free(cols[m]);
+    if (stage)
+        H5VL__pdc_pool_free(stage, nelem * elem);
+    H5VL__pdc_memmap_free(&map);
+    free(perm);
+    free(blocks);
+    free(cols);
+    free(members);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_columnar_write() */
+
+/*---------------------------------------------------------------------------*/
+/* Read a selection of a columnar compound dataset: only the objects of the
+ * members of the memory datatype are read, and their columns are merged into
+ * the user buffer, in place when a block is contiguous in it. */
+static herr_t
+H5VL__pdc_columnar_read(H5VL_pdc_obj_t *dset, hid_t mem_type_id, hid_t mem_space_id, hid_t file_space_id,
+                        void *buf)
+{
+    H5VL_pdc_obj_t *   file    = dset->file_obj_ptr;
+    H5VL_pdc_member_t *members = NULL;
+    H5VL_pdc_block_t * blocks  = NULL, blk;
+    H5VL_pdc_memmap_t  map;
+    H5VL_pdc_xfer_t    xfer;
+    void **            cols     = NULL;
+    void *             stage    = NULL, *dst;
+    uint64_t *         perm     = NULL;
+    uint64_t           nelem    = 0;
+    size_t             nblocks  = 0, elem, covered = 0, b;
+    int                nmembers = 0, m, d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    memset(&map, 0, sizeof(map));
+    if (H5VL__pdc_columnar_members(dset, mem_type_id, TRUE, &members, &nmembers) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't match compound members");
+    if (nmembers == 0)
+        HGOTO_DONE(SUCCEED);
+    if (NULL == (cols = (void **)calloc(nmembers, sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member columns");
+    for (m = 0; m < nmembers; m++)
+        covered += members[m].mem_size;
+
+    if (H5VL__pdc_sel_blocks(file_space_id, &blocks, &nblocks, &perm) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't translate file selection");
+    elem = H5Tget_size(mem_type_id);
+    if (H5VL__pdc_memmap_build(mem_space_id, buf, elem, perm, &map) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't map memory selection");
+
+    // The member objects hold no cached regions, so the deferred writes to them are completed
+    if (file->consistency != H5VL_PDC_CONSISTENCY_OVERLAP) {
+        if (H5VL__pdc_file_drain(file, 0) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete deferred write requests");
     }
+    else
+        for (b = 0; b < nblocks; b++)
+            for (m = 0; m < nmembers; m++) {
+                blk = blocks[b];
+                H5VL__pdc_block_scale(&blk, 1, members[m].scale);
+                memset(&xfer, 0, sizeof(xfer));
+                xfer.obj_id = dset->member_ids[members[m].idx];
+                xfer.ndim   = blk.ndim;
+                memcpy(xfer.offset, blk.offset, sizeof(xfer.offset));
+                memcpy(xfer.count, blk.count, sizeof(xfer.count));
+                if (H5VL__pdc_file_drain_overlap(file, &xfer, 1) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL,
+                                "can't complete overlapping write requests");
+            }
 
-    file->xfer_requests[file->req_cnt + 1] = transfer_request;
-    file->bufs[file->req_cnt + 1]          = buf;
-    file->req_cnt++;
+    for (b = 0; b < nblocks; b++) {
+        for (d = 0, nelem = 1; d < blocks[b].ndim; d++)
+            nelem *= blocks[b].count[d];
+
+        for (m = 0; m < nmembers; m++) {
+            blk = blocks[b];
+            H5VL__pdc_block_scale(&blk, 1, members[m].scale);
+            memset(&xfer, 0, sizeof(xfer));
+            xfer.obj_id = dset->member_ids[members[m].idx];
+            xfer.ndim   = blk.ndim;
+            memcpy(xfer.offset, blk.offset, sizeof(xfer.offset));
+            memcpy(xfer.count, blk.count, sizeof(xfer.count));
+            if (NULL == (cols[m] = malloc(nelem * members[m].file_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate member column");
+            if (H5VL__pdc_read_box(file, xfer.obj_id, &xfer, members[m].file_size / members[m].scale,
+                                   cols[m]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read compound member");
+        }
 
-    return SUCCEED;
-}
+        // Blocks scattered in the user buffer are merged into a staging buffer, which starts from
+        // the user buffer when the members read leave bytes of the elements untouched
+        if (!H5VL__pdc_block_dense(&blocks[b]) ||
+            NULL == (dst = H5VL__pdc_memmap_addr(&map, blocks[b].base * elem, nelem * elem))) {
+            if (NULL == (stage = H5VL__pdc_pool_alloc(nelem * elem)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+            if (covered < elem)
+                H5VL__pdc_memmap_copy(&map, &blocks[b], elem, stage, NULL, NULL, FALSE);
+            dst = stage;
+        }
+        H5VL__pdc_columns_merge(members, nmembers, cols, dst, nelem, elem);
+        if (stage) {
+            H5VL__pdc_memmap_copy(&map, &blocks[b], elem, stage, NULL, NULL, TRUE);
+            H5VL__pdc_pool_free(stage, nelem * elem);
+            stage = NULL;
+        }
+
+        for (m = 0; m < nmembers; m++) {
+            free(cols[m]);
+            cols[m] = NULL;
+        }
+    }
+
+done:
+    for (m = 0; cols && m < nmembers; m++)
+        free(cols[m]);
+    if (stage)
+        H5VL__pdc_pool_free(stage, nelem * elem);
+    H5VL__pdc_memmap_free(&map);
+    free(perm);
+    free(blocks);
+    free(cols);
+    free(members);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_columnar_read() */
 
 /*---------------------------------------------------------------------------*/
 herr_t
 H5VL_pdc_dataset_write(size_t count, void *_dset[], hid_t mem_type_id[], hid_t mem_space_id[],
-                       hid_t file_space_id[], hid_t plist_id __attribute__((unused)), const void *buf[],
+                       hid_t file_space_id[], hid_t plist_id, const void *buf[],
                        void **req __attribute__((unused)))
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    H5VL_pdc_obj_t *dset, *file;
-    uint64_t        offset[H5S_MAX_RANK] = {0}, total_size = 0;
-    size_t          type_size;
-    int             ndim;
-    pdcid_t         region_local, region_remote;
-    hsize_t         dims[H5S_MAX_RANK] = {0};
-    perr_t          ret;
-    pdcid_t         transfer_request;
-    H5T_class_t     h5_dclass;
-    void *          cache_buf = NULL;
+    H5VL_pdc_obj_t *    dset, *file;
+    H5VL_pdc_block_t *  blocks = NULL, *pieces = NULL;
+    H5VL_pdc_memmap_t   map;
+    H5VL_pdc_conv_t     conv, *cv;
+    size_t              nblocks = 0, npieces = 0, elem, stage_size = 0, b, p;
+    uint64_t *          perm = NULL;
+    hssize_t            npoints;
+    void *              stage = NULL;
+    H5T_class_t         h5_dclass;
+    H5VL_pdc_buf_conf_t buf_conf, conf;
+    H5VL_pdc_buf_t      user;
+    H5VL_pdc_xfer_t     xfer, piece, *split = NULL;
+    uint64_t            step;
+    hbool_t             agg, agg_done;
+    size_t              agg_next = 0; /* First dataset whose aggregated exchange the rank has not joined */
+    int                 d, dim, nsplit = 0;
 
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
+    memset(&map, 0, sizeof(map));
+    if (H5VL__pdc_buf_conf_get(plist_id, &buf_conf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get write buffer mode");
+
     for (size_t u = 0; u < count; u++) {
         dset = (H5VL_pdc_obj_t *)_dset[u];
         file = dset->file_obj_ptr;
 
+        // The object of a dataset whose create was deferred is made on its own, writes are independent
+        if (dset->create && H5VL__pdc_create_one(file, dset->create) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create deferred dataset");
+
 #ifdef ENABLE_LOGGING
         fprintf(stderr, "Rank %d: writing [%s][%s][%s]\n", my_rank_g, dset->file_name, dset->group_name,
                 dset->obj_name);
@@ -1622,93 +6849,212 @@ H5VL_pdc_dataset_write(size_t count, void *_dset[], hid_t mem_type_id[], hid_t m
         if (mem_space_id[u] == H5S_ALL)
             mem_space_id[u] = file_space_id[u];
 
+        // Blocks read ahead or cached from this dataset would miss the write
+        H5VL__pdc_prefetch_drop(file, dset->obj_name);
+        H5VL__pdc_rcache_drop(file, dset->obj_name);
+
+        // The members of a columnar dataset are written to their own objects, always from copies
+        if (dset->member_ids) {
+            if (H5Sget_select_npoints(mem_space_id[u]) != H5Sget_select_npoints(file_space_id[u]))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "memory and file selections differ in size");
+            if (H5VL__pdc_columnar_write(dset, mem_type_id[u], mem_space_id[u], file_space_id[u], buf[u]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write columnar dataset");
+            if (buf_conf.mode != H5VL_PDC_BUF_COPY) {
+                memset(&user, 0, sizeof(user));
+                user.buf         = (void *)buf[u];
+                user.mode        = buf_conf.mode;
+                user.release_cb  = buf_conf.release_cb;
+                user.release_ctx = buf_conf.release_ctx;
+                H5VL__pdc_buf_release(&user);
+            }
+            continue;
+        }
+
+        // Numeric elements are converted to the datatype of the dataset while they are staged
         h5_dclass = H5Tget_class(mem_type_id[u]);
-        if (_check_mem_type_id(h5_dclass, dset->pdc_type) == 0)
+        cv        = H5VL__pdc_conv_init(mem_type_id[u], dset->type_id, &conv) ? &conv : NULL;
+        if (cv == NULL && _check_mem_type_id(mem_type_id[u], dset) == 0)
             HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "vol-pdc does not support datatype conversion");
 
-        /* Get memory dataspace object */
-        if ((ndim = H5Sget_simple_extent_ndims(mem_space_id[u])) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of dimensions");
-        if (ndim != H5Sget_simple_extent_dims(mem_space_id[u], dims, NULL))
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get dimensions");
+        if ((npoints = H5Sget_select_npoints(file_space_id[u])) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't get number of selected elements");
+        if (H5Sget_select_npoints(mem_space_id[u]) != npoints)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "memory and file selections differ in size");
 
-        if (ndim > 4)
-            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "data dimension not supported");
+        // Break the file selection into the regions of the object it covers
+        if (H5VL__pdc_sel_blocks(file_space_id[u], &blocks, &nblocks, &perm) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't translate file selection");
 
-        total_size = 1;
-        for (int i = 0; i < ndim; i++)
-            total_size *= dims[i];
+        // Locate the selected elements in the user buffer, in the order of the file selection
+        elem = H5Tget_size(mem_type_id[u]);
+        if (H5VL__pdc_memmap_build(mem_space_id[u], (void *)buf[u], elem, perm, &map) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't map memory selection");
+        free(perm);
+        perm = NULL;
+        if (cv)
+            elem = cv->dst_size;
 
         // TODO: temporary workaround for writing compound data, as current PDC doesn't support
         //       compound datatype
-        type_size = H5Tget_size(mem_type_id[u]);
-        if (H5Tget_class(mem_type_id[u]) == H5T_COMPOUND)
-            dims[ndim - 1] *= type_size;
-
-        total_size *= type_size;
-
-        /* printf("Rank %d: mem offset %lu\n", dset->my_rank, offset[0]); */
-        /* printf("Rank %d: mem count  %lu\n", dset->my_rank, dims[0]); */
-        region_local      = PDCregion_create(ndim, offset, dims);
-        dset->reg_id_from = region_local;
-
-        /* H5VL__pdc_sel_to_recx_iov(file_space_id[u], type_size, offset); */
-        H5VL__pdc_sel_to_recx_iov(file_space_id[u], 1, offset);
-
-#ifdef ENABLE_LOGGING
-        printf("Rank %d: file offset0 %lu, count0 %lu\n", my_rank_g, offset[0], dims[0]);
-        if (ndim > 1)
-            printf("Rank %d: file offset1 %lu, count1 %lu\n", my_rank_g, offset[1], dims[1]);
-#endif
-        region_remote   = PDCregion_create(ndim, offset, dims);
-        dset->reg_id_to = region_remote;
-
-        if (file->req_alloc == 0) {
-            file->req_alloc     = 64;
-            file->req_cnt       = 0;
-            file->xfer_requests = (pdcid_t *)calloc(file->req_alloc, sizeof(pdcid_t));
-            file->bufs          = (void **)calloc(file->req_alloc, sizeof(void *));
+        if (h5_dclass == H5T_COMPOUND) {
+            H5VL__pdc_block_scale(blocks, nblocks, elem);
+            elem = 1;
         }
 
-        if (write_cache_size_g + total_size > MAX_WRITE_CACHE_SIZE_GB * 1073741824llu) {
-            // Reaching max cache size, finish existing transfer requests and the current one
-            transfer_request = PDCregion_transfer_create((void *)buf[u], PDC_WRITE, dset->obj_id,
-                                                         region_local, region_remote);
-
-            _add_xfer_request(file, transfer_request, NULL);
-
-            ret = PDCregion_transfer_start_all(file->xfer_requests, file->req_cnt);
-            if (ret != SUCCEED)
-                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer start");
+        // The user buffer is only transferred in place when it holds a single block as is,
+        // otherwise it is copied and handed back once the write returns
+        conf = buf_conf;
+        if (conf.mode != H5VL_PDC_BUF_COPY &&
+            (cv || nblocks != 1 || !H5VL__pdc_block_dense(&blocks[0]) ||
+             H5VL__pdc_memmap_addr(&map, 0, (uint64_t)npoints * H5Tget_size(mem_type_id[u])) != buf[u]))
+            conf.mode = H5VL_PDC_BUF_COPY;
+
+        // Collective writes of small blocks are gathered by aggregator ranks and written by them;
+        // every rank takes part once per dataset, as told by the transfer property list and the
+        // file alone, ranks with several blocks or that hand their buffer over write them themselves
+        if (H5VL__pdc_agg_enabled(file, plist_id, &agg) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get aggregation mode");
+        agg_done = FALSE;
+        if (agg) {
+            memset(&xfer, 0, sizeof(xfer));
+            xfer.obj_id = dset->obj_id;
+            if (nblocks == 1 && conf.mode == H5VL_PDC_BUF_COPY) {
+                xfer.ndim = blocks[0].ndim;
+                memcpy(xfer.offset, blocks[0].offset, sizeof(xfer.offset));
+                memcpy(xfer.count, blocks[0].count, sizeof(xfer.count));
+                xfer.buf.size = elem;
+                for (d = 0; d < xfer.ndim; d++)
+                    xfer.buf.size *= xfer.count[d];
+
+                // A block scattered in the user buffer, or converted, is packed for its aggregator
+                if (cv || !H5VL__pdc_block_dense(&blocks[0]) ||
+                    NULL ==
+                        (xfer.buf.buf = H5VL__pdc_memmap_addr(&map, blocks[0].base * elem, xfer.buf.size))) {
+                    if (NULL == (stage = H5VL__pdc_pool_alloc(xfer.buf.size)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+                    stage_size = xfer.buf.size;
+                    H5VL__pdc_memmap_copy(&map, &blocks[0], elem, stage, NULL, cv, FALSE);
+                    xfer.buf.buf = stage;
+                }
+            }
+            // A failed exchange fails on every rank, none of them is left waiting in the next one
+            agg_next = count;
+            if (H5VL__pdc_agg_write(file, &xfer, FALSE, &agg_done) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write aggregated blocks");
+            agg_next = u + 1;
+            if (stage) {
+                H5VL__pdc_pool_free(stage, stage_size);
+                stage = NULL;
+            }
+        }
 
-            ret = PDCregion_transfer_wait_all(file->xfer_requests, file->req_cnt);
-            if (ret != SUCCEED)
-                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer wait");
+        for (b = 0; b < nblocks && !agg_done; b++) {
+            /* The regions and the transfer are created once the request is started, so that
+             * neighbouring requests can be merged first */
+            memset(&xfer, 0, sizeof(xfer));
+            xfer.obj_id   = dset->obj_id;
+            xfer.ndim     = blocks[b].ndim;
+            xfer.buf.size = elem;
+            for (d = 0; d < xfer.ndim; d++) {
+                xfer.offset[d] = blocks[b].offset[d];
+                xfer.count[d]  = blocks[b].count[d];
+                xfer.buf.size *= blocks[b].count[d];
+            }
 
-            for (int i = 0; i < file->req_cnt; i++) {
-                ret = PDCregion_transfer_close(file->xfer_requests[i]);
-                if (ret != SUCCEED)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "Failed to region transfer close");
-                file->xfer_requests[i] = 0;
+            /* Buffers handed over by the user are transferred in place and released once done */
+            if (cv == NULL && H5VL__pdc_block_dense(&blocks[b]))
+                xfer.buf.buf = H5VL__pdc_memmap_addr(&map, blocks[b].base * elem, xfer.buf.size);
+            xfer.buf.mode        = conf.mode;
+            xfer.buf.release_cb  = conf.release_cb;
+            xfer.buf.release_ctx = conf.release_ctx;
+
+            /* A block scattered in the user buffer that bypasses the write cache would be staged
+             * only to be sent, it is rather written in place as the pieces contiguous in it,
+             * unless its elements are converted */
+            if (xfer.buf.buf == NULL && cv == NULL &&
+                (xfer.buf.size > file->cache.max_size ||
+                 H5VL__pdc_chunk_plan(&xfer, elem, file->chunk.size, &dim, &step) > 1) &&
+                H5VL__pdc_block_split(&map, &blocks[b], elem, H5VL__pdc_slab_min(), &pieces, &npieces) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't split block");
+
+            if (npieces == 0) {
+                if (H5VL__pdc_write_block(file, &xfer, &map, &blocks[b], elem, cv) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write dataset");
+                continue;
+            }
+            if (split == NULL && NULL == (split = (H5VL_pdc_xfer_t *)malloc(nblocks * sizeof(xfer))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate split blocks");
+            split[nsplit++] = xfer;
+
+            for (p = 0; p < npieces; p++) {
+                memset(&piece, 0, sizeof(piece));
+                piece.obj_id   = dset->obj_id;
+                piece.ndim     = pieces[p].ndim;
+                piece.buf.size = elem;
+                for (d = 0; d < piece.ndim; d++) {
+                    piece.offset[d] = pieces[p].offset[d];
+                    piece.count[d]  = pieces[p].count[d];
+                    piece.buf.size *= pieces[p].count[d];
+                }
+                piece.buf.buf  = H5VL__pdc_memmap_addr(&map, pieces[p].base * elem, piece.buf.size);
+                piece.buf.mode = H5VL_PDC_BUF_STABLE;
+
+                if (H5VL__pdc_write_block(file, &piece, &map, &pieces[p], elem, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write dataset");
             }
-            file->req_cnt      = 0;
-            write_cache_size_g = 0;
+            free(pieces);
+            pieces  = NULL;
+            npieces = 0;
         }
-        else {
-            // Cache the user buffer
-            cache_buf = malloc(total_size);
-            memcpy(cache_buf, buf[u], total_size);
 
-            transfer_request =
-                PDCregion_transfer_create(cache_buf, PDC_WRITE, dset->obj_id, region_local, region_remote);
+        // The pieces point into the user buffer, complete them before H5Dwrite returns, together and
+        // leaving the other deferred writes alone
+        if (nsplit > 0) {
+            herr_t drained = H5VL__pdc_file_drain_overlap(file, split, nsplit);
 
-            _add_xfer_request(file, transfer_request, cache_buf);
+            nsplit = 0;
+            if (drained < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete write requests");
         }
+        free(split);
+        split = NULL;
 
         // Defer xfer wait to the next read operation and file close time
+
+        if (conf.mode != buf_conf.mode) {
+            memset(&user, 0, sizeof(user));
+            user.buf         = (void *)buf[u];
+            user.mode        = buf_conf.mode;
+            user.release_cb  = buf_conf.release_cb;
+            user.release_ctx = buf_conf.release_ctx;
+            H5VL__pdc_buf_release(&user);
+        }
+        H5VL__pdc_memmap_free(&map);
+        free(blocks);
+        blocks = NULL;
     }
 
 done:
+    // Pieces already queued must not outlive the call either
+    if (nsplit > 0 && H5VL__pdc_file_drain_overlap(file, split, nsplit) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete write requests");
+
+    // The other ranks go on to the next aggregated exchange, join it with the failure so that it
+    // fails for them as well
+    for (size_t v = agg_next; FUNC_ERRORED && v < count; v++) {
+        dset = (H5VL_pdc_obj_t *)_dset[v];
+        if (dset->member_ids || H5VL__pdc_agg_enabled(dset->file_obj_ptr, plist_id, &agg) < 0 || !agg)
+            continue;
+        H5VL__pdc_agg_write(dset->file_obj_ptr, NULL, TRUE, &agg_done);
+        break;
+    }
+    if (stage)
+        H5VL__pdc_pool_free(stage, stage_size);
+    H5VL__pdc_memmap_free(&map);
+    free(perm);
+    free(pieces);
+    free(split);
+    free(blocks);
     FUNC_LEAVE_VOL
 } /* end H5VL_pdc_dataset_write() */
 
@@ -1722,94 +7068,370 @@ H5VL_pdc_dataset_read(size_t count, void *_dset[], hid_t mem_type_id[], hid_t me
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    H5VL_pdc_obj_t *dset, *file;
-    uint64_t        offset[H5S_MAX_RANK] = {0};
-    int             ndim, i;
-    pdcid_t         region_local, region_remote;
-    hsize_t         dims[H5S_MAX_RANK] = {0};
-    perr_t          ret;
-    pdcid_t         transfer_request;
-    H5T_class_t     h5_dclass;
+    H5VL_pdc_obj_t *   dset, *file;
+    uint64_t           zero[H5VL_PDC_MAX_RANK] = {0};
+    uint64_t           nelem, step, extra, *perm = NULL;
+    int                d, dim, i, j, k, nread = 0, nbatch = 0;
+    hid_t              fspace, mspace;
+    hssize_t           npoints;
+    H5VL_pdc_block_t **blocks = NULL, **sieved = NULL, sieve_box;
+    H5VL_pdc_memmap_t *maps   = NULL;
+    H5VL_pdc_conv_t *  convs  = NULL;
+    H5VL_pdc_xfer_t *  boxes = NULL, *missing = NULL, *reads = NULL;
+    size_t *           nblocks = NULL, *nsieved = NULL, *first = NULL, nunit = 0, elem;
+    int *              nmissing = NULL, *owner = NULL, *unit_dset = NULL;
+    void **            staged = NULL;
+    pdcid_t *          reqs = NULL, *regions = NULL, *batch = NULL;
+    htri_t             served;
+    void *             addr;
+    hbool_t            started = FALSE;
+    perr_t             ret     = SUCCEED;
 
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    // Complete existing write requests
-    dset = (H5VL_pdc_obj_t *)_dset[0];
-    file = dset->file_obj_ptr;
-    if (file->req_cnt > 0) {
-        ret = PDCregion_transfer_start_all(file->xfer_requests, file->req_cnt);
-        if (ret != SUCCEED)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer start");
+    if (NULL == (blocks = (H5VL_pdc_block_t **)calloc(count, sizeof(H5VL_pdc_block_t *))) ||
+        NULL == (nblocks = (size_t *)calloc(count, sizeof(size_t))) ||
+        NULL == (sieved = (H5VL_pdc_block_t **)calloc(count, sizeof(H5VL_pdc_block_t *))) ||
+        NULL == (nsieved = (size_t *)calloc(count, sizeof(size_t))) ||
+        NULL == (first = (size_t *)calloc(count, sizeof(size_t))) ||
+        NULL == (maps = (H5VL_pdc_memmap_t *)calloc(count, sizeof(H5VL_pdc_memmap_t))) ||
+        NULL == (convs = (H5VL_pdc_conv_t *)calloc(count, sizeof(H5VL_pdc_conv_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate read selections");
+
+    // Break each file selection into the regions of the object it covers; every block is read as
+    // a unit, in place when it is contiguous in the user buffer
+    for (size_t u = 0; u < count; u++) {
+        dset = (H5VL_pdc_obj_t *)_dset[u];
 
-        ret = PDCregion_transfer_wait_all(file->xfer_requests, file->req_cnt);
-        if (ret != SUCCEED) {
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer wait");
+        // The object of a dataset whose create was deferred is made on its own, reads are independent
+        if (dset->create && H5VL__pdc_create_one(dset->file_obj_ptr, dset->create) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create deferred dataset");
+
+        // The members of a columnar dataset are read from their own objects, outside of the batch
+        if (dset->member_ids) {
+            fspace = file_space_id[u] == H5S_ALL ? dset->space_id : file_space_id[u];
+            mspace = mem_space_id[u] == H5S_ALL ? fspace : mem_space_id[u];
+            if (H5Sget_select_npoints(mspace) != H5Sget_select_npoints(fspace))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "memory and file selections differ in size");
+            if (H5VL__pdc_columnar_read(dset, mem_type_id[u], mspace, fspace, buf[u]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read columnar dataset");
+            continue;
         }
-        for (i = 0; i < file->req_cnt; i++) {
-            ret = PDCregion_transfer_close(file->xfer_requests[i]);
-            if (ret != SUCCEED)
-                HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "Failed to region transfer close");
-            if (file->bufs[i] != NULL) {
-                free(file->bufs[i]);
-                file->bufs[i] = NULL;
-            }
+
+        // Numeric elements are converted from the datatype of the dataset once they are read
+        if (!H5VL__pdc_conv_init(dset->type_id, mem_type_id[u], &convs[u]) &&
+            _check_mem_type_id(mem_type_id[u], dset) == 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "vol-pdc does not support datatype conversion");
+
+        fspace = file_space_id[u] == H5S_ALL ? dset->space_id : file_space_id[u];
+        mspace = mem_space_id[u] == H5S_ALL ? fspace : mem_space_id[u];
+        if ((npoints = H5Sget_select_npoints(fspace)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't get number of selected elements");
+        if (H5Sget_select_npoints(mspace) != npoints)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "memory and file selections differ in size");
+
+        if (H5VL__pdc_sel_blocks(fspace, &blocks[u], &nblocks[u], &perm) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't translate file selection");
+
+        // Locate the selected elements in the user buffer, in the order of the file selection; the
+        // points of a point selection are read in the order of the file and scattered back through
+        // the memory runs
+        elem = H5Tget_size(mem_type_id[u]);
+        if (H5VL__pdc_memmap_build(mspace, buf[u], elem, perm, &maps[u]) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't map memory selection");
+        free(perm);
+        perm = NULL;
+        if (convs[u].src_size > 0)
+            elem = convs[u].src_size;
+
+        // TODO: temporary workaround for reading compound data, as current PDC doesn't support
+        //       compound datatype
+        if (dset->compound_size > 0) {
+            H5VL__pdc_block_scale(blocks[u], nblocks[u], dset->compound_size);
+            elem = 1;
+        }
+
+        // A sparse selection is read as its bounding box when that is cheaper than its regions, and
+        // its blocks are extracted from the box
+        if (H5VL__pdc_sieve_plan(blocks[u], nblocks[u], elem, &sieve_box)) {
+            sieved[u]  = blocks[u];
+            nsieved[u] = nblocks[u];
+            nblocks[u] = 1;
+            if (NULL == (blocks[u] = (H5VL_pdc_block_t *)malloc(sizeof(H5VL_pdc_block_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate bounding box");
+            blocks[u][0] = sieve_box;
         }
-        file->req_cnt = 0;
+
+        // Blocks scattered in the user buffer are read as the pieces contiguous in it when those are
+        // worth their transfers, and are staged otherwise; converted blocks are always staged
+        else if (convs[u].src_size == 0 &&
+                 H5VL__pdc_block_split_all(&maps[u], &blocks[u], &nblocks[u], elem) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't split file selection");
+        first[u] = nunit;
+        nunit += nblocks[u];
     }
 
+    if (nunit > 0 &&
+        (NULL == (boxes = (H5VL_pdc_xfer_t *)calloc(nunit, sizeof(H5VL_pdc_xfer_t))) ||
+         NULL ==
+             (missing = (H5VL_pdc_xfer_t *)malloc(nunit * H5VL_PDC_MAX_BOXES * sizeof(H5VL_pdc_xfer_t))) ||
+         NULL == (nmissing = (int *)calloc(nunit, sizeof(int))) ||
+         NULL == (unit_dset = (int *)malloc(nunit * sizeof(int))) ||
+         NULL == (staged = (void **)calloc(nunit, sizeof(void *)))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate read regions");
+
     for (size_t u = 0; u < count; u++) {
         dset = (H5VL_pdc_obj_t *)_dset[u];
+        elem = dset->compound_size > 0 ? 1 : H5Tget_size(mem_type_id[u]);
+        if (convs[u].src_size > 0)
+            elem = convs[u].src_size;
+
+        for (size_t b = 0; b < nblocks[u]; b++) {
+            const H5VL_pdc_block_t *blk = &blocks[u][b];
+            size_t                  n   = first[u] + b;
+
+            unit_dset[n]      = (int)u;
+            boxes[n].obj_id   = dset->obj_id;
+            boxes[n].ndim     = blk->ndim;
+            boxes[n].buf.size = elem;
+            for (d = 0, nelem = 1; d < blk->ndim; d++) {
+                boxes[n].offset[d] = blk->offset[d];
+                boxes[n].count[d]  = blk->count[d];
+                nelem *= blk->count[d];
+            }
 
-        h5_dclass = H5Tget_class(mem_type_id[u]);
-        if (_check_mem_type_id(h5_dclass, dset->pdc_type) == 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "vol-pdc does not support datatype conversion");
+            // Blocks contiguous in the user buffer are read in place, the others, bounding boxes and
+            // converted blocks are staged
+            if (sieved[u] == NULL && convs[u].src_size == 0 && H5VL__pdc_block_dense(blk) &&
+                NULL != (addr = H5VL__pdc_memmap_addr(&maps[u], blk->base * elem, nelem * elem)))
+                boxes[n].buf.buf = addr;
+            else if (NULL == (boxes[n].buf.buf = staged[n] = H5VL__pdc_pool_alloc(nelem * elem)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate staging buffer");
+
+            // A read predicted from the previous timestep is a local copy
+            if (nblocks[u] == 1) {
+                if ((served = H5VL__pdc_prefetch_take(dset->file_obj_ptr, dset, &boxes[n], elem,
+                                                      boxes[n].buf.buf)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read from read-ahead buffer");
+                if (served)
+                    continue;
+            }
 
-        /* Get memory dataspace object */
-        if (mem_space_id[u] == H5S_ALL) {
-            if ((ndim = H5Sget_simple_extent_ndims(dset->space_id)) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of dimensions");
-            if (ndim != H5Sget_simple_extent_dims(dset->space_id, dims, NULL))
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get dimensions");
-        }
-        else {
-            if ((ndim = H5Sget_simple_extent_ndims(mem_space_id[u])) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of dimensions");
-            if (ndim != H5Sget_simple_extent_dims(mem_space_id[u], dims, NULL))
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get dimensions");
+            // Serve what the read cache holds, otherwise what the deferred write requests still hold;
+            // the writes to a dataset drop its cached regions, so those never hide newer deferred data
+            nmissing[n] = -1;
+            if (dset->read_cache)
+                nmissing[n] =
+                    H5VL__pdc_rcache_lookup(dset, &boxes[n], elem, &missing[n * H5VL_PDC_MAX_BOXES]);
+            if (nmissing[n] < 0)
+                nmissing[n] = H5VL__pdc_cache_lookup(dset->file_obj_ptr, &boxes[n], elem,
+                                                     &missing[n * H5VL_PDC_MAX_BOXES]);
         }
+    }
 
-        // TODO: temporary workaround for reading compound data, as current PDC doesn't support
-        //       compound datatype
-        if (dset->compound_size > 0) {
-            dims[ndim - 1] *= dset->compound_size;
+    // Complete the deferred write requests the rest of the read depends on, once per file
+    for (size_t u = 0; u < count; u++) {
+        size_t v, n;
+        int    nbox = 0;
+
+        file = ((H5VL_pdc_obj_t *)_dset[u])->file_obj_ptr;
+        for (v = 0; v < u; v++)
+            if (((H5VL_pdc_obj_t *)_dset[v])->file_obj_ptr == file)
+                break;
+        if (v < u)
+            continue;
+
+        for (v = u; v < count; v++) {
+            if (((H5VL_pdc_obj_t *)_dset[v])->file_obj_ptr != file)
+                continue;
+            for (n = first[v]; n < first[v] + nblocks[v]; n++) {
+                if (nmissing[n] == 0)
+                    continue;
+                if (file->consistency != H5VL_PDC_CONSISTENCY_OVERLAP)
+                    nbox++;
+                else if (H5VL__pdc_file_drain_overlap(file, &missing[n * H5VL_PDC_MAX_BOXES], nmissing[n]) <
+                         0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL,
+                                "can't complete overlapping write requests");
+            }
         }
+        if (nbox > 0 && H5VL__pdc_file_drain(file, 0) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't complete deferred write requests");
+    }
 
-        region_local      = PDCregion_create(ndim, offset, dims);
-        dset->reg_id_from = region_local;
+    // Build the transfers of every block of every dataset before starting them together, so that
+    // their latencies overlap instead of adding up
+    for (size_t n = 0; n < nunit; n++)
+        nread += nmissing[n];
+    if (nread > 0 && (NULL == (reads = (H5VL_pdc_xfer_t *)calloc(nread, sizeof(H5VL_pdc_xfer_t))) ||
+                      NULL == (owner = (int *)malloc(nread * sizeof(int))) ||
+                      NULL == (reqs = (pdcid_t *)calloc(nread, sizeof(pdcid_t))) ||
+                      NULL == (batch = (pdcid_t *)malloc(nread * sizeof(pdcid_t))) ||
+                      NULL == (regions = (pdcid_t *)calloc(2 * nread, sizeof(pdcid_t)))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate read transfers");
+
+    for (size_t u = 0, n = 0; u < nunit; u++) {
+        for (int b = 0; b < nmissing[u]; b++, n++) {
+            reads[n] = missing[u * H5VL_PDC_MAX_BOXES + b];
+            owner[n] = (int)u;
+
+            if (nmissing[u] == 1 && memcmp(reads[n].count, boxes[u].count, sizeof(reads[n].count)) == 0) {
+                /* Nothing was served locally, read straight into the block buffer */
+                reads[n].buf.buf = boxes[u].buf.buf;
+                continue;
+            }
 
-        if (file_space_id[u] != H5S_ALL)
-            H5VL__pdc_sel_to_recx_iov(file_space_id[u], 1, offset);
+            for (d = 0, nelem = 1; d < reads[n].ndim; d++)
+                nelem *= reads[n].count[d];
+            reads[n].buf.size = nelem * boxes[u].buf.size;
+            if (NULL == (reads[n].buf.buf = H5VL__pdc_pool_alloc(reads[n].buf.size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate read buffer");
+        }
+    }
 
-        region_remote   = PDCregion_create(ndim, offset, dims);
-        dset->reg_id_to = region_remote;
+    H5VL_PDC_LOCK();
+    for (i = 0; i < nread; i++) {
+        file = ((H5VL_pdc_obj_t *)_dset[unit_dset[owner[i]]])->file_obj_ptr;
+        if (H5VL__pdc_chunk_plan(&reads[i], boxes[owner[i]].buf.size, file->chunk.size, &dim, &step) != 1)
+            continue;
+
+        regions[2 * i]     = PDCregion_create(reads[i].ndim, zero, reads[i].count);
+        regions[2 * i + 1] = PDCregion_create(reads[i].ndim, reads[i].offset, reads[i].count);
+        reqs[i] = PDCregion_transfer_create(reads[i].buf.buf, PDC_READ, reads[i].obj_id, regions[2 * i],
+                                            regions[2 * i + 1]);
+        batch[nbatch++] = reqs[i];
+    }
+    if (nbatch > 0)
+        ret = PDCregion_transfer_start_all(batch, nbatch);
+    H5VL_PDC_UNLOCK();
+    if (ret != SUCCEED)
+        HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "Failed to start region transfers");
+    started = TRUE;
+
+    // Stream the blocks larger than a chunk while the batch is in flight; empty ones are no-ops
+    for (i = 0; i < nread; i++) {
+        if (reqs[i] != 0)
+            continue;
+        dset = (H5VL_pdc_obj_t *)_dset[unit_dset[owner[i]]];
+        if (H5VL__pdc_read_box(dset->file_obj_ptr, dset->obj_id, &reads[i], boxes[owner[i]].buf.size,
+                               reads[i].buf.buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read dataset");
+    }
 
-        transfer_request =
-            PDCregion_transfer_create((void *)buf[u], PDC_READ, dset->obj_id, region_local, region_remote);
-        ret = PDCregion_transfer_start(transfer_request);
-        if (ret != SUCCEED) {
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer start");
+    // Wait block by block, copying each one into place while the following ones are still in flight
+    for (i = 0; i < nread; i = j) {
+        for (j = i; j < nread && owner[j] == owner[i]; j++) {
+            if (reqs[j] == 0)
+                continue;
+            ret = H5VL__pdc_xfer_wait(&reqs[j], 1, FALSE);
+            H5VL_PDC_LOCK();
+            if (PDCregion_transfer_close(reqs[j]) != SUCCEED || PDCregion_close(regions[2 * j]) != SUCCEED ||
+                PDCregion_close(regions[2 * j + 1]) != SUCCEED)
+                ret = FAIL;
+            H5VL_PDC_UNLOCK();
+            reqs[j] = 0;
+            if (ret != SUCCEED)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "Failed to complete region transfer");
         }
-        ret = PDCregion_transfer_wait(transfer_request);
-        if (ret != SUCCEED) {
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "Failed to region transfer wait");
+
+        for (k = i; k < j; k++) {
+            if (reads[k].buf.buf == boxes[owner[k]].buf.buf)
+                continue;
+            H5VL__pdc_box_copy(boxes[owner[k]].buf.buf, boxes[owner[k]].offset, boxes[owner[k]].count,
+                               reads[k].buf.buf, reads[k].offset, reads[k].count, reads[k].offset,
+                               reads[k].count, reads[k].ndim, boxes[owner[k]].buf.size);
+            H5VL__pdc_pool_free(reads[k].buf.buf, reads[k].buf.size);
+            reads[k].buf.buf = NULL;
         }
-        ret = PDCregion_transfer_close(transfer_request);
-        if (ret != SUCCEED) {
-            HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "Failed to region transfer close");
+    }
+
+    for (size_t u = 0; u < count; u++) {
+        dset = (H5VL_pdc_obj_t *)_dset[u];
+
+        for (size_t n = first[u]; n < first[u] + nblocks[u]; n++) {
+            // Keep what had to be fetched for the datasets that use the read cache
+            if (dset->read_cache && nmissing[n] > 0)
+                H5VL__pdc_rcache_insert(dset, &boxes[n], boxes[n].buf.size, boxes[n].buf.buf);
+
+            // Staged blocks are scattered into the user buffer, the blocks read as a bounding box
+            // are gathered from it, converting them on the way
+            if (staged[n]) {
+                for (d = 0, nelem = 1; d < boxes[n].ndim; d++)
+                    nelem *= boxes[n].count[d];
+                if (sieved[u]) {
+                    // Points selected more than once may hold more bytes than the box
+                    extra = H5VL__pdc_sieve_copy(&maps[u], &boxes[n], sieved[u], nsieved[u],
+                                                 convs[u].src_size > 0 ? &convs[u] : NULL, staged[n]);
+                    extra = nelem * boxes[n].buf.size > extra ? nelem * boxes[n].buf.size - extra : 0;
+                    file  = dset->file_obj_ptr;
+                    if (file->flush.enabled)
+                        hg_thread_mutex_lock(&file->flush.mutex);
+                    file->stats.nsieve++;
+                    file->stats.sieve_bytes += extra;
+                    if (file->flush.enabled)
+                        hg_thread_mutex_unlock(&file->flush.mutex);
+                }
+                else
+                    H5VL__pdc_memmap_copy(&maps[u], &blocks[u][n - first[u]], boxes[n].buf.size, staged[n],
+                                          NULL, convs[u].src_size > 0 ? &convs[u] : NULL, TRUE);
+                H5VL__pdc_pool_free(staged[n], nelem * boxes[n].buf.size);
+                staged[n] = NULL;
+            }
         }
-    } // End for u < count
+
+        // Start reading the next timestep while the application works on this one
+        if (nblocks[u] == 1)
+            H5VL__pdc_prefetch_note(dset->file_obj_ptr, dset, &boxes[first[u]], boxes[first[u]].buf.size);
+    }
 
 done:
+    // Transfers left behind by an error are finished before their buffers go away
+    for (i = 0; i < nread; i++) {
+        if (reads && reqs && reqs[i] != 0) {
+            if (started)
+                H5VL__pdc_xfer_wait(&reqs[i], 1, FALSE);
+            H5VL_PDC_LOCK();
+            PDCregion_transfer_close(reqs[i]);
+            PDCregion_close(regions[2 * i]);
+            PDCregion_close(regions[2 * i + 1]);
+            H5VL_PDC_UNLOCK();
+        }
+        if (reads && reads[i].buf.buf != NULL && reads[i].buf.buf != boxes[owner[i]].buf.buf)
+            H5VL__pdc_pool_free(reads[i].buf.buf, reads[i].buf.size);
+    }
+    for (size_t n = 0; staged && n < nunit; n++) {
+        if (staged[n] == NULL)
+            continue;
+        for (d = 0, nelem = 1; d < boxes[n].ndim; d++)
+            nelem *= boxes[n].count[d];
+        H5VL__pdc_pool_free(staged[n], nelem * boxes[n].buf.size);
+    }
+    for (size_t u = 0; u < count; u++) {
+        if (maps)
+            H5VL__pdc_memmap_free(&maps[u]);
+        if (blocks)
+            free(blocks[u]);
+        if (sieved)
+            free(sieved[u]);
+    }
+    free(perm);
+    free(regions);
+    free(batch);
+    free(reqs);
+    free(owner);
+    free(reads);
+    free(staged);
+    free(unit_dset);
+    free(nmissing);
+    free(missing);
+    free(boxes);
+    free(convs);
+    free(maps);
+    free(first);
+    free(nsieved);
+    free(sieved);
+    free(nblocks);
+    free(blocks);
     FUNC_LEAVE_VOL
 } /* end H5VL_pdc_dataset_read() */
 
@@ -1856,10 +7478,15 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static herr_t
-H5VL_pdc_dataset_specific(void *                        obj __attribute__((unused)),
-                          H5VL_dataset_specific_args_t *args __attribute__((unused)),
+H5VL_pdc_dataset_specific(void *obj, H5VL_dataset_specific_args_t *args,
                           hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
+    H5VL_pdc_obj_t *dset = (H5VL_pdc_obj_t *)obj;
+
+    // Handles opened later look the changed extent up again
+    if (args->op_type == H5VL_DATASET_SET_EXTENT && dset->meta)
+        H5VL__pdc_meta_invalidate(dset->file_obj_ptr, dset->obj_name);
+
     return 0;
 } /* end H5VL_pdc_dataset_specific() */
 
@@ -1886,14 +7513,27 @@ H5VL_pdc_dataset_close(void *_dset, hid_t dxpl_id __attribute__((unused)), void
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
     assert(dset);
-    if ((ret = PDCobj_close(dset->obj_id)) < 0)
+    // A create still deferred is made without the handle
+    if (dset->create)
+        dset->create->dset = NULL;
+    // Attributes written through the handle are written back
+    if (dset->meta && H5VL__pdc_attr_push(dset->file_obj_ptr, dset->meta->attrs) < 0)
+        HGOTO_ERROR(H5E_ATTR, H5E_WRITEERROR, FAIL, "can't write attributes");
+    // The objects stay open while the dataset is cached, or open through another handle
+    if (dset->meta && H5VL__pdc_meta_release(dset->file_obj_ptr, dset->meta) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "can't close object");
     if (dset->reg_id_from != 0) {
-        if ((ret = PDCregion_close(dset->reg_id_from)) < 0)
+        H5VL_PDC_LOCK();
+        ret = PDCregion_close(dset->reg_id_from);
+        H5VL_PDC_UNLOCK();
+        if (ret < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "can't close region");
     }
     if (dset->reg_id_to != 0) {
-        if ((ret = PDCregion_close(dset->reg_id_to) < 0))
+        H5VL_PDC_LOCK();
+        ret = PDCregion_close(dset->reg_id_to);
+        H5VL_PDC_UNLOCK();
+        if (ret < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CLOSEERROR, FAIL, "can't close remote region");
     }
 
@@ -2034,24 +7674,15 @@ H5VL_pdc_group_create(void *obj, const H5VL_loc_params_t *loc_params __attribute
 #endif
 
     H5VL_pdc_obj_t *group;
-    H5VL_pdc_obj_t *o          = (H5VL_pdc_obj_t *)obj;
-    void *          under      = NULL;
-    char *          group_name = (char *)calloc(1, strlen(name) + 1);
-    strcpy(group_name, name);
-
-    group             = H5VL_pdc_new_obj(under, o->under_vol_id);
-    group->group_name = group_name;
-    group->h5i_type   = H5I_GROUP;
-    group->h5o_type   = H5O_TYPE_GROUP;
-
-    char *file_name = (char *)calloc(1, strlen(o->file_name) + 1);
-    strcpy(file_name, o->file_name);
-    group->file_name = file_name;
+    H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)obj;
+    char            path[ADDR_MAX];
 
-    group->comm         = o->comm;
-    group->info         = o->info;
-    group->cont_id      = o->cont_id;
-    group->file_obj_ptr = o->file_obj_ptr;
+    // The group is listed by its parent from now on
+    if (H5VL__pdc_link_path(o, name, path, sizeof(path)) < 0 ||
+        NULL == H5VL__pdc_link_add(o->file_obj_ptr, path, H5O_TYPE_GROUP))
+        return NULL;
+    if (NULL == (group = H5VL__pdc_group_init(o, name, path)))
+        return NULL;
 
     /* Check for async request */
     if (req && *req)
@@ -2070,24 +7701,13 @@ H5VL_pdc_group_open(void *obj, const H5VL_loc_params_t *loc_params __attribute__
 #endif
 
     H5VL_pdc_obj_t *group;
-    H5VL_pdc_obj_t *o          = (H5VL_pdc_obj_t *)obj;
-    void *          under      = NULL;
-    char *          group_name = (char *)calloc(1, strlen(name) + 1);
-    strcpy(group_name, name);
-
-    group             = H5VL_pdc_new_obj(under, o->under_vol_id);
-    group->group_name = group_name;
-    group->h5i_type   = H5I_GROUP;
-    group->h5o_type   = H5O_TYPE_GROUP;
-
-    char *file_name = (char *)calloc(1, strlen(o->file_name) + 1);
-    strcpy(file_name, o->file_name);
-    group->file_name = file_name;
+    H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)obj;
+    char            path[ADDR_MAX];
 
-    group->comm         = o->comm;
-    group->info         = o->info;
-    group->cont_id      = o->cont_id;
-    group->file_obj_ptr = o->file_obj_ptr;
+    if (H5VL__pdc_link_path(o, name, path, sizeof(path)) < 0)
+        return NULL;
+    if (NULL == (group = H5VL__pdc_group_init(o, name, path)))
+        return NULL;
 
     /* Check for async request */
     if (req && *req)
@@ -2097,14 +7717,34 @@ H5VL_pdc_group_open(void *obj, const H5VL_loc_params_t *loc_params __attribute__
 } /* end H5VL_pdc_group_open() */
 
 /*---------------------------------------------------------------------------*/
+/* Group info comes from the namespace index, other queries are not supported */
 static herr_t
-H5VL_pdc_group_get(void *obj __attribute__((unused)), H5VL_group_get_args_t *args __attribute__((unused)),
-                   hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
+H5VL_pdc_group_get(void *obj, H5VL_group_get_args_t *args, hid_t dxpl_id __attribute__((unused)),
+                   void **req __attribute__((unused)))
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
-    return 0;
+    H5VL_pdc_obj_t * o = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_link_t *grp;
+    H5G_info_t *     ginfo;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (args->op_type != H5VL_GROUP_GET_INFO)
+        HGOTO_DONE(SUCCEED);
+
+    if (NULL == (grp = H5VL__pdc_link_loc(o, &args->args.get_info.loc_params)) || grp->type != H5O_TYPE_GROUP)
+        HGOTO_ERROR(H5E_SYM, H5E_NOTFOUND, FAIL, "group not found");
+
+    ginfo               = args->args.get_info.ginfo;
+    ginfo->storage_type = H5G_STORAGE_TYPE_COMPACT;
+    ginfo->nlinks       = grp->nlinks;
+    ginfo->max_corder   = grp->max_corder;
+    ginfo->mounted      = FALSE;
+
+done:
+    FUNC_LEAVE_VOL
 } /* end H5VL_pdc_group_get() */
 
 /*---------------------------------------------------------------------------*/
@@ -2126,12 +7766,17 @@ H5VL_pdc_group_optional(void *obj __attribute__((unused)), H5VL_optional_args_t
 
 /*---------------------------------------------------------------------------*/
 static herr_t
-H5VL_pdc_group_close(void *grp __attribute__((unused)), hid_t dxpl_id __attribute__((unused)),
-                     void **req __attribute__((unused)))
+H5VL_pdc_group_close(void *grp, hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
+    H5VL_pdc_obj_t *group = (H5VL_pdc_obj_t *)grp;
+
+    free(group->group_name);
+    free(group->file_name);
+    free(group->link_path);
+    free(group);
 
     return 0;
 } /* end H5VL_pdc_group_close() */
@@ -2171,23 +7816,111 @@ H5VL_pdc_link_move(void *                   src_obj __attribute__((unused)),
 } /* end H5VL_pdc_link_move() */
 
 /*---------------------------------------------------------------------------*/
+/* Link info and names come from the namespace index. Every link is a hard
+ * link, there is no link value to get. */
 static herr_t
-H5VL_pdc_link_get(void *                   obj __attribute__((unused)),
-                  const H5VL_loc_params_t *loc_params __attribute__((unused)),
-                  H5VL_link_get_args_t *args __attribute__((unused)), hid_t dxpl_id __attribute__((unused)),
-                  void **req __attribute__((unused)))
+H5VL_pdc_link_get(void *obj, const H5VL_loc_params_t *loc_params, H5VL_link_get_args_t *args,
+                  hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
-    return 0;
+    H5VL_pdc_obj_t * o = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_link_t *link;
+    size_t           len;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (NULL == (link = H5VL__pdc_link_loc(o, loc_params)) || link->parent == NULL)
+        HGOTO_ERROR(H5E_LINK, H5E_NOTFOUND, FAIL, "link not found");
+
+    switch (args->op_type) {
+        case H5VL_LINK_GET_INFO:
+            H5VL__pdc_link_info(link, args->args.get_info.linfo);
+            break;
+
+        case H5VL_LINK_GET_NAME:
+            // The name is truncated to the buffer, its full length is returned
+            len = strlen(link->name);
+            if (args->args.get_name.name_len)
+                *args->args.get_name.name_len = len;
+            if (args->args.get_name.name && args->args.get_name.name_size > 0) {
+                if (len >= args->args.get_name.name_size)
+                    len = args->args.get_name.name_size - 1;
+                memcpy(args->args.get_name.name, link->name, len);
+                args->args.get_name.name[len] = '\0';
+            }
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_VOL, H5E_UNSUPPORTED, FAIL, "unsupported link get operation");
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_VOL
 } /* end H5VL_pdc_link_get() */
 
 /*---------------------------------------------------------------------------*/
+/* Link existence and iteration are answered from the namespace index */
 static herr_t
-H5VL_pdc_link_specific(void *                     obj __attribute__((unused)),
-                       const H5VL_loc_params_t *  loc_params __attribute__((unused)),
-                       H5VL_link_specific_args_t *args __attribute__((unused)),
+H5VL_pdc_link_specific(void *obj, const H5VL_loc_params_t *loc_params, H5VL_link_specific_args_t *args,
                        hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
-    return 0;
+    H5VL_pdc_obj_t * o     = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_obj_t * group = NULL;
+    H5VL_pdc_link_t *link;
+    hid_t            group_id = H5I_INVALID_HID;
+    const char *     group_name;
+    char             name[ADDR_MAX];
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    switch (args->op_type) {
+        case H5VL_LINK_DELETE:
+            // A deleted dataset is no longer opened from the metadata cache
+            if (loc_params->type == H5VL_OBJECT_BY_NAME && o->file_obj_ptr) {
+                if (o->group_name)
+                    snprintf(name, sizeof(name), "%s/%s/%s", loc_params->loc_data.loc_by_name.name,
+                             o->group_name, o->file_name);
+                else
+                    snprintf(name, sizeof(name), "%s/%s", loc_params->loc_data.loc_by_name.name,
+                             o->file_name);
+                replace_multi_slash(name);
+                H5VL__pdc_meta_invalidate(o->file_obj_ptr, name);
+            }
+
+            // nor listed by its group
+            if (o->file_obj_ptr && NULL != (link = H5VL__pdc_link_loc(o, loc_params)) && link->parent)
+                H5VL__pdc_link_remove(o->file_obj_ptr, link);
+            break;
+
+        case H5VL_LINK_EXISTS:
+            *args->args.exists.exists = o->file_obj_ptr && H5VL__pdc_link_loc(o, loc_params) != NULL;
+            break;
+
+        case H5VL_LINK_ITER:
+            if (NULL == (link = H5VL__pdc_link_loc(o, loc_params)) || link->type != H5O_TYPE_GROUP)
+                HGOTO_ERROR(H5E_SYM, H5E_NOTFOUND, FAIL, "group not found");
+
+            // The operator is given a handle of the group iterated on, named as a group open would
+            group_name = loc_params->type == H5VL_OBJECT_BY_NAME ? loc_params->loc_data.loc_by_name.name
+                                                                 : o->group_name;
+            if (NULL == (group = H5VL__pdc_group_init(o, group_name, link->path)))
+                HGOTO_ERROR(H5E_SYM, H5E_CANTINIT, FAIL, "can't init PDC group struct");
+            if ((group_id = H5VLwrap_register(group, H5I_GROUP)) < 0) {
+                H5VL_pdc_group_close(group, H5P_DATASET_XFER_DEFAULT, NULL);
+                HGOTO_ERROR(H5E_SYM, H5E_CANTREGISTER, FAIL, "can't register group");
+            }
+
+            FUNC_RETURN_SET(H5VL__pdc_link_iterate(link, NULL, group_id, args->args.iterate.idx_p,
+                                                   &args->args.iterate));
+            if (H5Idec_ref(group_id) < 0)
+                HGOTO_ERROR(H5E_SYM, H5E_CANTRELEASE, FAIL, "can't release group");
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_VOL, H5E_UNSUPPORTED, FAIL, "unsupported link specific operation");
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_VOL
 } /* end H5VL_pdc_link_specific() */
 
 /*---------------------------------------------------------------------------*/
@@ -2210,28 +7943,63 @@ H5VL_pdc_attr_create(void *obj, const H5VL_loc_params_t *loc_params __attribute_
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    H5VL_pdc_obj_t *attr;
-    H5VL_pdc_obj_t *o     = (H5VL_pdc_obj_t *)obj;
-    void *          under = NULL;
-    psize_t         value_size;
+    H5VL_pdc_obj_t *     attr  = NULL;
+    H5VL_pdc_obj_t *     o     = (H5VL_pdc_obj_t *)obj;
+    void *               under = NULL;
+    psize_t              value_size;
+    H5VL_pdc_attr_ent_t *ent;
 
-    char *attr_name = (char *)malloc(strlen(name) + 1);
-    strcpy(attr_name, name);
-    attr                  = H5VL_pdc_new_obj(under, o->under_vol_id);
-    attr->attr_name       = attr_name;
+    FUNC_ENTER_VOL(void *, NULL)
+
+    // Tags need the object of a dataset whose create was deferred, made on its own
+    if (o->create && H5VL__pdc_create_one(o->file_obj_ptr, o->create) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, NULL, "can't create dataset");
+
+    if (NULL == (attr = H5VL_pdc_new_obj(under, o->under_vol_id)) ||
+        NULL == (attr->attr_name = strdup(name)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "can't allocate attribute");
     value_size            = H5Sget_select_npoints(space_id) * H5Tget_size(type_id);
     attr->attr_value_size = value_size;
     attr->obj_id          = o->obj_id;
     attr->cont_id         = o->cont_id;
+    attr->file_obj_ptr    = o->file_obj_ptr;
+    attr->meta            = o->meta;
+    if (attr->meta)
+        attr->meta->nref++;
 
     attr->h5i_type = H5I_ATTR;
     /* attr->h5o_type = H5O_TYPE_ATTR; */
 
+    // The datatype and shape are known from now on, the value once it is written
+    if (NULL == (ent = H5VL__pdc_attr_find(attr, TRUE)))
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTCREATE, NULL, "can't cache attribute");
+    if (ent->type_id > 0)
+        H5Tclose(ent->type_id);
+    if (ent->space_id > 0)
+        H5Sclose(ent->space_id);
+    free(ent->value);
+    ent->value    = NULL;
+    ent->dirty    = FALSE;
+    ent->size     = value_size;
+    ent->type_id  = H5Tcopy(type_id);
+    ent->space_id = H5Scopy(space_id);
+    if ((ent->pdc_type = H5VL__pdc_type_to_pdc(type_id)) == PDC_UNKNOWN)
+        ent->pdc_type = PDC_CHAR;
+
     /* Check for async request */
     if (req && *req)
         *req = H5VL_pdc_new_obj(*req, o->under_vol_id);
 
-    return (void *)attr;
+    FUNC_RETURN_SET((void *)attr);
+
+done:
+    if (FUNC_ERRORED && attr) {
+        if (attr->meta)
+            H5VL__pdc_meta_release(attr->file_obj_ptr, attr->meta);
+        free(attr->attr_name);
+        free(attr);
+    }
+    FUNC_LEAVE_VOL
 } /* end H5VL_pdc_attr_create() */
 /*---------------------------------------------------------------------------*/
 static void *
@@ -2243,43 +8011,60 @@ H5VL_pdc_attr_open(void *obj, const H5VL_loc_params_t *loc_params __attribute__(
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
     H5VL_pdc_obj_t *attr;
-    H5VL_pdc_obj_t *o         = (H5VL_pdc_obj_t *)obj;
-    void *          under     = NULL;
-    char *          attr_name = (char *)malloc(strlen(name) + 1);
+    H5VL_pdc_obj_t *o     = (H5VL_pdc_obj_t *)obj;
+    void *          under = NULL;
+
+    // Tags need the object of a dataset whose create was deferred, made on its own
+    if (o->create && H5VL__pdc_create_one(o->file_obj_ptr, o->create) < 0)
+        return NULL;
+
+    char *attr_name = (char *)malloc(strlen(name) + 1);
     strcpy(attr_name, name);
     o->attr_name = attr_name;
 
-    attr            = H5VL_pdc_new_obj(under, o->under_vol_id);
-    attr->attr_name = attr_name;
-    attr->obj_id    = o->obj_id;
-    attr->cont_id   = o->cont_id;
+    attr               = H5VL_pdc_new_obj(under, o->under_vol_id);
+    attr->attr_name    = attr_name;
+    attr->obj_id       = o->obj_id;
+    attr->cont_id      = o->cont_id;
+    attr->file_obj_ptr = o->file_obj_ptr;
+    attr->meta         = o->meta;
+    if (attr->meta)
+        attr->meta->nref++;
 
     return (void *)attr;
 } /* end H5VL_pdc_attr_open() */
 /*---------------------------------------------------------------------------*/
 static perr_t
-H5VL_pdc_attr_read(void *attr, hid_t mem_type_id __attribute__((unused)), void *buf,
-                   hid_t dxpl_id __attribute__((unused)), void **req)
+H5VL_pdc_attr_read(void *attr, hid_t mem_type_id, void *buf, hid_t dxpl_id __attribute__((unused)),
+                   void **req)
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
-    H5VL_pdc_obj_t *o         = (H5VL_pdc_obj_t *)attr;
-    void *          tag_value = NULL;
-    perr_t          ret_value = FAIL;
-    pdc_var_type_t  value_type;
-
-    if (o->obj_id > 0) {
-        ret_value =
-            PDCobj_get_tag(o->obj_id, (char *)o->attr_name, &tag_value, &value_type, &(o->attr_value_size));
+    H5VL_pdc_obj_t *     o         = (H5VL_pdc_obj_t *)attr;
+    H5VL_pdc_obj_t *     file      = o->file_obj_ptr;
+    H5VL_pdc_attr_ent_t *ent;
+    perr_t               ret_value = SUCCEED;
+
+    // The value is fetched once, then read from memory
+    if (NULL == (ent = H5VL__pdc_attr_find(o, TRUE)))
+        ret_value = FAIL;
+    else if (ent->value == NULL) {
+        if (H5VL__pdc_attr_fetch(file, ent) < 0)
+            ret_value = FAIL;
     }
-    else if (o->cont_id > 0) {
-        ret_value =
-            PDCcont_get_tag(o->cont_id, (char *)o->attr_name, &tag_value, &value_type, &(o->attr_value_size));
+    else {
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nattr_hit++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
+    }
+    if (ret_value >= 0) {
+        o->attr_value_size = ent->size;
+        if (H5VL__pdc_attr_convert(ent, ent->type_id, mem_type_id, ent->value, buf) < 0)
+            ret_value = FAIL;
     }
-    memcpy(buf, tag_value, o->attr_value_size);
-    if (tag_value)
-        free(tag_value);
 
     /* Check for async request */
     if (req && *req)
@@ -2290,24 +8075,30 @@ H5VL_pdc_attr_read(void *attr, hid_t mem_type_id __attribute__((unused)), void *
 
 /*---------------------------------------------------------------------------*/
 static perr_t
-H5VL_pdc_attr_write(void *attr, hid_t mem_type_id __attribute__((unused)), const void *buf,
-                    hid_t dxpl_id __attribute__((unused)), void **req)
+H5VL_pdc_attr_write(void *attr, hid_t mem_type_id, const void *buf, hid_t dxpl_id __attribute__((unused)),
+                    void **req)
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    H5VL_pdc_obj_t *o         = (H5VL_pdc_obj_t *)attr;
-    herr_t          ret_value = FAIL;
-
-    if (o->obj_id > 0)
-        ret_value =
-            PDCobj_put_tag(o->obj_id, (char *)o->attr_name, (void *)buf, PDC_CHAR, o->attr_value_size);
-    else if (o->cont_id > 0)
-        ret_value =
-            PDCcont_put_tag(o->cont_id, (char *)o->attr_name, (void *)buf, PDC_CHAR, o->attr_value_size);
-    /* else */
-    /*     HGOTO_ERROR(H5E_VOL, H5E_WRITEERROR, FAIL, "no valid PDC obj/cont ID"); */
+    H5VL_pdc_obj_t *     o         = (H5VL_pdc_obj_t *)attr;
+    H5VL_pdc_attr_ent_t *ent;
+    herr_t               ret_value = SUCCEED;
+
+    // The value is kept until its object is closed or flushed; the size of an attribute that was
+    // opened rather than created is learnt by fetching it once
+    if (NULL == (ent = H5VL__pdc_attr_find(o, TRUE)) ||
+        (ent->type_id <= 0 && H5VL__pdc_attr_fetch(o->file_obj_ptr, ent) < 0))
+        ret_value = FAIL;
+    else if (ent->value == NULL && NULL == (ent->value = malloc(ent->size > 0 ? ent->size : 1)))
+        ret_value = FAIL;
+    else if (H5VL__pdc_attr_convert(ent, mem_type_id, ent->type_id, buf, ent->value) < 0)
+        ret_value = FAIL;
+    else {
+        ent->dirty         = TRUE;
+        o->attr_value_size = ent->size;
+    }
 
     /* Check for async request */
     if (req && *req)
@@ -2325,60 +8116,38 @@ H5VL_pdc_attr_get(void *obj, H5VL_attr_get_args_t *args, hid_t dxpl_id __attribu
 #endif
     FUNC_ENTER_VOL(herr_t, SUCCEED)
 
-    H5VL_pdc_obj_t *o         = (H5VL_pdc_obj_t *)obj;
-    void *          tag_value = NULL;
-    pdc_var_type_t  value_type;
-
-    if (o->obj_id > 0) {
-        PDCobj_get_tag(o->obj_id, (char *)o->attr_name, &tag_value, &value_type, &(o->attr_value_size));
+    H5VL_pdc_obj_t *     o    = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_obj_t *     file = o->file_obj_ptr;
+    H5VL_pdc_attr_ent_t *ent;
+
+    // The datatype and space are known from the create, or from the value once it is fetched
+    if (NULL == (ent = H5VL__pdc_attr_find(o, TRUE)))
+        HGOTO_ERROR(H5E_ATTR, H5E_CANTALLOC, FAIL, "can't cache attribute");
+    if (ent->type_id <= 0) {
+        if (H5VL__pdc_attr_fetch(file, ent) < 0)
+            HGOTO_ERROR(H5E_ATTR, H5E_READERROR, FAIL, "can't fetch attribute");
     }
-    else if (o->cont_id > 0) {
-        PDCcont_get_tag(o->cont_id, (char *)o->attr_name, &tag_value, &value_type, &(o->attr_value_size));
+    else {
+        if (file->flush.enabled)
+            hg_thread_mutex_lock(&file->flush.mutex);
+        file->stats.nattr_hit++;
+        if (file->flush.enabled)
+            hg_thread_mutex_unlock(&file->flush.mutex);
     }
 
     switch (args->op_type) {
         case H5VL_ATTR_GET_SPACE:
-            hsize_t dims[1];
-            dims[0] = o->attr_value_size / PDC_get_var_type_size(value_type);
-            // TODO: handle compound
-            hid_t space_id                = H5Screate_simple(1, dims, NULL);
-            args->args.get_space.space_id = space_id;
-
+            if ((args->args.get_space.space_id = H5Scopy(ent->space_id)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "can't copy attribute dataspace");
             break;
         case H5VL_ATTR_GET_TYPE:
-            hid_t dtype;
-            switch (value_type) {
-                case PDC_INT:
-                    dtype = H5Tcopy(H5T_NATIVE_INT);
-                    break;
-                case PDC_FLOAT:
-                    dtype = H5Tcopy(H5T_NATIVE_FLOAT);
-                    break;
-                case PDC_DOUBLE:
-                    dtype = H5Tcopy(H5T_NATIVE_DOUBLE);
-                    break;
-                case PDC_CHAR:
-
-                case PDC_STRING:
-                    dtype = H5Tcopy(H5T_C_S1);
-                    H5Tset_size(dtype, o->attr_value_size);
-                    break;
-                default:
-                    fprintf(stderr, "Rank %d: %s unsupported PDC datatype type\n", my_rank_g, __func__);
-                    HGOTO_ERROR(H5E_VOL, H5E_UNSUPPORTED, FAIL,
-                                "invalid or unsupported attribute get operation");
-            }
-            args->args.get_type.type_id = dtype;
-
+            if ((args->args.get_type.type_id = H5Tcopy(ent->type_id)) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCOPY, FAIL, "can't copy attribute datatype");
             break;
         default:
-            fprintf(stderr, "Rank %d: %s unsupported get type\n", my_rank_g, __func__);
             HGOTO_ERROR(H5E_VOL, H5E_UNSUPPORTED, FAIL, "invalid or unsupported attribute get operation");
     }
 
-    if (tag_value)
-        free(tag_value);
-
 done:
     /* Check for async request */
     if (req && *req)
@@ -2407,15 +8176,19 @@ H5VL_pdc_attr_optional(void *obj __attribute__((unused)), H5VL_optional_args_t *
 
 /*---------------------------------------------------------------------------*/
 static herr_t
-H5VL_pdc_attr_close(void *attr __attribute__((unused)), hid_t dxpl_id __attribute__((unused)),
-                    void **req __attribute__((unused)))
+H5VL_pdc_attr_close(void *attr, hid_t dxpl_id __attribute__((unused)), void **req __attribute__((unused)))
 {
 #ifdef ENABLE_LOGGING
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    /* H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)attr; */
-    herr_t ret_value = SUCCEED;
+    H5VL_pdc_obj_t *o         = (H5VL_pdc_obj_t *)attr;
+    herr_t          ret_value = SUCCEED;
+
+    // The attribute stays cached with its dataset, whose objects the handle kept open
+    if (o->meta && H5VL__pdc_meta_release(o->file_obj_ptr, o->meta) < 0)
+        ret_value = FAIL;
+    o->meta = NULL;
 
     return ret_value;
 } /* end H5VL_pdc_attr_close() */
@@ -2429,12 +8202,18 @@ H5VL_pdc_object_open(void *obj, const H5VL_loc_params_t *loc_params, H5I_type_t
     fprintf(stderr, "Rank %d: entering %s\n", my_rank_g, __func__);
 #endif
 
-    H5VL_pdc_obj_t *new_obj;
-    H5VL_pdc_obj_t *o = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_obj_t * new_obj;
+    H5VL_pdc_obj_t * o = (H5VL_pdc_obj_t *)obj;
+    H5VL_pdc_link_t *link;
     /* void *          under = NULL; */
 
     /* Only support dataset open and group open for now. */
-    new_obj = H5VL_pdc_dataset_open(obj, loc_params, loc_params->loc_data.loc_by_name.name, 0, dxpl_id, req);
+    // Groups known to the namespace index are not looked up as datasets first
+    if (o->file_obj_ptr && NULL != (link = H5VL__pdc_link_loc(o, loc_params)) && link->type == H5O_TYPE_GROUP)
+        new_obj = NULL;
+    else
+        new_obj =
+            H5VL_pdc_dataset_open(obj, loc_params, loc_params->loc_data.loc_by_name.name, 0, dxpl_id, req);
     if (new_obj == NULL) {
         new_obj =
             H5VL_pdc_group_open(obj, loc_params, loc_params->loc_data.loc_by_name.name, 0, dxpl_id, req);
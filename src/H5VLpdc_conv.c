@@ -0,0 +1,303 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Conversion of numeric elements between datatypes in the PDC VOL connector
+ */
+#include "H5VLpdc_private.h"
+
+/* External headers needed by this file */
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define H5VL_PDC_CONV_NTYPES 10
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hbool_t H5VL__pdc_conv_type(hid_t type_id, int *idx, hbool_t *swap);
+static void    H5VL__pdc_conv_swap(void *buf, size_t size, size_t n);
+
+/*---------------------------------------------------------------------------*/
+/* Datatype conversion kernels. Each kernel converts n elements between two
+ * native types in a plain loop, which the compiler vectorizes where it can.
+ * Out-of-range values are handled as H5Tconvert() does by default: integers
+ * saturate, floats are truncated toward zero and saturate when converted to
+ * integers, NaN becoming 0, and doubles beyond the range of a float become
+ * infinities. */
+
+/* Native types handled by the kernels, whether they are integers (I) or
+ * floats (F), and their ranges. HI is the power of two just above the
+ * largest value of an integer type, exact as a double. */
+#define H5VL_PDC_T_i8       int8_t
+#define H5VL_PDC_T_u8       uint8_t
+#define H5VL_PDC_T_i16      int16_t
+#define H5VL_PDC_T_u16      uint16_t
+#define H5VL_PDC_T_i32      int32_t
+#define H5VL_PDC_T_u32      uint32_t
+#define H5VL_PDC_T_i64      int64_t
+#define H5VL_PDC_T_u64      uint64_t
+#define H5VL_PDC_T_f32      float
+#define H5VL_PDC_T_f64      double
+#define H5VL_PDC_KIND_i8    I
+#define H5VL_PDC_KIND_u8    I
+#define H5VL_PDC_KIND_i16   I
+#define H5VL_PDC_KIND_u16   I
+#define H5VL_PDC_KIND_i32   I
+#define H5VL_PDC_KIND_u32   I
+#define H5VL_PDC_KIND_i64   I
+#define H5VL_PDC_KIND_u64   I
+#define H5VL_PDC_KIND_f32   F
+#define H5VL_PDC_KIND_f64   F
+#define H5VL_PDC_SIGNED_i8  1
+#define H5VL_PDC_SIGNED_u8  0
+#define H5VL_PDC_SIGNED_i16 1
+#define H5VL_PDC_SIGNED_u16 0
+#define H5VL_PDC_SIGNED_i32 1
+#define H5VL_PDC_SIGNED_u32 0
+#define H5VL_PDC_SIGNED_i64 1
+#define H5VL_PDC_SIGNED_u64 0
+#define H5VL_PDC_MIN_i8     INT8_MIN
+#define H5VL_PDC_MIN_u8     0
+#define H5VL_PDC_MIN_i16    INT16_MIN
+#define H5VL_PDC_MIN_u16    0
+#define H5VL_PDC_MIN_i32    INT32_MIN
+#define H5VL_PDC_MIN_u32    0
+#define H5VL_PDC_MIN_i64    INT64_MIN
+#define H5VL_PDC_MIN_u64    0
+#define H5VL_PDC_MAX_i8     INT8_MAX
+#define H5VL_PDC_MAX_u8     UINT8_MAX
+#define H5VL_PDC_MAX_i16    INT16_MAX
+#define H5VL_PDC_MAX_u16    UINT16_MAX
+#define H5VL_PDC_MAX_i32    INT32_MAX
+#define H5VL_PDC_MAX_u32    UINT32_MAX
+#define H5VL_PDC_MAX_i64    INT64_MAX
+#define H5VL_PDC_MAX_u64    UINT64_MAX
+#define H5VL_PDC_MAX_f32    FLT_MAX
+#define H5VL_PDC_MAX_f64    DBL_MAX
+#define H5VL_PDC_HI_i8      128.0
+#define H5VL_PDC_HI_u8      256.0
+#define H5VL_PDC_HI_i16     32768.0
+#define H5VL_PDC_HI_u16     65536.0
+#define H5VL_PDC_HI_i32     2147483648.0
+#define H5VL_PDC_HI_u32     4294967296.0
+#define H5VL_PDC_HI_i64     9223372036854775808.0
+#define H5VL_PDC_HI_u64     18446744073709551616.0
+
+/* The upper bound of a type as a signed 64-bit value, for signed sources */
+#define H5VL_PDC_SMAX(T)                                                                                     \
+    ((uint64_t)H5VL_PDC_MAX_##T > (uint64_t)INT64_MAX ? INT64_MAX : (int64_t)H5VL_PDC_MAX_##T)
+
+/* The types in kernel table order, twice so that the lists can be nested */
+#define H5VL_PDC_TYPES(X, A)                                                                                 \
+    X(A, i8) X(A, u8) X(A, i16) X(A, u16) X(A, i32) X(A, u32) X(A, i64) X(A, u64) X(A, f32) X(A, f64)
+#define H5VL_PDC_TYPES2(X, A)                                                                                \
+    X(A, i8) X(A, u8) X(A, i16) X(A, u16) X(A, i32) X(A, u32) X(A, i64) X(A, u64) X(A, f32) X(A, f64)
+
+/* Integer element x of type S saturated to integer type D, compared as signed
+ * or unsigned 64-bit values after the signedness of S */
+#define H5VL_PDC_CONV_I_I(S, D, x)                                                                           \
+    (H5VL_PDC_SIGNED_##S                                                                                     \
+         ? (H5VL_PDC_T_##D)((int64_t)(x) < (int64_t)H5VL_PDC_MIN_##D                                         \
+                                ? (int64_t)H5VL_PDC_MIN_##D                                                  \
+                                : ((int64_t)(x) > H5VL_PDC_SMAX(D) ? H5VL_PDC_SMAX(D) : (int64_t)(x)))       \
+         : (H5VL_PDC_T_##D)((uint64_t)(x) > (uint64_t)H5VL_PDC_MAX_##D ? (uint64_t)H5VL_PDC_MAX_##D          \
+                                                                         : (uint64_t)(x)))
+
+/* Integer element x converted to float type D, always in range */
+#define H5VL_PDC_CONV_I_F(S, D, x) ((H5VL_PDC_T_##D)(x))
+
+/* Float element x truncated toward zero and saturated to integer type D. The
+ * values strictly between the lower bound minus one and the upper bound are
+ * those whose truncation fits D */
+#define H5VL_PDC_CONV_F_I(S, D, x)                                                                           \
+    ((x) != (x) ? (H5VL_PDC_T_##D)0                                                                          \
+                : (double)(x) >= H5VL_PDC_HI_##D                                                             \
+                      ? (H5VL_PDC_T_##D)H5VL_PDC_MAX_##D                                                     \
+                      : (double)(x) <= (double)H5VL_PDC_MIN_##D - 1.0 ? (H5VL_PDC_T_##D)H5VL_PDC_MIN_##D     \
+                                                                      : (H5VL_PDC_T_##D)(x))
+
+/* Float element x converted to float type D, infinite beyond its range */
+#define H5VL_PDC_CONV_F_F(S, D, x)                                                                           \
+    ((x) > H5VL_PDC_MAX_##D ? (H5VL_PDC_T_##D)INFINITY                                                       \
+                            : (x) < -H5VL_PDC_MAX_##D ? (H5VL_PDC_T_##D)-INFINITY : (H5VL_PDC_T_##D)(x))
+
+/* Element x of type S converted to type D, after the kinds of both types */
+#define H5VL_PDC_CONV_ONE(S, D, x)           H5VL_PDC_CONV_ONE_(H5VL_PDC_KIND_##S, H5VL_PDC_KIND_##D, S, D, x)
+#define H5VL_PDC_CONV_ONE_(KS, KD, S, D, x)  H5VL_PDC_CONV_ONE__(KS, KD, S, D, x)
+#define H5VL_PDC_CONV_ONE__(KS, KD, S, D, x) H5VL_PDC_CONV_##KS##_##KD(S, D, x)
+
+#define H5VL_PDC_CONV_KERNEL(S, D)                                                                           \
+    static void H5VL__pdc_conv_##S##_##D(void *_dst, const void *_src, size_t n)                             \
+    {                                                                                                        \
+        const H5VL_PDC_T_##S *src = (const H5VL_PDC_T_##S *)_src;                                            \
+        H5VL_PDC_T_##D *      dst = (H5VL_PDC_T_##D *)_dst;                                                  \
+        size_t                i;                                                                             \
+                                                                                                             \
+        for (i = 0; i < n; i++)                                                                              \
+            dst[i] = H5VL_PDC_CONV_ONE(S, D, src[i]);                                                        \
+    }
+#define H5VL_PDC_CONV_KERNEL_ROW(_, S) H5VL_PDC_TYPES2(H5VL_PDC_CONV_KERNEL, S)
+
+/* All the kernels, and their table indexed by source and destination type.
+ * The kernels from a type to itself are never used. */
+H5VL_PDC_TYPES(H5VL_PDC_CONV_KERNEL_ROW, _)
+
+#define H5VL_PDC_CONV_ENTRY(S, D)     H5VL__pdc_conv_##S##_##D,
+#define H5VL_PDC_CONV_TABLE_ROW(_, S) {H5VL_PDC_TYPES2(H5VL_PDC_CONV_ENTRY, S)},
+
+static const H5VL_pdc_conv_func_t conv_kernels_g[H5VL_PDC_CONV_NTYPES][H5VL_PDC_CONV_NTYPES] = {
+    H5VL_PDC_TYPES(H5VL_PDC_CONV_TABLE_ROW, _)};
+
+/*---------------------------------------------------------------------------*/
+/* Index in the kernel table of a datatype, and whether its bytes are not in
+ * native order. Only full-width integers and enumerations of 1 to 8 bytes and
+ * IEEE single and double precision floats are handled. */
+static hbool_t
+H5VL__pdc_conv_type(hid_t type_id, int *idx, hbool_t *swap)
+{
+    hid_t       super_id = H5I_INVALID_HID;
+    H5T_class_t tclass;
+    size_t      size;
+    int         lg;
+    hbool_t     ret_value = FALSE;
+
+    if ((tclass = H5Tget_class(type_id)) == H5T_ENUM) {
+        if ((super_id = H5Tget_super(type_id)) < 0)
+            return FALSE;
+        type_id = super_id;
+        tclass  = H5Tget_class(type_id);
+    }
+    size = H5Tget_size(type_id);
+
+    if (tclass == H5T_INTEGER) {
+        for (lg = 0; lg < 4 && ((size_t)1 << lg) != size; lg++)
+            ;
+        if (lg < 4 && H5Tget_precision(type_id) == 8 * size && H5Tget_offset(type_id) == 0) {
+            *idx      = 2 * lg + (H5Tget_sign(type_id) == H5T_SGN_NONE);
+            ret_value = TRUE;
+        }
+    }
+    else if (tclass == H5T_FLOAT) {
+        if (H5Tequal(type_id, H5T_IEEE_F32LE) > 0 || H5Tequal(type_id, H5T_IEEE_F32BE) > 0) {
+            *idx      = 8;
+            ret_value = TRUE;
+        }
+        else if (H5Tequal(type_id, H5T_IEEE_F64LE) > 0 || H5Tequal(type_id, H5T_IEEE_F64BE) > 0) {
+            *idx      = 9;
+            ret_value = TRUE;
+        }
+    }
+    if (ret_value)
+        *swap = size > 1 && H5Tget_order(type_id) != H5Tget_order(H5T_NATIVE_INT);
+
+    if (super_id >= 0)
+        H5Tclose(super_id);
+
+    return ret_value;
+} /* end H5VL__pdc_conv_type() */
+
+/*---------------------------------------------------------------------------*/
+/* Set up the conversion of elements from datatype src_id to datatype dst_id.
+ * Returns FALSE, and leaves conv empty, when the elements are copied as they
+ * are: the datatypes share their layout, or one of them is not numeric. */
+hbool_t
+H5VL__pdc_conv_init(hid_t src_id, hid_t dst_id, H5VL_pdc_conv_t *conv)
+{
+    int src_idx, dst_idx;
+
+    memset(conv, 0, sizeof(*conv));
+    if (src_id <= 0 || dst_id <= 0 || H5Tequal(src_id, dst_id) != FALSE)
+        return FALSE;
+    if (!H5VL__pdc_conv_type(src_id, &src_idx, &conv->src_swap) ||
+        !H5VL__pdc_conv_type(dst_id, &dst_idx, &conv->dst_swap))
+        return FALSE;
+
+    // Enumerations are not converted into floats or back, as in HDF5
+    if ((src_idx == dst_idx && conv->src_swap == conv->dst_swap) ||
+        ((src_idx >= 8 || dst_idx >= 8) &&
+         (H5Tget_class(src_id) == H5T_ENUM || H5Tget_class(dst_id) == H5T_ENUM))) {
+        memset(conv, 0, sizeof(*conv));
+        return FALSE;
+    }
+
+    if (src_idx != dst_idx)
+        conv->func = conv_kernels_g[src_idx][dst_idx];
+    conv->src_size = H5Tget_size(src_id);
+    conv->dst_size = H5Tget_size(dst_id);
+
+    return TRUE;
+} /* end H5VL__pdc_conv_init() */
+
+/*---------------------------------------------------------------------------*/
+/* Reverse the bytes of n elements of the given size in place */
+static void
+H5VL__pdc_conv_swap(void *buf, size_t size, size_t n)
+{
+    size_t i;
+
+    if (size == 2) {
+        uint16_t *p = (uint16_t *)buf;
+
+        for (i = 0; i < n; i++)
+            p[i] = (uint16_t)(p[i] << 8 | p[i] >> 8);
+    }
+    else if (size == 4) {
+        uint32_t *p = (uint32_t *)buf;
+
+        for (i = 0; i < n; i++)
+            p[i] = p[i] << 24 | (p[i] & 0xff00) << 8 | (p[i] >> 8 & 0xff00) | p[i] >> 24;
+    }
+    else if (size == 8) {
+        uint64_t *p = (uint64_t *)buf;
+
+        for (i = 0; i < n; i++) {
+            p[i] = (p[i] & 0x00000000ffffffffULL) << 32 | (p[i] & 0xffffffff00000000ULL) >> 32;
+            p[i] = (p[i] & 0x0000ffff0000ffffULL) << 16 | (p[i] & 0xffff0000ffff0000ULL) >> 16;
+            p[i] = (p[i] & 0x00ff00ff00ff00ffULL) << 8 | (p[i] & 0xff00ff00ff00ff00ULL) >> 8;
+        }
+    }
+} /* end H5VL__pdc_conv_swap() */
+
+/*---------------------------------------------------------------------------*/
+/* Convert n elements from src into dst, CONV_BATCH elements at a time: a
+ * source in foreign byte order is swapped into a bounded buffer first, and a
+ * destination in foreign byte order is swapped in place after the kernel */
+void
+H5VL__pdc_conv_run(const H5VL_pdc_conv_t *conv, void *dst, const void *src, size_t n)
+{
+    uint64_t    tmp[H5VL_PDC_CONV_BATCH];
+    const char *in;
+    char *      out;
+    size_t      b, nb;
+
+    for (b = 0; b < n; b += nb) {
+        nb  = n - b < H5VL_PDC_CONV_BATCH ? n - b : H5VL_PDC_CONV_BATCH;
+        in  = (const char *)src + b * conv->src_size;
+        out = (char *)dst + b * conv->dst_size;
+        if (conv->src_swap) {
+            memcpy(tmp, in, nb * conv->src_size);
+            H5VL__pdc_conv_swap(tmp, conv->src_size, nb);
+            in = (const char *)tmp;
+        }
+        if (conv->func)
+            conv->func(out, in, nb);
+        else
+            memcpy(out, in, nb * conv->dst_size);
+        if (conv->dst_swap)
+            H5VL__pdc_conv_swap(out, conv->dst_size, nb);
+    }
+} /* end H5VL__pdc_conv_run() */
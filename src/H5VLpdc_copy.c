@@ -0,0 +1,316 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The staging copy engine of the PDC VOL connector
+ */
+#include "H5VLpdc_private.h"
+
+/* External headers needed by this file */
+#include "mercury_thread.h"
+#include "mercury_thread_condition.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef ENABLE_LOGGING
+#include <stdio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Staging copy engine: with H5VL_PDC_COPY_AUTO, copies use non-temporal stores
+ * from STREAM_MIN bytes and are split across the copy threads from
+ * PARALLEL_MIN bytes, in parts of at least PART_MIN bytes */
+#define H5VL_PDC_COPY_STREAM_MIN   (4 * 1048576)
+#define H5VL_PDC_COPY_PARALLEL_MIN (32 * 1048576)
+#define H5VL_PDC_COPY_PART_MIN     (4 * 1048576)
+#define H5VL_PDC_COPY_THREADS      4
+#define H5VL_PDC_COPY_MAX_THREADS  64
+
+/* Environment variables overriding the copy engine defaults */
+#define H5VL_PDC_COPY_ENV         "HDF5_VOL_PDC_COPY"
+#define H5VL_PDC_COPY_THREADS_ENV "HDF5_VOL_PDC_COPY_THREADS"
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Staging copy engine, shared by all files; one parallel copy runs at a time */
+typedef struct H5VL_pdc_copy_t {
+    hbool_t              init;     /* Whether the settings were resolved */
+    H5VL_pdc_copy_mode_t mode;     /* Copy strategy */
+    unsigned             nthreads; /* Worker threads to use, the caller copies a part as well */
+    unsigned             nrunning; /* Worker threads started */
+    hg_thread_t          threads[H5VL_PDC_COPY_MAX_THREADS];
+    hg_thread_cond_t     work;     /* Signaled when a copy is posted or on shutdown */
+    hg_thread_cond_t     done;     /* Signaled when the last part of a copy is done */
+    hbool_t              shutdown; /* Asks the worker threads to exit */
+    hbool_t              busy;     /* A parallel copy is posted */
+    char *               dst;      /* Posted copy, split in nparts parts of part bytes */
+    const char *         src;
+    size_t               size;
+    size_t               part;
+    unsigned             nparts;
+    unsigned             next;  /* Next part to be taken */
+    unsigned             ndone; /* Parts completed */
+    uint64_t             ncopy[H5VL_PDC_COPY_PARALLEL + 1]; /* Copies made with each strategy */
+} H5VL_pdc_copy_t;
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static void                  H5VL__pdc_copy_init(void);
+static void                  H5VL__pdc_copy_stream(void *dst, const void *src, size_t size);
+static void                  H5VL__pdc_copy_run_part(void);
+static void                  H5VL__pdc_copy_stop(void);
+static HG_THREAD_RETURN_TYPE H5VL__pdc_copy_thread(void *arg);
+
+/*******************/
+/* Local variables */
+/*******************/
+
+/* Staging copy engine, may be configured before the connector is initialized */
+static H5VL_pdc_copy_t   copy_g;
+static hg_thread_mutex_t copy_lock_g = HG_THREAD_MUTEX_INITIALIZER;
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5VLpdc_set_copy(H5VL_pdc_copy_mode_t mode, unsigned nthreads)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    if (mode != H5VL_PDC_COPY_AUTO && mode != H5VL_PDC_COPY_MEMCPY && mode != H5VL_PDC_COPY_STREAM &&
+        mode != H5VL_PDC_COPY_PARALLEL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid copy mode");
+
+    /* Workers are started again with the new count on the next parallel copy */
+    H5VL__pdc_copy_stop();
+
+    hg_thread_mutex_lock(&copy_lock_g);
+    H5VL__pdc_copy_init();
+    copy_g.mode     = mode;
+    copy_g.nthreads = nthreads < H5VL_PDC_COPY_MAX_THREADS ? nthreads : H5VL_PDC_COPY_MAX_THREADS;
+    hg_thread_mutex_unlock(&copy_lock_g);
+
+done:
+    FUNC_LEAVE_VOL
+} /* end H5VLpdc_set_copy() */
+
+
+/*---------------------------------------------------------------------------*/
+/* Resolve the copy engine settings on first use, must be called with the copy lock */
+static void
+H5VL__pdc_copy_init(void)
+{
+    const char *env;
+
+    if (copy_g.init)
+        return;
+
+    copy_g.mode     = H5VL_PDC_COPY_AUTO;
+    copy_g.nthreads = H5VL_PDC_COPY_THREADS;
+    if ((env = getenv(H5VL_PDC_COPY_ENV)) != NULL) {
+        if (strcmp(env, "memcpy") == 0)
+            copy_g.mode = H5VL_PDC_COPY_MEMCPY;
+        else if (strcmp(env, "stream") == 0)
+            copy_g.mode = H5VL_PDC_COPY_STREAM;
+        else if (strcmp(env, "parallel") == 0)
+            copy_g.mode = H5VL_PDC_COPY_PARALLEL;
+    }
+    if ((env = getenv(H5VL_PDC_COPY_THREADS_ENV)) != NULL && atoi(env) >= 0)
+        copy_g.nthreads = (unsigned)atoi(env);
+    if (copy_g.nthreads > H5VL_PDC_COPY_MAX_THREADS)
+        copy_g.nthreads = H5VL_PDC_COPY_MAX_THREADS;
+
+    hg_thread_cond_init(&copy_g.work);
+    hg_thread_cond_init(&copy_g.done);
+    copy_g.init = TRUE;
+} /* end H5VL__pdc_copy_init() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy with non-temporal stores, so that staged data we won't read again
+ * does not evict the application's working set from the caches */
+static void
+H5VL__pdc_copy_stream(void *dst, const void *src, size_t size)
+{
+#ifdef __SSE2__
+    char *      d    = (char *)dst;
+    const char *s    = (const char *)src;
+    size_t      head = (16 - ((uintptr_t)d & 15)) & 15;
+
+    if (size < head + 64) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+    for (; size >= 64; d += 64, s += 64, size -= 64) {
+        __m128i a = _mm_loadu_si128((const __m128i *)s);
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(s + 32));
+        __m128i e = _mm_loadu_si128((const __m128i *)(s + 48));
+
+        _mm_stream_si128((__m128i *)d, a);
+        _mm_stream_si128((__m128i *)(d + 16), b);
+        _mm_stream_si128((__m128i *)(d + 32), c);
+        _mm_stream_si128((__m128i *)(d + 48), e);
+    }
+    memcpy(d, s, size);
+
+    /* Make the streamed data visible before the buffer is handed on */
+    _mm_sfence();
+#else
+    memcpy(dst, src, size);
+#endif
+} /* end H5VL__pdc_copy_stream() */
+
+/*---------------------------------------------------------------------------*/
+/* Take the next part of the posted copy and copy it, must be called with the
+ * copy lock, which is released during the copy */
+static void
+H5VL__pdc_copy_run_part(void)
+{
+    size_t      off = (size_t)copy_g.next++ * copy_g.part;
+    size_t      len = copy_g.size - off < copy_g.part ? copy_g.size - off : copy_g.part;
+    char *      dst = copy_g.dst;
+    const char *src = copy_g.src;
+
+    hg_thread_mutex_unlock(&copy_lock_g);
+    H5VL__pdc_copy_stream(dst + off, src + off, len);
+    hg_thread_mutex_lock(&copy_lock_g);
+
+    if (++copy_g.ndone == copy_g.nparts)
+        hg_thread_cond_signal(&copy_g.done);
+} /* end H5VL__pdc_copy_run_part() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy a user buffer into a staging buffer, picking the strategy by size
+ * unless one is forced. Parallel copies are split between the caller and the
+ * copy threads, which are started on first use; a copy that finds another
+ * one in progress streams on its own. */
+void
+H5VL__pdc_copy(void *dst, const void *src, size_t size)
+{
+    H5VL_pdc_copy_mode_t mode;
+    size_t               nparts;
+
+    hg_thread_mutex_lock(&copy_lock_g);
+    H5VL__pdc_copy_init();
+
+    if ((mode = copy_g.mode) == H5VL_PDC_COPY_AUTO)
+        mode = size >= H5VL_PDC_COPY_PARALLEL_MIN
+                   ? H5VL_PDC_COPY_PARALLEL
+                   : (size >= H5VL_PDC_COPY_STREAM_MIN ? H5VL_PDC_COPY_STREAM : H5VL_PDC_COPY_MEMCPY);
+
+    if (mode == H5VL_PDC_COPY_PARALLEL && !copy_g.busy) {
+        while (copy_g.nrunning < copy_g.nthreads &&
+               hg_thread_create(&copy_g.threads[copy_g.nrunning], H5VL__pdc_copy_thread, NULL) == 0)
+            copy_g.nrunning++;
+    }
+    nparts = size / H5VL_PDC_COPY_PART_MIN;
+    if (nparts > copy_g.nrunning + 1)
+        nparts = copy_g.nrunning + 1;
+    if (mode == H5VL_PDC_COPY_PARALLEL && (copy_g.busy || nparts < 2))
+        mode = H5VL_PDC_COPY_STREAM;
+    copy_g.ncopy[mode]++;
+
+    if (mode != H5VL_PDC_COPY_PARALLEL) {
+        hg_thread_mutex_unlock(&copy_lock_g);
+        if (mode == H5VL_PDC_COPY_STREAM)
+            H5VL__pdc_copy_stream(dst, src, size);
+        else
+            memcpy(dst, src, size);
+        return;
+    }
+
+    /* Post the copy in cache line multiples and take parts until none is left */
+    copy_g.busy   = TRUE;
+    copy_g.dst    = (char *)dst;
+    copy_g.src    = (const char *)src;
+    copy_g.size   = size;
+    copy_g.part   = ((size + nparts - 1) / nparts + 63) & ~(size_t)63;
+    copy_g.nparts = (unsigned)((size + copy_g.part - 1) / copy_g.part);
+    copy_g.next   = 0;
+    copy_g.ndone  = 0;
+    hg_thread_cond_broadcast(&copy_g.work);
+
+    while (copy_g.next < copy_g.nparts)
+        H5VL__pdc_copy_run_part();
+    while (copy_g.ndone < copy_g.nparts)
+        hg_thread_cond_wait(&copy_g.done, &copy_lock_g);
+    copy_g.busy = FALSE;
+
+    hg_thread_mutex_unlock(&copy_lock_g);
+} /* end H5VL__pdc_copy() */
+
+/*---------------------------------------------------------------------------*/
+/* Stop the copy threads, they are started again by the next parallel copy */
+static void
+H5VL__pdc_copy_stop(void)
+{
+    unsigned i, nrunning;
+
+    hg_thread_mutex_lock(&copy_lock_g);
+    nrunning        = copy_g.nrunning;
+    copy_g.shutdown = TRUE;
+    if (nrunning > 0)
+        hg_thread_cond_broadcast(&copy_g.work);
+    hg_thread_mutex_unlock(&copy_lock_g);
+
+    for (i = 0; i < nrunning; i++)
+        hg_thread_join(copy_g.threads[i]);
+
+    hg_thread_mutex_lock(&copy_lock_g);
+    copy_g.nrunning = 0;
+    copy_g.shutdown = FALSE;
+    hg_thread_mutex_unlock(&copy_lock_g);
+} /* end H5VL__pdc_copy_stop() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy thread: takes parts of the posted copy until asked to exit */
+static HG_THREAD_RETURN_TYPE
+H5VL__pdc_copy_thread(void H5VL_ATTR_UNUSED *arg)
+{
+    hg_thread_ret_t ret_value = 0;
+
+    hg_thread_mutex_lock(&copy_lock_g);
+    for (;;) {
+        while (!copy_g.shutdown && !(copy_g.busy && copy_g.next < copy_g.nparts))
+            hg_thread_cond_wait(&copy_g.work, &copy_lock_g);
+        if (!(copy_g.busy && copy_g.next < copy_g.nparts))
+            break;
+        H5VL__pdc_copy_run_part();
+    }
+    hg_thread_mutex_unlock(&copy_lock_g);
+
+    return ret_value;
+} /* end H5VL__pdc_copy_thread() */
+
+
+/*---------------------------------------------------------------------------*/
+/* Stop the copy threads when the connector is terminated */
+void
+H5VL__pdc_copy_term(void)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: staging copies %lu memcpy, %lu stream, %lu parallel\n", my_rank_g,
+            copy_g.ncopy[H5VL_PDC_COPY_MEMCPY], copy_g.ncopy[H5VL_PDC_COPY_STREAM],
+            copy_g.ncopy[H5VL_PDC_COPY_PARALLEL]);
+#endif
+    H5VL__pdc_copy_stop();
+} /* end H5VL__pdc_copy_term() */
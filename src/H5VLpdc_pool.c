@@ -0,0 +1,249 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The staging buffer pool of the PDC VOL connector
+ */
+#include "H5VLpdc_private.h"
+
+/* External headers needed by this file */
+#include "mercury_thread_mutex.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+#ifdef ENABLE_LOGGING
+#include <stdio.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Staging buffer pool: size classes cover (2^e, 2^(e+1)] in four steps from
+ * 4 KiB up to 1 TiB, larger buffers are not pooled */
+#define H5VL_PDC_POOL_MIN_SHIFT 12
+#define H5VL_PDC_POOL_MAX_SHIFT 40
+#define H5VL_PDC_POOL_NCLASS    (4 * (H5VL_PDC_POOL_MAX_SHIFT - H5VL_PDC_POOL_MIN_SHIFT) + 1)
+#define H5VL_PDC_HUGEPAGE_SIZE  (2 * 1048576)
+
+/* Environment variables overriding the staging buffer pool defaults */
+#define H5VL_PDC_POOL_CAP_ENV      "HDF5_VOL_PDC_POOL_CAP"
+#define H5VL_PDC_POOL_HUGEPAGE_ENV "HDF5_VOL_PDC_POOL_HUGEPAGE"
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Free staging buffers retained for reuse, shared by all files */
+typedef struct H5VL_pdc_pool_t {
+    hbool_t  init;                          /* Whether the settings were resolved */
+    hbool_t  hugepage;                      /* Back large buffers with transparent huge pages */
+    size_t   cap;                           /* Upper bound of retained bytes */
+    size_t   retained;                      /* Bytes currently held in the free lists */
+    void *   free_list[H5VL_PDC_POOL_NCLASS]; /* Free buffers, linked through their first word */
+    uint64_t nhit;                          /* Allocations served from a free list */
+    uint64_t nmiss;                         /* Allocations that went to the system */
+} H5VL_pdc_pool_t;
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static void H5VL__pdc_pool_init(void);
+static int  H5VL__pdc_pool_class(size_t size, size_t *class_size);
+
+/*******************/
+/* Local variables */
+/*******************/
+
+/* Staging buffer pool, may be configured before the connector is initialized */
+static H5VL_pdc_pool_t   pool_g;
+static hg_thread_mutex_t pool_lock_g = HG_THREAD_MUTEX_INITIALIZER;
+
+/*---------------------------------------------------------------------------*/
+herr_t
+H5VLpdc_set_pool(size_t retain_cap, hbool_t hugepage)
+{
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    hg_thread_mutex_lock(&pool_lock_g);
+    H5VL__pdc_pool_init();
+    pool_g.cap      = retain_cap;
+    pool_g.hugepage = hugepage;
+    hg_thread_mutex_unlock(&pool_lock_g);
+
+    /* Apply a lower cap right away */
+    H5VL__pdc_pool_trim(retain_cap);
+
+    FUNC_LEAVE_VOL
+} /* end H5VLpdc_set_pool() */
+
+
+/*---------------------------------------------------------------------------*/
+size_t
+H5VLpdc_trim_pool(size_t keep)
+{
+    return H5VL__pdc_pool_trim(keep);
+} /* end H5VLpdc_trim_pool() */
+
+
+/*---------------------------------------------------------------------------*/
+/* Resolve the pool settings on first use, must be called with the pool lock */
+static void
+H5VL__pdc_pool_init(void)
+{
+    const char *env;
+
+    if (pool_g.init)
+        return;
+
+    /* By default retain as much as one full write cache */
+    pool_g.cap      = (size_t)MAX_WRITE_CACHE_SIZE_GB * 1073741824llu;
+    pool_g.hugepage = FALSE;
+    if ((env = getenv(H5VL_PDC_POOL_CAP_ENV)) != NULL)
+        pool_g.cap = H5VL__pdc_parse_size(env);
+    if ((env = getenv(H5VL_PDC_POOL_HUGEPAGE_ENV)) != NULL)
+        pool_g.hugepage = atoi(env) != 0;
+    pool_g.init = TRUE;
+} /* end H5VL__pdc_pool_init() */
+
+/*---------------------------------------------------------------------------*/
+/* Get the size class of an allocation and the size actually allocated for
+ * it, or -1 if it is too large to be pooled */
+static int
+H5VL__pdc_pool_class(size_t size, size_t *class_size)
+{
+    size_t step;
+    int    e, m;
+
+    if (size <= ((size_t)1 << H5VL_PDC_POOL_MIN_SHIFT)) {
+        *class_size = (size_t)1 << H5VL_PDC_POOL_MIN_SHIFT;
+        return 0;
+    }
+
+    /* 2^e < size <= 2^(e+1), rounded up to a quarter of 2^e */
+    e = 63 - __builtin_clzll((unsigned long long)(size - 1));
+    if (e >= H5VL_PDC_POOL_MAX_SHIFT)
+        return -1;
+    step        = (size_t)1 << (e - 2);
+    m           = (int)((size + step - 1) / step);
+    *class_size = (size_t)m * step;
+
+    return 4 * (e - H5VL_PDC_POOL_MIN_SHIFT) + (m - 5) + 1;
+} /* end H5VL__pdc_pool_class() */
+
+/*---------------------------------------------------------------------------*/
+/* Get a staging buffer of at least size bytes, to be returned with
+ * H5VL__pdc_pool_free() and the same size */
+void *
+H5VL__pdc_pool_alloc(size_t size)
+{
+    void *  buf = NULL;
+    size_t  class_size;
+    hbool_t hugepage;
+    int     c;
+
+    if ((c = H5VL__pdc_pool_class(size, &class_size)) < 0)
+        return malloc(size);
+
+    hg_thread_mutex_lock(&pool_lock_g);
+    H5VL__pdc_pool_init();
+    if ((buf = pool_g.free_list[c]) != NULL) {
+        pool_g.free_list[c] = *(void **)buf;
+        pool_g.retained -= class_size;
+        pool_g.nhit++;
+    }
+    else
+        pool_g.nmiss++;
+    hugepage = pool_g.hugepage;
+    hg_thread_mutex_unlock(&pool_lock_g);
+
+    if (buf == NULL) {
+        if (hugepage && class_size >= H5VL_PDC_HUGEPAGE_SIZE) {
+            if (posix_memalign(&buf, H5VL_PDC_HUGEPAGE_SIZE, class_size) != 0)
+                return NULL;
+#ifdef MADV_HUGEPAGE
+            madvise(buf, class_size, MADV_HUGEPAGE);
+#endif
+        }
+        else
+            buf = malloc(class_size);
+    }
+
+    return buf;
+} /* end H5VL__pdc_pool_alloc() */
+
+/*---------------------------------------------------------------------------*/
+/* Return a staging buffer to the pool, or to the system once the pool holds
+ * its cap */
+void
+H5VL__pdc_pool_free(void *buf, size_t size)
+{
+    size_t class_size;
+    int    c;
+
+    if (buf == NULL)
+        return;
+    if ((c = H5VL__pdc_pool_class(size, &class_size)) < 0) {
+        free(buf);
+        return;
+    }
+
+    hg_thread_mutex_lock(&pool_lock_g);
+    H5VL__pdc_pool_init();
+    if (pool_g.retained + class_size <= pool_g.cap) {
+        *(void **)buf       = pool_g.free_list[c];
+        pool_g.free_list[c] = buf;
+        pool_g.retained += class_size;
+        buf = NULL;
+    }
+    hg_thread_mutex_unlock(&pool_lock_g);
+
+    free(buf);
+} /* end H5VL__pdc_pool_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Give retained buffers back to the system, largest first, until at most
+ * keep bytes are retained; returns the number of bytes released */
+size_t
+H5VL__pdc_pool_trim(size_t keep)
+{
+    size_t released = 0, class_size;
+    void * buf;
+    int    c;
+
+    hg_thread_mutex_lock(&pool_lock_g);
+    for (c = H5VL_PDC_POOL_NCLASS - 1; c >= 0 && pool_g.retained > keep; c--) {
+        if (c == 0)
+            class_size = (size_t)1 << H5VL_PDC_POOL_MIN_SHIFT;
+        else
+            class_size = ((size_t)1 << (H5VL_PDC_POOL_MIN_SHIFT + (c - 1) / 4 - 2)) * (5 + (c - 1) % 4);
+        while ((buf = pool_g.free_list[c]) != NULL && pool_g.retained > keep) {
+            pool_g.free_list[c] = *(void **)buf;
+            pool_g.retained -= class_size;
+            released += class_size;
+            free(buf);
+        }
+    }
+    hg_thread_mutex_unlock(&pool_lock_g);
+
+    return released;
+} /* end H5VL__pdc_pool_trim() */
+
+
+/*---------------------------------------------------------------------------*/
+/* Release the retained staging buffers when the connector is terminated */
+void
+H5VL__pdc_pool_term(void)
+{
+#ifdef ENABLE_LOGGING
+    fprintf(stderr, "Rank %d: staging pool %lu hits, %lu misses\n", my_rank_g, pool_g.nhit, pool_g.nmiss);
+#endif
+    H5VL__pdc_pool_trim(0);
+} /* end H5VL__pdc_pool_term() */
@@ -0,0 +1,149 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Definitions shared by the source files of the PDC VOL connector
+ */
+#ifndef H5VLpdc_private_H
+#define H5VLpdc_private_H
+
+/* Include package's header */
+#include "H5VLpdc.h"
+
+#include "hdf5.h"
+#include "H5VLerror.h"
+#include "pdc.h"
+
+#include <stdint.h>
+
+/**********/
+/* Macros */
+/**********/
+
+#define ADDR_MAX              256
+#define H5VL_PDC_SEQ_LIST_LEN 128 /* Sequences fetched at a time when walking a selection */
+#define H5VL_PDC_MAX_RANK     4
+#define H5VL_PDC_MAX_BOXES    64
+
+#ifdef PDC_VOL_WRITE_CACHE_MAX_GB
+#define MAX_WRITE_CACHE_SIZE_GB PDC_VOL_WRITE_CACHE_MAX_GB
+#else
+#define MAX_WRITE_CACHE_SIZE_GB 1
+#endif
+
+/* Datatype conversion: elements are byte swapped through a buffer of
+ * CONV_BATCH elements */
+#define H5VL_PDC_CONV_BATCH 512
+
+/* (Uncomment to enable) */
+/* #define ENABLE_LOGGING */
+
+/* Remove warnings when connector does not use callback arguments */
+#if defined(__cplusplus)
+#define H5VL_ATTR_UNUSED
+#elif defined(__GNUC__) && (__GNUC__ >= 4)
+#define H5VL_ATTR_UNUSED __attribute__((unused))
+#else
+#define H5VL_ATTR_UNUSED
+#endif
+
+/****************************/
+/* Type and Struct Definition */
+/****************************/
+
+/* Block of a dataspace selection, and where its elements sit in the packed
+ * buffer of the selection, which holds the selected elements in row-major order */
+typedef struct H5VL_pdc_block_t {
+    int      ndim;
+    uint64_t offset[H5VL_PDC_MAX_RANK];
+    uint64_t count[H5VL_PDC_MAX_RANK];
+    uint64_t base;                     /* Packed index of the first element */
+    uint64_t pitch[H5VL_PDC_MAX_RANK]; /* Packed index step along each dimension with a count above 1 */
+} H5VL_pdc_block_t;
+
+/* Element of a point selection, by its linear index in the dataspace and its
+ * position in the selection */
+typedef struct H5VL_pdc_point_t {
+    uint64_t lin;
+    uint64_t pos;
+} H5VL_pdc_point_t;
+
+/* Memory selection, as the runs of bytes it covers in the user buffer in
+ * selection order: run i holds the bytes from pos[i] to pos[i + 1] of the
+ * packed selection, at off[i] in buf */
+typedef struct H5VL_pdc_memmap_t {
+    char *    buf;
+    size_t    nrun;
+    uint64_t *pos;  /* nrun + 1 packed byte positions */
+    uint64_t *off;  /* nrun byte offsets in buf */
+    size_t    hint; /* Run found by the last lookup */
+} H5VL_pdc_memmap_t;
+
+/* Datatype conversion kernel, converts n elements from src into dst */
+typedef void (*H5VL_pdc_conv_func_t)(void *dst, const void *src, size_t n);
+
+/* Conversion of the elements of a transfer between two numeric datatypes */
+typedef struct H5VL_pdc_conv_t {
+    H5VL_pdc_conv_func_t func;     /* Kernel, NULL when the elements are only byte swapped */
+    size_t               src_size; /* Size of a source element, 0 when nothing is converted */
+    size_t               dst_size; /* Size of a destination element */
+    hbool_t              src_swap; /* Whether the source is not in native byte order */
+    hbool_t              dst_swap; /* Whether the destination is not in native byte order */
+} H5VL_pdc_conv_t;
+
+/*************/
+/* Variables */
+/*************/
+
+/* Error stack declarations */
+extern hid_t H5VL_ERR_STACK_g;
+extern hid_t H5VL_ERR_CLS_g;
+
+/* Rank printed by the log messages */
+extern int my_rank_g;
+
+/**************/
+/* Prototypes */
+/**************/
+
+/* Property list helpers (H5VLpdc.c) */
+size_t H5VL__pdc_parse_size(const char *str);
+
+/* Staging buffer pool (H5VLpdc_pool.c) */
+void * H5VL__pdc_pool_alloc(size_t size);
+void   H5VL__pdc_pool_free(void *buf, size_t size);
+size_t H5VL__pdc_pool_trim(size_t keep);
+void   H5VL__pdc_pool_term(void);
+
+/* Staging copy engine (H5VLpdc_copy.c) */
+void H5VL__pdc_copy(void *dst, const void *src, size_t size);
+void H5VL__pdc_copy_term(void);
+
+/* Selections (H5VLpdc_sel.c) */
+herr_t  H5VL__pdc_sel_blocks(hid_t space_id, H5VL_pdc_block_t **blocks, size_t *nblocks, uint64_t **perm);
+hbool_t H5VL__pdc_block_dense(const H5VL_pdc_block_t *blk);
+void    H5VL__pdc_block_scale(H5VL_pdc_block_t *blocks, size_t nblocks, size_t elem);
+herr_t  H5VL__pdc_memmap_build(hid_t space_id, void *buf, size_t elem, const uint64_t *perm,
+                               H5VL_pdc_memmap_t *map);
+void    H5VL__pdc_memmap_free(H5VL_pdc_memmap_t *map);
+void *  H5VL__pdc_memmap_addr(H5VL_pdc_memmap_t *map, uint64_t pos, uint64_t len);
+void    H5VL__pdc_memmap_copy(H5VL_pdc_memmap_t *map, const H5VL_pdc_block_t *blk, size_t elem, void *buf,
+                              const uint64_t *stride, const H5VL_pdc_conv_t *conv, hbool_t to_mem);
+herr_t  H5VL__pdc_block_split(H5VL_pdc_memmap_t *map, const H5VL_pdc_block_t *blk, size_t elem,
+                              size_t min_size, H5VL_pdc_block_t **pieces, size_t *npieces);
+herr_t  H5VL__pdc_block_split_all(H5VL_pdc_memmap_t *map, H5VL_pdc_block_t **blocks, size_t *nblocks,
+                                  size_t elem);
+size_t  H5VL__pdc_slab_min(void);
+
+/* Datatype conversion (H5VLpdc_conv.c) */
+hbool_t H5VL__pdc_conv_init(hid_t src_id, hid_t dst_id, H5VL_pdc_conv_t *conv);
+void    H5VL__pdc_conv_run(const H5VL_pdc_conv_t *conv, void *dst, const void *src, size_t n);
+
+#endif /* H5VLpdc_private_H */
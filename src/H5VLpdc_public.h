@@ -22,6 +22,60 @@
 /* Public headers needed by this file */
 #include <hdf5.h>
 
+/* How H5Dwrite hands the user buffer to the connector */
+typedef enum H5VL_pdc_buf_mode_t {
+    H5VL_PDC_BUF_COPY = 0, /* Copy the buffer into the write cache (default) */
+    H5VL_PDC_BUF_TRANSFER, /* The connector takes ownership and releases the buffer */
+    H5VL_PDC_BUF_STABLE    /* The buffer stays valid and unchanged until the next flush point */
+} H5VL_pdc_buf_mode_t;
+
+/* Called once the connector no longer needs a buffer given to H5Dwrite */
+typedef void (*H5VL_pdc_buf_release_t)(void *buf, void *ctx);
+
+/* Which deferred writes a read waits for */
+typedef enum H5VL_pdc_consistency_t {
+    H5VL_PDC_CONSISTENCY_STRICT = 0, /* Every deferred write of the file (default) */
+    H5VL_PDC_CONSISTENCY_OVERLAP     /* Only deferred writes intersecting the read selection */
+} H5VL_pdc_consistency_t;
+
+/* How write data is copied into the write cache */
+typedef enum H5VL_pdc_copy_mode_t {
+    H5VL_PDC_COPY_AUTO = 0, /* Pick one of the strategies below by size (default) */
+    H5VL_PDC_COPY_MEMCPY,   /* Plain memcpy() on the calling thread */
+    H5VL_PDC_COPY_STREAM,   /* Non-temporal stores on the calling thread */
+    H5VL_PDC_COPY_PARALLEL  /* Non-temporal stores split across the copy threads */
+} H5VL_pdc_copy_mode_t;
+
+/* I/O statistics of a file, see H5VLpdc_get_stats() */
+typedef struct H5VL_pdc_stats_t {
+    uint64_t bytes_in;     /* Bytes buffered by the write cache */
+    uint64_t bytes_out;    /* Bytes released from the write cache after their transfer completed */
+    uint64_t nflush;       /* Number of write cache flushes triggered by the high watermark */
+    uint64_t nreq;         /* Number of deferred write requests */
+    uint64_t nxfer;        /* Number of region transfers issued for deferred writes */
+    uint64_t nmerge;       /* Number of deferred writes merged into a neighbouring one */
+    uint64_t nhit;         /* Reads fully served from deferred writes */
+    uint64_t npartial;     /* Reads partly served from deferred writes */
+    uint64_t nmiss;        /* Reads not served from deferred writes at all */
+    uint64_t hit_bytes;    /* Bytes copied from deferred writes into read buffers */
+    uint64_t nchunked;     /* Reads and writes transferred as several sub-regions */
+    uint64_t nagg;         /* Blocks written on behalf of other ranks by this aggregator */
+    uint64_t nprefetch;    /* Blocks read ahead from the next timestep */
+    uint64_t nra_hit;      /* Reads served from blocks read ahead */
+    uint64_t nrc_hit;      /* Reads fully served from the read cache */
+    uint64_t nrc_partial;  /* Reads partly served from the read cache */
+    uint64_t nrc_miss;     /* Reads of datasets using the read cache not served from it at all */
+    uint64_t rc_hit_bytes; /* Bytes copied from the read cache into read buffers */
+    uint64_t nsieve;       /* Reads of sparse selections made as their bounding box */
+    uint64_t sieve_bytes;  /* Bytes read by them outside of the selection */
+    uint64_t nmeta_hit;    /* Dataset opens served from the metadata cache */
+    uint64_t nmeta_miss;   /* Dataset opens that looked the object up on the servers */
+    uint64_t ncreate;      /* Dataset creates deferred to a batch */
+    uint64_t nbatch;       /* Batches the deferred creates were made in */
+    uint64_t nattr_hit;    /* Attribute gets and reads served from memory */
+    uint64_t nattr_fetch;  /* Attribute values fetched from the servers */
+} H5VL_pdc_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,6 +96,10 @@ H5VL_PDC_PUBLIC herr_t H5VLpdc_term(void);
 
 /**
  * Set the file access property list to use the given MPI communicator/info.
+ * Groups and datasets of a file opened on a communicator may be created by
+ * any of its ranks; the ranks learn of each other's links, and the file
+ * index of links is stored, at H5Fflush and H5Fclose, which every rank must
+ * call. H5Ldelete must be called by every rank for the link to go.
  *
  * @param fapl_id   [IN]    file access property list ID
  * @param comm      [IN]    MPI communicator
@@ -51,6 +109,483 @@ H5VL_PDC_PUBLIC herr_t H5VLpdc_term(void);
  */
 H5VL_PDC_PUBLIC herr_t H5Pset_fapl_pdc(hid_t fapl_id, MPI_Comm comm, MPI_Info info);
 
+/**
+ * Set the write cache budget of files opened with the given file access
+ * property list. Once more than high_pct percent of the cache is in use, the
+ * oldest deferred writes are flushed until at most low_pct percent remains.
+ * Overrides the HDF5_VOL_PDC_WRITE_CACHE_* environment variables.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param cache_size    [IN]    write cache size in bytes
+ * @param high_pct      [IN]    high watermark, in percent of cache_size
+ * @param low_pct       [IN]    low watermark, in percent of cache_size
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_write_cache(hid_t fapl_id, size_t cache_size, unsigned high_pct,
+                                              unsigned low_pct);
+
+/**
+ * Get the write cache settings that apply to the given file access property
+ * list, including defaults and environment overrides.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param cache_size    [OUT]   write cache size in bytes
+ * @param high_pct      [OUT]   high watermark, in percent of cache_size
+ * @param low_pct       [OUT]   low watermark, in percent of cache_size
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_write_cache(hid_t fapl_id, size_t *cache_size, unsigned *high_pct,
+                                              unsigned *low_pct);
+
+/**
+ * Set how H5Dwrite calls using the given data transfer property list hand
+ * their buffer to the connector. With H5VL_PDC_BUF_TRANSFER the connector owns
+ * the buffer and releases it with release_cb, or free() if release_cb is NULL.
+ * With H5VL_PDC_BUF_STABLE the application keeps the buffer unchanged until
+ * the next flush point (a read, a flush or the file close); release_cb, if
+ * set, is called once the buffer is no longer needed. Both modes avoid the
+ * staging copy made by the default H5VL_PDC_BUF_COPY mode.
+ *
+ * release_cb is called by the thread that completes the write. Without a
+ * flush thread, that is the application thread, from within the H5Dwrite,
+ * H5Dread, H5Fflush or H5Fclose call that completes it. With the flush thread
+ * of the file enabled (see H5Pset_pdc_flush_thread), it is that thread, while
+ * the application keeps running: release_cb must then be thread-safe and
+ * must not call the HDF5 library.
+ *
+ * @param dxpl_id       [IN]    data transfer property list ID
+ * @param mode          [IN]    buffer handling mode
+ * @param release_cb    [IN]    buffer release callback, may be NULL
+ * @param release_ctx   [IN]    user context passed to release_cb
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_write_buffer(hid_t dxpl_id, H5VL_pdc_buf_mode_t mode,
+                                               H5VL_pdc_buf_release_t release_cb, void *release_ctx);
+
+/**
+ * Get the write buffer handling mode of a data transfer property list.
+ *
+ * @param dxpl_id       [IN]    data transfer property list ID
+ * @param mode          [OUT]   buffer handling mode
+ * @param release_cb    [OUT]   buffer release callback
+ * @param release_ctx   [OUT]   user context passed to release_cb
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_write_buffer(hid_t dxpl_id, H5VL_pdc_buf_mode_t *mode,
+                                               H5VL_pdc_buf_release_t *release_cb, void **release_ctx);
+
+/**
+ * Enable or disable the background flush thread of files opened with the
+ * given file access property list. When enabled, deferred writes are started
+ * as soon as they are queued and complete while the application keeps
+ * computing; reads, flushes and file close only wait for them. Disabled by
+ * default. Overrides the HDF5_VOL_PDC_FLUSH_THREAD environment variable.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [IN]    whether to use a flush thread
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_flush_thread(hid_t fapl_id, hbool_t enable);
+
+/**
+ * Get whether files opened with the given file access property list use a
+ * background flush thread.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [OUT]   whether a flush thread is used
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_flush_thread(hid_t fapl_id, hbool_t *enable);
+
+/**
+ * Set which deferred writes a read of a file opened with the given file
+ * access property list completes first. H5VL_PDC_CONSISTENCY_STRICT completes
+ * every deferred write of the file; H5VL_PDC_CONSISTENCY_OVERLAP only
+ * completes the writes to the datasets being read whose region intersects
+ * the read selection, the others stay deferred. Overrides the
+ * HDF5_VOL_PDC_CONSISTENCY environment variable ("strict" or "overlap").
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param mode          [IN]    consistency mode
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_consistency(hid_t fapl_id, H5VL_pdc_consistency_t mode);
+
+/**
+ * Get the read-after-write consistency mode of a file access property list.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param mode          [OUT]   consistency mode
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_consistency(hid_t fapl_id, H5VL_pdc_consistency_t *mode);
+
+/**
+ * Set how reads and writes of files opened with the given file access
+ * property list are split. A request moving more than chunk_size bytes is
+ * transferred as sub-regions of at most chunk_size bytes, cut along the
+ * slowest varying dimensions, with up to window of them in flight. A large
+ * write only stages its last window sub-regions in the write cache, the
+ * others are transferred straight from the user buffer before H5Dwrite
+ * returns. Overrides the HDF5_VOL_PDC_CHUNK_SIZE and
+ * HDF5_VOL_PDC_CHUNK_WINDOW environment variables.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param chunk_size    [IN]    upper bound of the bytes moved by one transfer
+ * @param window        [IN]    number of transfers kept in flight
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_chunking(hid_t fapl_id, size_t chunk_size, unsigned window);
+
+/**
+ * Get the chunking settings that apply to the given file access property
+ * list, including defaults and environment overrides.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param chunk_size    [OUT]   upper bound of the bytes moved by one transfer
+ * @param window        [OUT]   number of transfers kept in flight
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_chunking(hid_t fapl_id, size_t *chunk_size, unsigned *window);
+
+/**
+ * Set up two-phase write aggregation for files opened with the given file
+ * access property list. The ranks of the file communicator are split into
+ * naggr groups of neighbouring ranks; in an aggregated write, every rank of
+ * a group sends its block to the first rank of the group, which merges
+ * adjacent blocks into larger regions and writes them on behalf of the
+ * group. Blocks larger than the chunk size divided by the group size are
+ * written by their own rank. With collective set, every write made with a
+ * collective MPI-IO transfer property list is aggregated. Overrides the
+ * HDF5_VOL_PDC_AGGREGATORS and HDF5_VOL_PDC_AGGREGATION environment
+ * variables.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param naggr         [IN]    number of aggregator ranks, 0 for one per 32 ranks
+ * @param collective    [IN]    whether collective transfers are aggregated
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_aggregators(hid_t fapl_id, unsigned naggr, hbool_t collective);
+
+/**
+ * Get the write aggregation settings that apply to the given file access
+ * property list, including defaults and environment overrides.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param naggr         [OUT]   number of aggregator ranks, 0 for one per 32 ranks
+ * @param collective    [OUT]   whether collective transfers are aggregated
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_aggregators(hid_t fapl_id, unsigned *naggr, hbool_t *collective);
+
+/**
+ * Set whether writes made with the given dataset transfer property list are
+ * aggregated, regardless of their MPI-IO transfer mode. An aggregated
+ * H5Dwrite must be called by every rank of the file, for the same datasets
+ * in the same order, even by ranks with nothing to write; it returns once the
+ * aggregators have written the data, and fails on every rank when it fails on
+ * one. Only blocks written from a copy of the user buffer (H5VL_PDC_BUF_COPY)
+ * are aggregated, ranks that hand their buffer over write it themselves.
+ *
+ * @param dxpl_id       [IN]    dataset transfer property list ID
+ * @param enable        [IN]    whether to aggregate
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_aggregation(hid_t dxpl_id, hbool_t enable);
+
+/**
+ * Get whether aggregation was explicitly requested on a dataset transfer
+ * property list.
+ *
+ * @param dxpl_id       [IN]    dataset transfer property list ID
+ * @param enable        [OUT]   whether to aggregate
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_aggregation(hid_t dxpl_id, hbool_t *enable);
+
+/**
+ * Set the memory budget for reading ahead in files opened with the given
+ * file access property list. When a dataset in a group whose name ends with
+ * a step number, such as "Timestep_3", is read with the same selection as in
+ * the previous step, the selection is read from the same dataset of the next
+ * step while the application works on this one, and the matching H5Dread is
+ * served from memory. The oldest blocks are dropped once max_size bytes are
+ * held; 0 disables reading ahead. Overrides the HDF5_VOL_PDC_PREFETCH_SIZE
+ * environment variable.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param max_size      [IN]    upper bound of the bytes held by blocks read ahead
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_prefetch(hid_t fapl_id, size_t max_size);
+
+/**
+ * Get the read-ahead memory budget that applies to the given file access
+ * property list, including defaults and environment overrides.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param max_size      [OUT]   upper bound of the bytes held by blocks read ahead
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_prefetch(hid_t fapl_id, size_t *max_size);
+
+/**
+ * Set how many closed datasets of files opened with the given file access
+ * property list stay in their metadata cache. The object and metadata of a
+ * dataset are shared by all its open handles, and kept once they are closed
+ * so that opening the dataset again makes no request to the servers; the
+ * least recently closed datasets are released beyond max_closed, 0 releases
+ * them at close. Overrides the HDF5_VOL_PDC_META_CACHE environment variable.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param max_closed    [IN]    upper bound of the closed datasets kept
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_meta_cache(hid_t fapl_id, unsigned max_closed);
+
+/**
+ * Get the number of closed datasets kept in the metadata cache that applies
+ * to the given file access property list, including defaults and environment
+ * overrides.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param max_closed    [OUT]   upper bound of the closed datasets kept
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_meta_cache(hid_t fapl_id, unsigned *max_closed);
+
+/**
+ * Enable or disable collective metadata for files opened with the given file
+ * access property list on an MPI communicator. Rank 0 then makes the metadata
+ * lookups of collective operations and broadcasts their results:
+ *  - H5Fopen reads the index of the groups and datasets of the file on rank 0.
+ *  - When the communicator spans all PDC clients, H5Fopen and H5Dopen open
+ *    their PDC objects collectively, and H5Dopen reads the datatype and layout
+ *    of the dataset on rank 0. H5Dopen must then be called by all ranks of the
+ *    file, for the same datasets in the same order.
+ * Attribute opens, reads and queries, and dataset opens on a smaller
+ * communicator, stay independent and make their own lookups. Overrides the
+ * HDF5_VOL_PDC_COLL_METADATA environment variable.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [IN]    whether metadata lookups are collective
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_coll_metadata(hid_t fapl_id, hbool_t enable);
+
+/**
+ * Get whether files opened with the given file access property list make
+ * their metadata lookups collectively.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [OUT]   whether metadata lookups are collective
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_coll_metadata(hid_t fapl_id, hbool_t *enable);
+
+/**
+ * Enable or disable deferred dataset creation for files opened with the given
+ * file access property list. H5Dcreate then only records the dataset, and the
+ * objects of all datasets created since are made together, back to back, by
+ * the next H5Fflush or H5Fclose, which are collective anyway. An independent
+ * operation that needs the object of a dataset still deferred, a read or
+ * write of it, an H5Dopen of it, or an attribute create or open on it, makes
+ * that object alone on the calling rank: it opens the object when another
+ * rank made it already, and creates it otherwise. Errors of the creates are
+ * reported by the call that makes them. Columnar compound datasets are always
+ * created right away. Overrides the HDF5_VOL_PDC_DEFER_CREATE environment
+ * variable.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [IN]    whether dataset creates are deferred
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_defer_create(hid_t fapl_id, hbool_t enable);
+
+/**
+ * Get whether files opened with the given file access property list defer
+ * their dataset creates.
+ *
+ * @param fapl_id       [IN]    file access property list ID
+ * @param enable        [OUT]   whether dataset creates are deferred
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_defer_create(hid_t fapl_id, hbool_t *enable);
+
+/**
+ * Hint whether datasets opened with the given dataset access property list
+ * are read through timestep groups. With enable set, every read of the
+ * dataset starts reading the same selection from the next step, without
+ * waiting for the traversal to be detected; otherwise the dataset is never
+ * read ahead.
+ *
+ * @param dapl_id       [IN]    dataset access property list ID
+ * @param enable        [IN]    whether to read ahead
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_read_ahead(hid_t dapl_id, hbool_t enable);
+
+/**
+ * Get the read-ahead hint of a dataset access property list, FALSE if none
+ * was set.
+ *
+ * @param dapl_id       [IN]    dataset access property list ID
+ * @param enable        [OUT]   whether to read ahead
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_read_ahead(hid_t dapl_id, hbool_t *enable);
+
+/**
+ * Keep the regions read from datasets opened or created with the given
+ * dataset access property list in the read cache of the process. Later reads
+ * of the dataset are served from the cached regions they intersect, and only
+ * the remaining parts are fetched from the servers. Writes to the dataset
+ * from this process drop its cached regions.
+ *
+ * @param dapl_id       [IN]    dataset access property list ID
+ * @param enable        [IN]    whether to use the read cache
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_read_cache(hid_t dapl_id, hbool_t enable);
+
+/**
+ * Get whether a dataset access property list enables the read cache, FALSE
+ * if it was not set.
+ *
+ * @param dapl_id       [IN]    dataset access property list ID
+ * @param enable        [OUT]   whether to use the read cache
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_read_cache(hid_t dapl_id, hbool_t *enable);
+
+/**
+ * Set whether a compound dataset created with the given dataset creation
+ * property list stores each of its members in a PDC object of its own. A
+ * read then only fetches the members of its memory datatype, and numeric
+ * members are stored with the PDC type of their size. Ignored for the other
+ * datatype classes.
+ *
+ * @param dcpl_id       [IN]    dataset creation property list ID
+ * @param enable        [IN]    whether to store the members apart
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pset_pdc_columnar(hid_t dcpl_id, hbool_t enable);
+
+/**
+ * Get whether a dataset creation property list stores compound members
+ * apart, FALSE if it was not set.
+ *
+ * @param dcpl_id       [IN]    dataset creation property list ID
+ * @param enable        [OUT]   whether to store the members apart
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5Pget_pdc_columnar(hid_t dcpl_id, hbool_t *enable);
+
+/**
+ * Get the I/O statistics of the file containing the given object. Writes
+ * that are still deferred are not yet counted as transfers.
+ *
+ * @param obj_id        [IN]    file or object ID
+ * @param stats         [OUT]   statistics
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5VLpdc_get_stats(hid_t obj_id, H5VL_pdc_stats_t *stats);
+
+/**
+ * Configure the pool of write cache staging buffers shared by all files.
+ * Buffers released by completed writes are kept for reuse until retain_cap
+ * bytes are retained; with hugepage set, buffers of 2 MiB and more are
+ * backed by transparent huge pages. Overrides the HDF5_VOL_PDC_POOL_CAP and
+ * HDF5_VOL_PDC_POOL_HUGEPAGE environment variables.
+ *
+ * @param retain_cap    [IN]    upper bound of retained bytes
+ * @param hugepage      [IN]    whether to use huge pages for large buffers
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5VLpdc_set_pool(size_t retain_cap, hbool_t hugepage);
+
+/**
+ * Give staging buffers retained by the pool back to the system.
+ *
+ * @param keep          [IN]    number of bytes the pool may keep retaining
+ *
+ * @returns the number of bytes released
+ */
+H5VL_PDC_PUBLIC size_t H5VLpdc_trim_pool(size_t keep);
+
+/**
+ * Select how write data is copied into the write cache. With
+ * H5VL_PDC_COPY_AUTO, small copies use memcpy(), larger ones use
+ * non-temporal stores so that the staged data does not evict the
+ * application's data from the CPU caches, and the largest ones are split
+ * between the calling thread and nthreads copy threads. Overrides the
+ * HDF5_VOL_PDC_COPY ("auto", "memcpy", "stream" or "parallel") and
+ * HDF5_VOL_PDC_COPY_THREADS environment variables.
+ *
+ * @param mode          [IN]    copy strategy
+ * @param nthreads      [IN]    number of copy threads, 0 disables parallel copies
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5VLpdc_set_copy(H5VL_pdc_copy_mode_t mode, unsigned nthreads);
+
+/**
+ * Set the memory budget of the read cache shared by all files. The least
+ * recently used regions are evicted once max_size bytes are held; 0 disables
+ * the cache. Overrides the HDF5_VOL_PDC_READ_CACHE_SIZE environment variable.
+ *
+ * @param max_size      [IN]    upper bound of the bytes held by cached regions
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5VLpdc_set_read_cache(size_t max_size);
+
+/**
+ * Set when reads of sparse selections are sieved, shared by all files. A
+ * read whose file selection is made of several regions fetches their
+ * bounding box in a single transfer, and extracts the selected elements
+ * from it, when the box is at most max_size bytes and moves fewer bytes than
+ * the regions once each transfer is charged region_cost bytes; max_size 0
+ * disables sieving. Overrides the HDF5_VOL_PDC_SIEVE_MAX and
+ * HDF5_VOL_PDC_SIEVE_COST environment variables.
+ *
+ * @param max_size      [IN]    upper bound of the bytes of a bounding box
+ * @param region_cost   [IN]    overhead of a region transfer, in bytes
+ *
+ * @returns 0 on success, negative error code on failure
+ */
+H5VL_PDC_PUBLIC herr_t H5VLpdc_set_sieve(size_t max_size, size_t region_cost);
+
 #ifdef __cplusplus
 }
 #endif
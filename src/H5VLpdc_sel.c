@@ -0,0 +1,926 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Dataspace selections of the PDC VOL connector, as the blocks of
+ *          objects they cover and the runs of user buffers they map to
+ */
+#include "H5VLpdc_private.h"
+
+/* External headers needed by this file */
+#include <stdlib.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Blocks of a selection scattered in the user buffer are transferred in place
+ * as the pieces that are contiguous in it when those average SLAB_MIN bytes,
+ * and are staged otherwise */
+#define H5VL_PDC_SLAB_MIN     (256 * 1024)
+#define H5VL_PDC_SLAB_MIN_ENV "HDF5_VOL_PDC_SLAB_MIN"
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int    H5VL__pdc_block_cmp(const H5VL_pdc_block_t *a, const H5VL_pdc_block_t *b, int dim);
+static void   H5VL__pdc_block_sort(H5VL_pdc_block_t *blocks, size_t nblocks, int dim);
+static int    H5VL__pdc_block_base_cmp(const void *_a, const void *_b);
+static void   H5VL__pdc_block_merge(H5VL_pdc_block_t *blocks, size_t *nblocks, int dim);
+static int    H5VL__pdc_point_cmp(const void *_a, const void *_b);
+static herr_t H5VL__pdc_sel_points(hid_t space_id, int ndim, const hsize_t *dims, H5VL_pdc_point_t **points,
+                                   size_t *npoints, uint64_t **perm);
+static size_t H5VL__pdc_memmap_find(H5VL_pdc_memmap_t *map, uint64_t pos);
+
+/*******************/
+/* Local variables */
+/*******************/
+
+/* Smallest average size of the in-place pieces of a block, resolved on first use */
+static size_t  slab_min_g;
+static hbool_t slab_min_init_g = FALSE;
+
+/*---------------------------------------------------------------------------*/
+/* Order blocks by their extent along every dimension but dim, then by their
+ * offset along it, so that blocks that can be merged along dim follow each
+ * other */
+static int
+H5VL__pdc_block_cmp(const H5VL_pdc_block_t *a, const H5VL_pdc_block_t *b, int dim)
+{
+    int d;
+
+    for (d = 0; d < a->ndim; d++) {
+        if (d == dim)
+            continue;
+        if (a->offset[d] != b->offset[d])
+            return a->offset[d] < b->offset[d] ? -1 : 1;
+        if (a->count[d] != b->count[d])
+            return a->count[d] < b->count[d] ? -1 : 1;
+    }
+    if (a->offset[dim] != b->offset[dim])
+        return a->offset[dim] < b->offset[dim] ? -1 : 1;
+
+    return 0;
+} /* end H5VL__pdc_block_cmp() */
+
+/*---------------------------------------------------------------------------*/
+/* Sort blocks in place with H5VL__pdc_block_cmp() along dim. A heap sort,
+ * since qsort() has no way to pass the dimension to its comparator */
+static void
+H5VL__pdc_block_sort(H5VL_pdc_block_t *blocks, size_t nblocks, int dim)
+{
+    H5VL_pdc_block_t tmp;
+    size_t           start, end, root, child;
+
+    if (nblocks < 2)
+        return;
+
+    // Build a max-heap, then move its root to the end of the array until it is empty
+    for (start = nblocks / 2, end = nblocks; end > 1;) {
+        if (start > 0)
+            root = --start;
+        else {
+            tmp         = blocks[--end];
+            blocks[end] = blocks[0];
+            blocks[0]   = tmp;
+            root        = 0;
+        }
+        while ((child = 2 * root + 1) < end) {
+            if (child + 1 < end && H5VL__pdc_block_cmp(&blocks[child], &blocks[child + 1], dim) < 0)
+                child++;
+            if (H5VL__pdc_block_cmp(&blocks[root], &blocks[child], dim) >= 0)
+                break;
+            tmp           = blocks[root];
+            blocks[root]  = blocks[child];
+            blocks[child] = tmp;
+            root          = child;
+        }
+    }
+} /* end H5VL__pdc_block_sort() */
+
+/*---------------------------------------------------------------------------*/
+/* Order blocks by the position of their first element in the packed buffer */
+static int
+H5VL__pdc_block_base_cmp(const void *_a, const void *_b)
+{
+    const H5VL_pdc_block_t *a = (const H5VL_pdc_block_t *)_a;
+    const H5VL_pdc_block_t *b = (const H5VL_pdc_block_t *)_b;
+
+    return a->base < b->base ? -1 : (a->base > b->base ? 1 : 0);
+} /* end H5VL__pdc_block_base_cmp() */
+
+/*---------------------------------------------------------------------------*/
+/* Order points by their linear index, then by their position in the selection */
+static int
+H5VL__pdc_point_cmp(const void *_a, const void *_b)
+{
+    const H5VL_pdc_point_t *a = (const H5VL_pdc_point_t *)_a;
+    const H5VL_pdc_point_t *b = (const H5VL_pdc_point_t *)_b;
+
+    if (a->lin != b->lin)
+        return a->lin < b->lin ? -1 : 1;
+
+    return a->pos < b->pos ? -1 : (a->pos > b->pos ? 1 : 0);
+} /* end H5VL__pdc_point_cmp() */
+
+/*---------------------------------------------------------------------------*/
+/* List the elements of a point selection in the row-major order of the
+ * dataspace. When the selection lists them in another order, perm is set to
+ * a new array holding, for each element in row-major order, its position in
+ * the selection; it is left NULL otherwise. The caller frees both arrays. */
+static herr_t
+H5VL__pdc_sel_points(hid_t space_id, int ndim, const hsize_t *dims, H5VL_pdc_point_t **points,
+                     size_t *npoints, uint64_t **perm)
+{
+    hsize_t           coords[H5VL_PDC_SEQ_LIST_LEN * H5VL_PDC_MAX_RANK];
+    H5VL_pdc_point_t *pts = NULL;
+    hssize_t          n;
+    size_t            i, j, batch;
+    hbool_t           sorted = TRUE;
+    int               d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    *points  = NULL;
+    *npoints = 0;
+    *perm    = NULL;
+
+    if ((n = H5Sget_select_elem_npoints(space_id)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't get number of selected points");
+    if (n == 0)
+        HGOTO_DONE(SUCCEED);
+    if (NULL == (pts = (H5VL_pdc_point_t *)malloc((size_t)n * sizeof(H5VL_pdc_point_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate selection points");
+
+    for (i = 0; i < (size_t)n; i += batch) {
+        batch = (size_t)n - i < H5VL_PDC_SEQ_LIST_LEN ? (size_t)n - i : H5VL_PDC_SEQ_LIST_LEN;
+        if (H5Sget_select_elem_pointlist(space_id, (hsize_t)i, (hsize_t)batch, coords) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get selection points");
+        for (j = 0; j < batch; j++) {
+            pts[i + j].pos = i + j;
+            for (d = 0, pts[i + j].lin = 0; d < ndim; d++)
+                pts[i + j].lin = pts[i + j].lin * dims[d] + coords[j * ndim + d];
+            if (i + j > 0 && pts[i + j].lin < pts[i + j - 1].lin)
+                sorted = FALSE;
+        }
+    }
+
+    if (!sorted) {
+        qsort(pts, (size_t)n, sizeof(H5VL_pdc_point_t), H5VL__pdc_point_cmp);
+        if (NULL == (*perm = (uint64_t *)malloc((size_t)n * sizeof(uint64_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate selection permutation");
+        for (i = 0; i < (size_t)n; i++)
+            (*perm)[i] = pts[i].pos;
+    }
+
+    *points  = pts;
+    *npoints = (size_t)n;
+    pts      = NULL;
+
+done:
+    free(pts);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_sel_points() */
+
+/*---------------------------------------------------------------------------*/
+/* Merge the blocks that follow each other along a dimension, have the same
+ * extent along all others and are laid out with the same steps in the packed
+ * buffer; *nblocks is updated */
+static void
+H5VL__pdc_block_merge(H5VL_pdc_block_t *blocks, size_t *nblocks, int dim)
+{
+    H5VL_pdc_block_t *prev, *next;
+    size_t            i, n = 0;
+    int               d;
+
+    if (*nblocks < 2)
+        return;
+
+    H5VL__pdc_block_sort(blocks, *nblocks, dim);
+
+    for (i = 1; i < *nblocks; i++) {
+        prev = &blocks[n];
+        next = &blocks[i];
+
+        for (d = 0; d < prev->ndim; d++)
+            if (d != dim && (prev->offset[d] != next->offset[d] || prev->count[d] != next->count[d] ||
+                             (prev->count[d] > 1 && prev->pitch[d] != next->pitch[d])))
+                break;
+        if (d == prev->ndim && next->offset[dim] == prev->offset[dim] + prev->count[dim]) {
+            uint64_t pitch = prev->count[dim] > 1 ? prev->pitch[dim] : next->base - prev->base;
+
+            if (next->base > prev->base && next->base == prev->base + prev->count[dim] * pitch &&
+                (next->count[dim] == 1 || next->pitch[dim] == pitch)) {
+                prev->pitch[dim] = pitch;
+                prev->count[dim] += next->count[dim];
+                continue;
+            }
+        }
+        blocks[++n] = *next;
+    }
+    *nblocks = n + 1;
+} /* end H5VL__pdc_block_merge() */
+
+/*---------------------------------------------------------------------------*/
+/* Break the selection of a dataspace into blocks, the regions of the object
+ * it covers. Regular hyperslabs are split by their parameters, other
+ * selections are walked row by row and the rows merged back into blocks.
+ * The blocks are returned in the order of their elements in the packed
+ * buffer, in a new array the caller must free. Point selections are walked
+ * in row-major order whatever the order of their points, so that neighbouring
+ * points form blocks; perm is then set as by H5VL__pdc_sel_points(), and the
+ * packed buffer holds the elements in row-major order. */
+herr_t
+H5VL__pdc_sel_blocks(hid_t space_id, H5VL_pdc_block_t **blocks, size_t *nblocks, uint64_t **perm)
+{
+    hsize_t           dims[H5S_MAX_RANK], start[H5S_MAX_RANK], stride[H5S_MAX_RANK], cnt[H5S_MAX_RANK],
+        blk_size[H5S_MAX_RANK];
+    hsize_t           off[H5VL_PDC_SEQ_LIST_LEN];
+    size_t            len[H5VL_PDC_SEQ_LIST_LEN];
+    uint64_t          nb[H5VL_PDC_MAX_RANK], ext[H5VL_PDC_MAX_RANK], step[H5VL_PDC_MAX_RANK],
+        pitch[H5VL_PDC_MAX_RANK], idx[H5VL_PDC_MAX_RANK] = {0}, row[H5VL_PDC_MAX_RANK],
+        c[H5VL_PDC_MAX_RANK], lin, run, packed = 0, total;
+    H5VL_pdc_block_t *blk = NULL, *b;
+    H5VL_pdc_point_t *points = NULL;
+    size_t           *open = NULL, *cur = NULL, *tmp, alloc = 0, nblk = 0, nopen = 0, ncur = 0, pos = 0, nseq,
+                     nelem, npoints = 0, next = 0, i;
+    hid_t             sel_iter_id = H5I_INVALID_HID;
+    hbool_t           sel_iter_init = FALSE, have_row = FALSE, extended;
+    H5S_sel_type      type;
+    htri_t            regular = FALSE;
+    int               ndim, d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    *blocks  = NULL;
+    *nblocks = 0;
+    *perm    = NULL;
+
+    if ((ndim = H5Sget_simple_extent_ndims(space_id)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get number of dimensions");
+    if (ndim > H5VL_PDC_MAX_RANK)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "data dimension not supported");
+    if (H5Sget_simple_extent_dims(space_id, dims, NULL) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get dimensions");
+    if ((type = H5Sget_select_type(space_id)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get selection type");
+    if (type == H5S_SEL_NONE)
+        HGOTO_DONE(SUCCEED);
+    if (type == H5S_SEL_ALL) {
+        for (d = 0; d < ndim; d++) {
+            start[d] = 0;
+            stride[d] = blk_size[d] = dims[d];
+            cnt[d]                  = 1;
+        }
+        regular = TRUE;
+    }
+    else if (type == H5S_SEL_HYPERSLABS) {
+        if ((regular = H5Sis_regular_hyperslab(space_id)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't check hyperslab selection");
+        if (regular && H5Sget_regular_hyperslab(space_id, start, stride, cnt, blk_size) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get hyperslab selection");
+
+        /* Unions of hyperslabs can be reported with a regular pattern that does
+         * not describe them, walk those */
+        for (d = 0, total = 1; regular && d < ndim; d++) {
+            if (cnt[d] > 1 && stride[d] < blk_size[d])
+                regular = FALSE;
+            total *= cnt[d] * blk_size[d];
+        }
+        if (regular && (hssize_t)total != H5Sget_select_npoints(space_id))
+            regular = FALSE;
+    }
+    else if (type == H5S_SEL_POINTS) {
+        if (H5VL__pdc_sel_points(space_id, ndim, dims, &points, &npoints, perm) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get selection points");
+    }
+
+    if (regular) {
+        /* The blocks of a regular selection hold the packed buffer as an array of
+         * count * block elements along each dimension; blocks that touch along a
+         * dimension form a single one */
+        for (d = ndim - 1, total = 1, nblk = 1; d >= 0; d--) {
+            pitch[d] = total;
+            total *= cnt[d] * blk_size[d];
+            if (cnt[d] == 1 || stride[d] == blk_size[d]) {
+                nb[d]   = 1;
+                ext[d]  = cnt[d] * blk_size[d];
+                step[d] = 0;
+            }
+            else {
+                nb[d]   = cnt[d];
+                ext[d]  = blk_size[d];
+                step[d] = stride[d];
+            }
+            nblk *= nb[d];
+        }
+
+        if (NULL == (blk = (H5VL_pdc_block_t *)calloc(nblk, sizeof(H5VL_pdc_block_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate selection blocks");
+        for (i = 0; i < nblk; i++) {
+            b       = &blk[i];
+            b->ndim = ndim;
+            for (d = 0; d < ndim; d++) {
+                b->offset[d] = start[d] + idx[d] * step[d];
+                b->count[d]  = ext[d];
+                b->pitch[d]  = pitch[d];
+                b->base += idx[d] * ext[d] * pitch[d];
+            }
+            for (d = ndim - 1; d >= 0; d--) {
+                if (++idx[d] < nb[d])
+                    break;
+                idx[d] = 0;
+            }
+        }
+    }
+    else {
+        /* Walk the selection in row-major order; a run of elements along the
+         * last dimension extends the block that ended on the same columns of
+         * the previous row, when its elements keep the same step in the packed
+         * buffer, and starts a new block otherwise */
+        if (type != H5S_SEL_POINTS) {
+            if ((sel_iter_id = H5Ssel_iter_create(space_id, 1, 0)) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator");
+            sel_iter_init = TRUE;
+        }
+
+        do {
+            if (type == H5S_SEL_POINTS) {
+                /* Sorted points with consecutive linear indices make a sequence */
+                for (nseq = 0; nseq < H5VL_PDC_SEQ_LIST_LEN && next < npoints; nseq++) {
+                    off[nseq] = points[next].lin;
+                    for (len[nseq] = 1; ++next < npoints && points[next].lin == off[nseq] + len[nseq];)
+                        len[nseq]++;
+                }
+            }
+            else if (H5Ssel_iter_get_seq_list(sel_iter_id, (size_t)H5VL_PDC_SEQ_LIST_LEN, (size_t)-1, &nseq,
+                                              &nelem, off, len) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "sequence length generation failed");
+
+            for (i = 0; i < nseq; i++) {
+                while (len[i] > 0) {
+                    /* Sequences may span several rows, take them one row at a time */
+                    for (d = ndim - 1, lin = off[i]; d >= 0; d--) {
+                        c[d] = lin % dims[d];
+                        lin /= dims[d];
+                    }
+                    run = dims[ndim - 1] - c[ndim - 1];
+                    if (run > len[i])
+                        run = len[i];
+
+                    if (ndim > 1 && (!have_row || memcmp(c, row, (ndim - 1) * sizeof(uint64_t)) != 0)) {
+                        /* Only the blocks of the previous row can be extended */
+                        hbool_t follows = have_row && c[ndim - 2] == row[ndim - 2] + 1 &&
+                                          memcmp(c, row, (ndim - 2) * sizeof(uint64_t)) == 0;
+
+                        tmp   = open;
+                        open  = cur;
+                        cur   = tmp;
+                        nopen = follows ? ncur : 0;
+                        ncur  = 0;
+                        pos   = 0;
+                        memcpy(row, c, (ndim - 1) * sizeof(uint64_t));
+                        have_row = TRUE;
+                    }
+
+                    extended = FALSE;
+                    if (ndim > 1) {
+                        while (pos < nopen && blk[open[pos]].offset[ndim - 1] < c[ndim - 1])
+                            pos++;
+                        if (pos < nopen) {
+                            b = &blk[open[pos]];
+                            if (b->offset[ndim - 1] == c[ndim - 1] && b->count[ndim - 1] == run &&
+                                (b->count[ndim - 2] == 1 ||
+                                 packed == b->base + b->count[ndim - 2] * b->pitch[ndim - 2])) {
+                                if (b->count[ndim - 2] == 1)
+                                    b->pitch[ndim - 2] = packed - b->base;
+                                b->count[ndim - 2]++;
+                                cur[ncur++] = open[pos++];
+                                extended    = TRUE;
+                            }
+                        }
+                    }
+
+                    if (!extended) {
+                        if (nblk == alloc) {
+                            alloc = alloc ? 2 * alloc : 64;
+                            if (NULL ==
+                                (b = (H5VL_pdc_block_t *)realloc(blk, alloc * sizeof(H5VL_pdc_block_t))))
+                                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate blocks");
+                            blk = b;
+                            if (NULL == (tmp = (size_t *)realloc(open, alloc * sizeof(size_t))))
+                                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate blocks");
+                            open = tmp;
+                            if (NULL == (tmp = (size_t *)realloc(cur, alloc * sizeof(size_t))))
+                                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate blocks");
+                            cur = tmp;
+                        }
+                        b = &blk[nblk];
+                        memset(b, 0, sizeof(H5VL_pdc_block_t));
+                        b->ndim = ndim;
+                        for (d = 0; d < ndim; d++) {
+                            b->offset[d] = c[d];
+                            b->count[d]  = 1;
+                        }
+                        b->count[ndim - 1] = run;
+                        b->pitch[ndim - 1] = 1;
+                        b->base            = packed;
+                        if (ndim > 1)
+                            cur[ncur++] = nblk;
+                        nblk++;
+                    }
+
+                    off[i] += run;
+                    len[i] -= run;
+                    packed += run;
+                }
+            }
+        } while (nseq == H5VL_PDC_SEQ_LIST_LEN);
+
+        /* Rows were merged along the second to last dimension, merge the
+         * resulting blocks along the outer ones */
+        for (d = ndim - 3; d >= 0; d--)
+            H5VL__pdc_block_merge(blk, &nblk, d);
+        qsort(blk, nblk, sizeof(H5VL_pdc_block_t), H5VL__pdc_block_base_cmp);
+    }
+
+    *blocks  = blk;
+    *nblocks = nblk;
+    blk      = NULL;
+
+done:
+    if (sel_iter_init && H5Ssel_iter_close(sel_iter_id) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator");
+    if (FUNC_ERRORED) {
+        free(*perm);
+        *perm = NULL;
+    }
+    free(blk);
+    free(open);
+    free(cur);
+    free(points);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_sel_blocks() */
+
+/*---------------------------------------------------------------------------*/
+/* Whether the elements of a block follow each other in the packed buffer in
+ * the row-major order of the block, so that its data can be used in place */
+hbool_t
+H5VL__pdc_block_dense(const H5VL_pdc_block_t *blk)
+{
+    uint64_t size = 1;
+    int      d;
+
+    for (d = blk->ndim - 1; d >= 0; d--) {
+        if (blk->count[d] > 1 && blk->pitch[d] != size)
+            return FALSE;
+        size *= blk->count[d];
+    }
+
+    return TRUE;
+} /* end H5VL__pdc_block_dense() */
+
+/*---------------------------------------------------------------------------*/
+/* Turn blocks of elements of elem bytes into blocks of bytes along the last
+ * dimension, for types stored as bytes by PDC */
+void
+H5VL__pdc_block_scale(H5VL_pdc_block_t *blocks, size_t nblocks, size_t elem)
+{
+    size_t i;
+    int    d;
+
+    for (i = 0; i < nblocks; i++) {
+        if (blocks[i].ndim == 0)
+            continue;
+        blocks[i].offset[blocks[i].ndim - 1] *= elem;
+        blocks[i].count[blocks[i].ndim - 1] *= elem;
+        blocks[i].base *= elem;
+        for (d = 0; d < blocks[i].ndim - 1; d++)
+            blocks[i].pitch[d] *= elem;
+    }
+} /* end H5VL__pdc_block_scale() */
+
+/*---------------------------------------------------------------------------*/
+/* Describe the selection of a memory dataspace by the runs of bytes it covers
+ * in the user buffer, in selection order, so that the packed position of an
+ * element locates it in the buffer. With a permutation from the file
+ * selection, element i of the packed buffer is element perm[i] of the memory
+ * selection, and the runs are laid out in that order instead. */
+herr_t
+H5VL__pdc_memmap_build(hid_t space_id, void *buf, size_t elem, const uint64_t *perm, H5VL_pdc_memmap_t *map)
+{
+    hid_t     sel_iter_id;
+    hbool_t   sel_iter_init = FALSE;
+    hsize_t   off[H5VL_PDC_SEQ_LIST_LEN];
+    size_t    len[H5VL_PDC_SEQ_LIST_LEN];
+    size_t    nseq, nelem, alloc = 0, nrun = 0, r, i;
+    uint64_t *tmp, *ppos = NULL, *poff = NULL, pos = 0, addr;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    memset(map, 0, sizeof(*map));
+    map->buf = (char *)buf;
+
+    if ((sel_iter_id = H5Ssel_iter_create(space_id, elem, 0)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to initialize selection iterator");
+    sel_iter_init = TRUE;
+
+    do {
+        if (H5Ssel_iter_get_seq_list(sel_iter_id, (size_t)H5VL_PDC_SEQ_LIST_LEN, (size_t)-1, &nseq, &nelem,
+                                     off, len) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "sequence length generation failed");
+
+        for (i = 0; i < nseq; i++) {
+            /* Sequences of consecutive batches may continue each other */
+            if (map->nrun > 0 && map->off[map->nrun - 1] + (pos - map->pos[map->nrun - 1]) == off[i]) {
+                pos += len[i];
+                continue;
+            }
+            if (map->nrun + 1 >= alloc) {
+                alloc = alloc ? 2 * alloc : 64;
+                if (NULL == (tmp = (uint64_t *)realloc(map->pos, alloc * sizeof(uint64_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate memory runs");
+                map->pos = tmp;
+                if (NULL == (tmp = (uint64_t *)realloc(map->off, alloc * sizeof(uint64_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate memory runs");
+                map->off = tmp;
+            }
+            map->pos[map->nrun] = pos;
+            map->off[map->nrun] = off[i];
+            map->nrun++;
+            pos += len[i];
+        }
+    } while (nseq == H5VL_PDC_SEQ_LIST_LEN);
+
+    /* The end of the last run */
+    if (map->nrun == 0 && NULL == (map->pos = (uint64_t *)malloc(sizeof(uint64_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate memory runs");
+    map->pos[map->nrun] = pos;
+
+    if (perm && pos > 0) {
+        /* Rebuild the runs element by element in the order of the permutation,
+         * merging the elements that follow each other in the buffer */
+        for (i = 0, alloc = 0; i < pos / elem; i++) {
+            r    = H5VL__pdc_memmap_find(map, perm[i] * elem);
+            addr = map->off[r] + perm[i] * elem - map->pos[r];
+            if (nrun > 0 && poff[nrun - 1] + (i * elem - ppos[nrun - 1]) == addr)
+                continue;
+            if (nrun + 1 >= alloc) {
+                alloc = alloc ? 2 * alloc : 64;
+                if (NULL == (tmp = (uint64_t *)realloc(ppos, alloc * sizeof(uint64_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate memory runs");
+                ppos = tmp;
+                if (NULL == (tmp = (uint64_t *)realloc(poff, alloc * sizeof(uint64_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate memory runs");
+                poff = tmp;
+            }
+            ppos[nrun] = i * elem;
+            poff[nrun] = addr;
+            nrun++;
+        }
+        ppos[nrun] = pos;
+
+        H5VL__pdc_memmap_free(map);
+        map->pos  = ppos;
+        map->off  = poff;
+        map->nrun = nrun;
+        map->hint = 0;
+        ppos = poff = NULL;
+    }
+
+done:
+    if (sel_iter_init && H5Ssel_iter_close(sel_iter_id) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTRELEASE, FAIL, "unable to release selection iterator");
+    free(ppos);
+    free(poff);
+    if (FUNC_ERRORED)
+        H5VL__pdc_memmap_free(map);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_memmap_build() */
+
+/*---------------------------------------------------------------------------*/
+void
+H5VL__pdc_memmap_free(H5VL_pdc_memmap_t *map)
+{
+    free(map->pos);
+    free(map->off);
+    map->pos  = NULL;
+    map->off  = NULL;
+    map->nrun = 0;
+} /* end H5VL__pdc_memmap_free() */
+
+/*---------------------------------------------------------------------------*/
+/* Index of the run holding the byte at packed position pos, rows are mostly
+ * looked up in order so the run of the previous lookup is tried first */
+static size_t
+H5VL__pdc_memmap_find(H5VL_pdc_memmap_t *map, uint64_t pos)
+{
+    size_t lo = 0, hi = map->nrun, mid;
+
+    if (map->hint < map->nrun && map->pos[map->hint] <= pos) {
+        if (pos < map->pos[map->hint + 1])
+            return map->hint;
+        if (map->hint + 1 < map->nrun && pos < map->pos[map->hint + 2])
+            return ++map->hint;
+        lo = map->hint + 1;
+    }
+    while (hi - lo > 1) {
+        mid = (lo + hi) / 2;
+        if (map->pos[mid] <= pos)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return map->hint = lo;
+} /* end H5VL__pdc_memmap_find() */
+
+/*---------------------------------------------------------------------------*/
+/* Address in the user buffer of len bytes from packed position pos, or NULL
+ * when they are not contiguous in it */
+void *
+H5VL__pdc_memmap_addr(H5VL_pdc_memmap_t *map, uint64_t pos, uint64_t len)
+{
+    size_t r;
+
+    if (map->nrun == 0)
+        return NULL;
+    r = H5VL__pdc_memmap_find(map, pos);
+    if (pos + len > map->pos[r + 1])
+        return NULL;
+
+    return map->buf + map->off[r] + (pos - map->pos[r]);
+} /* end H5VL__pdc_memmap_addr() */
+
+/*---------------------------------------------------------------------------*/
+/* Copy the data of a block between a buffer and the user buffer, one row at
+ * a time, each row split at the ends of the memory runs it crosses. The rows
+ * of the block are stride[d] bytes apart in buf along each dimension d but
+ * the last, or follow each other when stride is NULL. When conv is set the
+ * elements are converted on the way, elem being their size in buf. */
+void
+H5VL__pdc_memmap_copy(H5VL_pdc_memmap_t *map, const H5VL_pdc_block_t *blk, size_t elem, void *buf,
+                      const uint64_t *stride, const H5VL_pdc_conv_t *conv, hbool_t to_mem)
+{
+    uint64_t idx[H5VL_PDC_MAX_RANK] = {0}, step[H5VL_PDC_MAX_RANK], pos, left, part;
+    size_t   row = elem, melem = elem, mrow, done, r;
+    char *   mem;
+    int      d, ndim = blk->ndim;
+
+    for (d = 0; d < ndim; d++)
+        if (blk->count[d] == 0)
+            return;
+    if (conv)
+        melem = to_mem ? conv->dst_size : conv->src_size;
+    if (ndim > 0)
+        row *= blk->count[ndim - 1];
+    mrow = row / elem * melem;
+    for (d = ndim - 2; d >= 0; d--)
+        step[d] = stride ? stride[d] : (d == ndim - 2 ? row : step[d + 1] * blk->count[d + 1]);
+
+    for (;;) {
+        for (d = 0, pos = blk->base, done = 0; d < ndim - 1; d++) {
+            pos += idx[d] * blk->pitch[d];
+            done += idx[d] * step[d];
+        }
+
+        for (pos *= melem, left = mrow; left > 0; left -= part, pos += part, done += part / melem * elem) {
+            r    = H5VL__pdc_memmap_find(map, pos);
+            mem  = map->buf + map->off[r] + (pos - map->pos[r]);
+            part = map->pos[r + 1] - pos < left ? map->pos[r + 1] - pos : left;
+            if (conv && to_mem)
+                H5VL__pdc_conv_run(conv, mem, (char *)buf + done, part / melem);
+            else if (conv)
+                H5VL__pdc_conv_run(conv, (char *)buf + done, mem, part / melem);
+            else if (to_mem)
+                memcpy(mem, (char *)buf + done, part);
+            else
+                memcpy((char *)buf + done, mem, part);
+        }
+
+        /* Next row */
+        for (d = ndim - 2; d >= 0; d--) {
+            if (++idx[d] < blk->count[d])
+                break;
+            idx[d] = 0;
+        }
+        if (d < 0)
+            break;
+    }
+} /* end H5VL__pdc_memmap_copy() */
+
+/*---------------------------------------------------------------------------*/
+/* Split a block whose elements are not contiguous in the user buffer into
+ * pieces that are, so that they are transferred in place: the largest slabs
+ * of whole inner dimensions that are, or else the parts of its rows that
+ * fall in each memory run. Each piece costs a transfer, a staged block costs
+ * a copy; pieces are only made when they average min_size bytes or more,
+ * otherwise *npieces is 0 and the block is to be staged. */
+herr_t
+H5VL__pdc_block_split(H5VL_pdc_memmap_t *map, const H5VL_pdc_block_t *blk, size_t elem, size_t min_size,
+                      H5VL_pdc_block_t **pieces, size_t *npieces)
+{
+    H5VL_pdc_block_t *piece = NULL, *tmp;
+    uint64_t          idx[H5VL_PDC_MAX_RANK], inner, nslab, total = elem, max_pieces, s;
+    uint64_t          start, pos, left, part;
+    size_t            n = 0, alloc = 0, r;
+    hbool_t           dense = TRUE, fits;
+    int               k, d, ndim = blk->ndim;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    *pieces  = NULL;
+    *npieces = 0;
+    for (d = 0; d < ndim; d++)
+        total *= blk->count[d];
+    if (total == 0 || min_size == 0 || (max_pieces = total / min_size) == 0)
+        HGOTO_DONE(SUCCEED);
+
+    /* Slabs spanning the dimensions after k, from the largest */
+    for (k = 0; k < ndim - 1; k++) {
+        for (d = k + 1, inner = 1; d < ndim; d++)
+            inner *= blk->count[d];
+        for (d = 0, nslab = 1; d <= k; d++)
+            nslab *= blk->count[d];
+        if (nslab > max_pieces)
+            break;
+
+        /* The slabs are dense in the packed selection once the inner dimensions are */
+        for (d = ndim - 1, dense = TRUE, s = 1; d > k; d--) {
+            if (blk->count[d] > 1 && blk->pitch[d] != s)
+                dense = FALSE;
+            s *= blk->count[d];
+        }
+        if (!dense)
+            continue;
+
+        memset(idx, 0, sizeof(idx));
+        for (s = 0, fits = TRUE; s < nslab && fits; s++) {
+            for (d = 0, pos = blk->base; d <= k; d++)
+                pos += idx[d] * blk->pitch[d];
+            fits = H5VL__pdc_memmap_addr(map, pos * elem, inner * elem) != NULL;
+            for (d = k; d >= 0; d--) {
+                if (++idx[d] < blk->count[d])
+                    break;
+                idx[d] = 0;
+            }
+        }
+        if (!fits)
+            continue;
+
+        if (NULL == (piece = (H5VL_pdc_block_t *)malloc(nslab * sizeof(H5VL_pdc_block_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate block pieces");
+        memset(idx, 0, sizeof(idx));
+        for (s = 0; s < nslab; s++) {
+            piece[s] = *blk;
+            for (d = 0; d <= k; d++) {
+                piece[s].offset[d] += idx[d];
+                piece[s].count[d] = 1;
+                piece[s].base += idx[d] * blk->pitch[d];
+            }
+            for (d = k; d >= 0; d--) {
+                if (++idx[d] < blk->count[d])
+                    break;
+                idx[d] = 0;
+            }
+        }
+        n = nslab;
+        HGOTO_DONE(SUCCEED);
+    }
+
+    /* Parts of the rows within each memory run */
+    memset(idx, 0, sizeof(idx));
+    for (;;) {
+        for (d = 0, start = blk->base; d < ndim - 1; d++)
+            start += idx[d] * blk->pitch[d];
+        start *= elem;
+
+        for (pos = start, left = (ndim > 0 ? blk->count[ndim - 1] : 1) * elem; left > 0;
+             left -= part, pos += part) {
+            r    = H5VL__pdc_memmap_find(map, pos);
+            part = map->pos[r + 1] - pos < left ? map->pos[r + 1] - pos : left;
+
+            /* Runs hold whole elements, too many parts are not worth their transfers */
+            if (n == max_pieces) {
+                free(piece);
+                piece = NULL;
+                n     = 0;
+                HGOTO_DONE(SUCCEED);
+            }
+            if (n == alloc) {
+                alloc = alloc ? 2 * alloc : 16;
+                if (NULL == (tmp = (H5VL_pdc_block_t *)realloc(piece, alloc * sizeof(H5VL_pdc_block_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate block pieces");
+                piece = tmp;
+            }
+            piece[n] = *blk;
+            for (d = 0; d < ndim - 1; d++) {
+                piece[n].offset[d] += idx[d];
+                piece[n].count[d] = 1;
+            }
+            if (ndim > 0) {
+                piece[n].offset[ndim - 1] += (pos - start) / elem;
+                piece[n].count[ndim - 1] = part / elem;
+            }
+            piece[n].base = pos / elem;
+            n++;
+        }
+
+        /* Next row */
+        for (d = ndim - 2; d >= 0; d--) {
+            if (++idx[d] < blk->count[d])
+                break;
+            idx[d] = 0;
+        }
+        if (d < 0)
+            break;
+    }
+
+done:
+    if (FUNC_ERRORED) {
+        free(piece);
+        piece = NULL;
+        n     = 0;
+    }
+    *pieces  = piece;
+    *npieces = n;
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_block_split() */
+
+/*---------------------------------------------------------------------------*/
+/* Replace the blocks of a selection that are scattered in the user buffer by
+ * their pieces that are contiguous in it, when H5VL__pdc_block_split() finds
+ * them worth it */
+herr_t
+H5VL__pdc_block_split_all(H5VL_pdc_memmap_t *map, H5VL_pdc_block_t **blocks, size_t *nblocks, size_t elem)
+{
+    H5VL_pdc_block_t *out = NULL, *pieces = NULL, *blk, *tmp;
+    size_t            nout = 0, alloc = 0, npieces, b;
+    uint64_t          size;
+    int               d;
+
+    FUNC_ENTER_VOL(herr_t, SUCCEED)
+
+    for (b = 0; b < *nblocks; b++) {
+        blk = &(*blocks)[b];
+        for (d = 0, size = elem; d < blk->ndim; d++)
+            size *= blk->count[d];
+
+        npieces = 0;
+        if ((!H5VL__pdc_block_dense(blk) || H5VL__pdc_memmap_addr(map, blk->base * elem, size) == NULL) &&
+            H5VL__pdc_block_split(map, blk, elem, H5VL__pdc_slab_min(), &pieces, &npieces) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't split block");
+
+        if (nout + (npieces ? npieces : 1) > alloc) {
+            alloc = 2 * (nout + (npieces ? npieces : 1));
+            if (NULL == (tmp = (H5VL_pdc_block_t *)realloc(out, alloc * sizeof(H5VL_pdc_block_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "can't allocate selection blocks");
+            out = tmp;
+        }
+        if (npieces == 0)
+            out[nout++] = *blk;
+        else {
+            memcpy(&out[nout], pieces, npieces * sizeof(H5VL_pdc_block_t));
+            nout += npieces;
+        }
+        free(pieces);
+        pieces = NULL;
+    }
+
+    free(*blocks);
+    *blocks  = out;
+    *nblocks = nout;
+    out      = NULL;
+
+done:
+    free(pieces);
+    free(out);
+    FUNC_LEAVE_VOL
+} /* end H5VL__pdc_block_split_all() */
+
+/*---------------------------------------------------------------------------*/
+/* Resolve the smallest average size of the pieces a block is split into on
+ * first use */
+size_t
+H5VL__pdc_slab_min(void)
+{
+    const char *env;
+
+    if (!slab_min_init_g) {
+        slab_min_g = H5VL_PDC_SLAB_MIN;
+        if ((env = getenv(H5VL_PDC_SLAB_MIN_ENV)) != NULL)
+            slab_min_g = H5VL__pdc_parse_size(env);
+        slab_min_init_g = TRUE;
+    }
+
+    return slab_min_g;
+} /* end H5VL__pdc_slab_min() */
@@ -0,0 +1,32 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Helpers shared by the tests of the PDC VOL connector
+ */
+
+#ifndef H5VLpdc_test_H
+#define H5VLpdc_test_H
+
+#include <stdio.h>
+
+/* Count a failed check and report where it failed, the test goes on */
+#define CHECK(expr)                                                                                          \
+    do {                                                                                                     \
+        if (!(expr)) {                                                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr);                         \
+            nerrors++;                                                                                       \
+        }                                                                                                    \
+    } while (0)
+
+/* Failed checks of the test, defined in H5VLpdc_test.c */
+extern int nerrors;
+
+#endif /* H5VLpdc_test_H */
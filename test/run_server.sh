@@ -0,0 +1,25 @@
+#!/bin/bash
+# Run a test of the connector against a PDC server started for it
+#
+# Usage: run_server.sh <connector dir> <mpiexec> <pdc_server.exe> <close_server> <nprocs> <test>
+
+if [ $# -ne 6 ]; then
+    echo "Usage: $0 <connector dir> <mpiexec> <pdc_server.exe> <close_server> <nprocs> <test>"
+    exit 1
+fi
+
+export HDF5_PLUGIN_PATH="$1"
+export HDF5_VOL_CONNECTOR="pdc under_vol=0;under_info={}"
+MPIEXEC="$2"
+
+"$MPIEXEC" -n 1 "$3" &
+server=$!
+sleep 1
+
+"$MPIEXEC" -n "$5" "$6"
+ret=$?
+
+"$MPIEXEC" -n 1 "$4"
+wait $server
+
+exit $ret
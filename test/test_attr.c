@@ -0,0 +1,87 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the attribute cache of the PDC VOL connector: the
+ *          datatype, shape and value of an attribute are served from memory,
+ *          written back when its object is closed and fetched once when it
+ *          is opened again. Runs against a PDC server, with the connector
+ *          loaded through HDF5_VOL_CONNECTOR.
+ */
+#include <mpi.h>
+
+#include "H5VLpdc_public.h"
+#include "H5VLpdc_test.h"
+
+#define FILE_NAME "test_attr.h5"
+
+int
+main(int argc, char **argv)
+{
+    H5VL_pdc_stats_t stats;
+    hsize_t          dims = 3;
+    hid_t            fapl_id, file_id, space_id, dset_id, attr_id, type_id, aspace_id;
+    double           value[3] = {0.5, -1.25, 3.0}, out[3] = {0};
+
+    MPI_Init(&argc, &argv);
+
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+    CHECK((file_id = H5Fcreate(FILE_NAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) >= 0);
+    space_id = H5Screate_simple(1, &dims, NULL);
+    CHECK((dset_id = H5Dcreate2(file_id, "d", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                                H5P_DEFAULT)) >= 0);
+
+    // A created attribute is known without asking the servers
+    CHECK((attr_id = H5Acreate2(dset_id, "scale", H5T_NATIVE_DOUBLE, space_id, H5P_DEFAULT, H5P_DEFAULT)) >=
+          0);
+    CHECK(H5Awrite(attr_id, H5T_NATIVE_DOUBLE, value) >= 0);
+    CHECK((type_id = H5Aget_type(attr_id)) >= 0);
+    CHECK(H5Tequal(type_id, H5T_NATIVE_DOUBLE) > 0);
+    H5Tclose(type_id);
+    CHECK(H5Aread(attr_id, H5T_NATIVE_DOUBLE, out) >= 0);
+    CHECK(out[0] == value[0] && out[1] == value[1] && out[2] == value[2]);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nattr_fetch == 0 && stats.nattr_hit >= 2);
+    H5Aclose(attr_id);
+    H5Sclose(space_id);
+
+    // The value is written back with its datatype when the dataset is closed
+    CHECK(H5Dclose(dset_id) >= 0);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    // Opened again, the attribute is fetched once, then read from memory
+    CHECK((file_id = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_id)) >= 0);
+    CHECK((dset_id = H5Dopen2(file_id, "d", H5P_DEFAULT)) >= 0);
+    CHECK((attr_id = H5Aopen(dset_id, "scale", H5P_DEFAULT)) >= 0);
+    CHECK((type_id = H5Aget_type(attr_id)) >= 0);
+    CHECK(H5Tequal(type_id, H5T_NATIVE_DOUBLE) > 0);
+    H5Tclose(type_id);
+    CHECK((aspace_id = H5Aget_space(attr_id)) >= 0);
+    CHECK(H5Sget_simple_extent_npoints(aspace_id) == 3);
+    H5Sclose(aspace_id);
+    out[0] = out[1] = out[2] = 0;
+    CHECK(H5Aread(attr_id, H5T_NATIVE_DOUBLE, out) >= 0);
+    CHECK(out[0] == value[0] && out[1] == value[1] && out[2] == value[2]);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nattr_fetch == 1);
+    H5Aclose(attr_id);
+    H5Dclose(dset_id);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    H5Pclose(fapl_id);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    MPI_Finalize();
+
+    return nerrors != 0;
+}
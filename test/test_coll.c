@@ -0,0 +1,174 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the collective paths of the PDC VOL connector on two
+ *          ranks: aggregated writes, deferred dataset creates and collective
+ *          metadata. Runs against a PDC server, with the connector loaded
+ *          through HDF5_VOL_CONNECTOR.
+ */
+#include <mpi.h>
+#include <stdlib.h>
+
+#include "H5VLpdc_public.h"
+#include "H5VLpdc_test.h"
+
+#define FILE_NAME "test_coll.h5"
+
+/* Elements written by each rank */
+#define N 1024
+
+/* Write the elements of [off, off + n) of a 1-D dataset from buf, or select
+ * nothing when n is 0 */
+static herr_t
+write_part(hid_t dset_id, hid_t dxpl_id, hsize_t off, hsize_t n, const int *buf)
+{
+    hsize_t one = n > 0 ? n : 1;
+    hid_t   mspace_id, fspace_id;
+    herr_t  ret;
+
+    mspace_id = H5Screate_simple(1, &one, NULL);
+    fspace_id = H5Dget_space(dset_id);
+    if (n > 0)
+        H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &off, NULL, &n, NULL);
+    else {
+        H5Sselect_none(mspace_id);
+        H5Sselect_none(fspace_id);
+    }
+    ret = H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id, fspace_id, dxpl_id, buf);
+    H5Sclose(fspace_id);
+    H5Sclose(mspace_id);
+
+    return ret;
+}
+
+/* Read a whole 1-D dataset and check that element i holds i */
+static void
+check_data(hid_t file_id, const char *name, hsize_t n)
+{
+    hid_t   dset_id;
+    int *   buf = (int *)malloc(n * sizeof(int));
+    hsize_t i;
+
+    CHECK((dset_id = H5Dopen2(file_id, name, H5P_DEFAULT)) >= 0);
+    CHECK(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0);
+    for (i = 0; i < n; i++)
+        if (buf[i] != (int)i) {
+            CHECK(buf[i] == (int)i);
+            break;
+        }
+    H5Dclose(dset_id);
+    free(buf);
+}
+
+int
+main(int argc, char **argv)
+{
+    H5VL_pdc_stats_t stats;
+    hsize_t          dims;
+    hid_t            fapl_id, dxpl_id, file_id, space_id, aspace_id, agg_id, one_id, indep_id, attr_id;
+    uint64_t         nagg;
+    int              buf[2 * N], step = 7, value = 0, rank, nprocs, i, all;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs != 2) {
+        if (rank == 0)
+            printf("test_coll runs on 2 ranks\n");
+        MPI_Finalize();
+        return 1;
+    }
+    for (i = 0; i < 2 * N; i++)
+        buf[i] = i;
+
+    // One aggregator for both ranks, collective metadata and deferred creates
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_WORLD, MPI_INFO_NULL);
+    CHECK(H5Pset_pdc_aggregators(fapl_id, 1, true) >= 0);
+    CHECK(H5Pset_pdc_coll_metadata(fapl_id, true) >= 0);
+    CHECK(H5Pset_pdc_defer_create(fapl_id, true) >= 0);
+    dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(H5Pset_pdc_aggregation(dxpl_id, true) >= 0);
+
+    CHECK((file_id = H5Fcreate(FILE_NAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) >= 0);
+
+    // Both creates wait for the flush, which makes them together
+    dims     = 2 * N;
+    space_id = H5Screate_simple(1, &dims, NULL);
+    CHECK((agg_id = H5Dcreate2(file_id, "agg", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT)) >= 0);
+    H5Sclose(space_id);
+    dims     = N;
+    space_id = H5Screate_simple(1, &dims, NULL);
+    CHECK((one_id = H5Dcreate2(file_id, "one", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT)) >= 0);
+    CHECK(H5Fflush(file_id, H5F_SCOPE_GLOBAL) >= 0);
+
+    // Each rank writes its half through the aggregator
+    CHECK(write_part(agg_id, dxpl_id, (hsize_t)rank * N, N, buf + rank * N) >= 0);
+
+    // Rank 1 has nothing to write but takes part all the same
+    CHECK(write_part(one_id, dxpl_id, 0, rank == 0 ? N : 0, buf) >= 0);
+
+    // All ranks attach the same attribute
+    aspace_id = H5Screate(H5S_SCALAR);
+    CHECK((attr_id = H5Acreate2(agg_id, "step", H5T_NATIVE_INT, aspace_id, H5P_DEFAULT, H5P_DEFAULT)) >= 0);
+    CHECK(H5Awrite(attr_id, H5T_NATIVE_INT, &step) >= 0);
+    H5Aclose(attr_id);
+    H5Sclose(aspace_id);
+
+    // A deferred dataset written by rank 0 alone is made by that write, and
+    // opened by rank 1 at the next flush
+    CHECK((indep_id = H5Dcreate2(file_id, "indep", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                                 H5P_DEFAULT)) >= 0);
+    H5Sclose(space_id);
+    if (rank == 0)
+        CHECK(write_part(indep_id, H5P_DEFAULT, 0, N, buf) >= 0);
+    CHECK(H5Fflush(file_id, H5F_SCOPE_GLOBAL) >= 0);
+
+    // Rank 1 sent its block to rank 0, which wrote it
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.ncreate == 3 && stats.nbatch == 2);
+    MPI_Allreduce(&stats.nagg, &nagg, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    CHECK(nagg >= 1);
+
+    H5Dclose(indep_id);
+    H5Dclose(one_id);
+    H5Dclose(agg_id);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    // All ranks open the datasets in the same order and see all the data
+    CHECK((file_id = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_id)) >= 0);
+    check_data(file_id, "agg", 2 * N);
+    check_data(file_id, "one", N);
+    check_data(file_id, "indep", N);
+
+    // Attributes are read independently
+    CHECK((agg_id = H5Dopen2(file_id, "agg", H5P_DEFAULT)) >= 0);
+    if (rank == 1) {
+        CHECK((attr_id = H5Aopen(agg_id, "step", H5P_DEFAULT)) >= 0);
+        CHECK(H5Aread(attr_id, H5T_NATIVE_INT, &value) >= 0);
+        CHECK(value == step);
+        H5Aclose(attr_id);
+    }
+    H5Dclose(agg_id);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    H5Pclose(dxpl_id);
+    H5Pclose(fapl_id);
+
+    MPI_Allreduce(&nerrors, &all, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (rank == 0 && all)
+        printf("%d checks failed\n", all);
+    MPI_Finalize();
+
+    return all != 0;
+}
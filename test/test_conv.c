@@ -0,0 +1,131 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the datatype conversions
+ */
+#include "H5VLpdc_private.h"
+#include "H5VLpdc_test.h"
+
+#include <math.h>
+#include <string.h>
+
+/* Enough elements to go through several conversion batches */
+#define NELEM 10000
+
+int
+main(void)
+{
+    H5VL_pdc_conv_t conv;
+    int32_t         i32[5] = {-1000, -5, 0, 7, 1000}, i32_out[NELEM];
+    int8_t          i8[5];
+    uint8_t         u8[3];
+    int32_t         i32_u8[3] = {-1, 300, 200};
+    uint64_t        u64[2]    = {UINT64_MAX, 42};
+    int64_t         i64[2];
+    float           f32[3] = {1.5f, -2.25f, 1e30f};
+    double          f64[3];
+    unsigned char   be[4];
+    int16_t         i16[NELEM];
+    double          f64_i[6] = {1.9, -1.9, 1e10, -1e10, NAN, 1e300}, f64_big[2] = {-1e300, 1e-300};
+    float           f32_big[2];
+    int32_t         i32_f[6], one = 1;
+    int64_t         i64_f[2] = {INT64_MAX, -3};
+    uint64_t        u64_f;
+    hid_t           str_id, enum_id;
+    int             i;
+
+    // Nothing to do between equal types, between enumerations and floats, or for non-numeric types
+    CHECK(!H5VL__pdc_conv_init(H5T_NATIVE_INT32, H5T_NATIVE_INT32, &conv));
+    enum_id = H5Tenum_create(H5T_NATIVE_INT32);
+    H5Tenum_insert(enum_id, "one", &one);
+    CHECK(!H5VL__pdc_conv_init(enum_id, H5T_NATIVE_FLOAT, &conv));
+    H5Tclose(enum_id);
+    str_id = H5Tcopy(H5T_C_S1);
+    H5Tset_size(str_id, 4);
+    CHECK(!H5VL__pdc_conv_init(str_id, H5T_NATIVE_INT32, &conv));
+    H5Tclose(str_id);
+
+    // Narrowing integers saturate
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_INT32, H5T_NATIVE_INT8, &conv));
+    CHECK(conv.src_size == 4 && conv.dst_size == 1);
+    H5VL__pdc_conv_run(&conv, i8, i32, 5);
+    CHECK(i8[0] == INT8_MIN && i8[1] == -5 && i8[2] == 0 && i8[3] == 7 && i8[4] == INT8_MAX);
+
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_INT32, H5T_NATIVE_UINT8, &conv));
+    H5VL__pdc_conv_run(&conv, u8, i32_u8, 3);
+    CHECK(u8[0] == 0 && u8[1] == UINT8_MAX && u8[2] == 200);
+
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_UINT64, H5T_NATIVE_INT64, &conv));
+    H5VL__pdc_conv_run(&conv, i64, u64, 2);
+    CHECK(i64[0] == INT64_MAX && i64[1] == 42);
+
+    // Floats widen exactly
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_FLOAT, H5T_NATIVE_DOUBLE, &conv));
+    H5VL__pdc_conv_run(&conv, f64, f32, 3);
+    CHECK(f64[0] == 1.5 && f64[1] == -2.25 && f64[2] == (double)1e30f);
+
+    // Doubles beyond the range of a float become infinities
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, &conv));
+    H5VL__pdc_conv_run(&conv, f32, f64_i + 4, 2);
+    H5VL__pdc_conv_run(&conv, f32_big, f64_big, 2);
+    CHECK(isnan(f32[0]) && isinf(f32[1]) && f32[1] > 0);
+    CHECK(isinf(f32_big[0]) && f32_big[0] < 0 && f32_big[1] == 0.0f);
+
+    // Floats are truncated toward zero and saturate when converted to integers, NaN becomes 0
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_DOUBLE, H5T_NATIVE_INT32, &conv));
+    H5VL__pdc_conv_run(&conv, i32_f, f64_i, 6);
+    CHECK(i32_f[0] == 1 && i32_f[1] == -1 && i32_f[2] == INT32_MAX && i32_f[3] == INT32_MIN);
+    CHECK(i32_f[4] == 0 && i32_f[5] == INT32_MAX);
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_FLOAT, H5T_NATIVE_UINT64, &conv));
+    f32[0] = -2.5f;
+    H5VL__pdc_conv_run(&conv, &u64_f, f32, 1);
+    CHECK(u64_f == 0);
+    f32[0] = 1.8446744e19f;
+    H5VL__pdc_conv_run(&conv, &u64_f, f32, 1);
+    CHECK(u64_f == UINT64_MAX);
+
+    // Integers are rounded to the nearest float
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_INT64, H5T_NATIVE_DOUBLE, &conv));
+    H5VL__pdc_conv_run(&conv, f64, i64_f, 2);
+    CHECK(f64[0] == 9223372036854775808.0 && f64[1] == -3.0);
+
+    // Types of the other byte order are only swapped
+    CHECK(H5VL__pdc_conv_init(H5T_STD_I32BE, H5T_STD_I32LE, &conv));
+    CHECK(conv.func == NULL && conv.src_swap != conv.dst_swap);
+    be[0] = 0x01;
+    be[1] = 0x02;
+    be[2] = 0x03;
+    be[3] = 0x04;
+    H5VL__pdc_conv_run(&conv, i32_out, be, 1);
+    CHECK(memcmp(i32_out, "\x04\x03\x02\x01", 4) == 0);
+
+    // Or swapped and converted, over several batches
+    for (i = 0; i < NELEM; i++)
+        i16[i] = (int16_t)(i - NELEM / 2);
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_INT16, H5T_NATIVE_INT32, &conv));
+    H5VL__pdc_conv_run(&conv, i32_out, i16, NELEM);
+    for (i = 0; i < NELEM; i++)
+        CHECK(i32_out[i] == i - NELEM / 2);
+    CHECK(H5VL__pdc_conv_init(H5T_STD_I32BE, H5T_STD_I16LE, &conv));
+    CHECK(conv.src_swap != conv.dst_swap);
+    for (i = 0; i < NELEM; i++)
+        i32_out[i] = (int32_t)__builtin_bswap32((uint32_t)(i * 7 - 3 * NELEM));
+    H5VL__pdc_conv_run(&conv, i16, i32_out, NELEM);
+    for (i = 0; i < NELEM; i++) {
+        int32_t v = i * 7 - 3 * NELEM;
+
+        CHECK(i16[i] == (v < INT16_MIN ? INT16_MIN : v > INT16_MAX ? INT16_MAX : v));
+    }
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    return nerrors != 0;
+}
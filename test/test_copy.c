@@ -0,0 +1,70 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the staging copy engine
+ */
+#include "H5VLpdc_private.h"
+#include "H5VLpdc_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Largest copy, enough to be split across the copy threads */
+#define MAX_SIZE (9 * 1048576 + 13)
+
+/* Unaligned offsets of the source and destination in their buffers */
+#define SRC_OFF 3
+#define DST_OFF 5
+#define GUARD   64
+
+static const size_t sizes[] = {0, 1, 63, 64, 4097, 4 * 1048576, MAX_SIZE};
+
+int
+main(void)
+{
+    H5VL_pdc_copy_mode_t mode;
+    unsigned char *      src, *dst;
+    size_t               i, j;
+
+    src = (unsigned char *)malloc(MAX_SIZE + SRC_OFF);
+    dst = (unsigned char *)malloc(MAX_SIZE + DST_OFF + GUARD);
+    for (i = 0; i < MAX_SIZE + SRC_OFF; i++)
+        src[i] = (unsigned char)(i * 7 + i / 251);
+
+    // Every strategy copies the bytes asked for, and only those
+    for (mode = H5VL_PDC_COPY_AUTO; mode <= H5VL_PDC_COPY_PARALLEL; mode++) {
+        CHECK(H5VLpdc_set_copy(mode, 3) >= 0);
+        for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            memset(dst, 0xa5, MAX_SIZE + DST_OFF + GUARD);
+            H5VL__pdc_copy(dst + DST_OFF, src + SRC_OFF, sizes[i]);
+            CHECK(memcmp(dst + DST_OFF, src + SRC_OFF, sizes[i]) == 0);
+            for (j = 0; j < DST_OFF; j++)
+                CHECK(dst[j] == 0xa5);
+            for (j = 0; j < GUARD; j++)
+                CHECK(dst[DST_OFF + sizes[i] + j] == 0xa5);
+        }
+    }
+
+    // Parallel copies without copy threads are made by the caller alone
+    CHECK(H5VLpdc_set_copy(H5VL_PDC_COPY_PARALLEL, 0) >= 0);
+    H5VL__pdc_copy(dst, src, MAX_SIZE);
+    CHECK(memcmp(dst, src, MAX_SIZE) == 0);
+
+    CHECK(H5VLpdc_set_copy((H5VL_pdc_copy_mode_t)(H5VL_PDC_COPY_PARALLEL + 1), 1) < 0);
+
+    H5VL__pdc_copy_term();
+    free(dst);
+    free(src);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    return nerrors != 0;
+}
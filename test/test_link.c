@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the namespace index of the PDC VOL connector: link
+ *          queries by name and by creation order, iteration, and deletes.
+ *          Runs against a PDC server, with the connector loaded through
+ *          HDF5_VOL_CONNECTOR.
+ */
+#include <mpi.h>
+#include <string.h>
+
+#include "H5VLpdc_test.h"
+
+#define FILE_NAME "test_link.h5"
+
+/* Names of the links of group "g", in creation order */
+static const char *names_g[] = {"z", "a", "sub"};
+
+/* Links met by an iteration */
+typedef struct {
+    int  n;
+    char names[8][16];
+} iter_t;
+
+static herr_t
+iter_cb(hid_t group, const char *name, const H5L_info2_t *info, void *op_data)
+{
+    iter_t *it = (iter_t *)op_data;
+
+    (void)group;
+    (void)info;
+    if (it->n < 8)
+        snprintf(it->names[it->n], sizeof(it->names[0]), "%s", name);
+    it->n++;
+
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    H5G_info_t ginfo;
+    iter_t     it;
+    hsize_t    dims = 4, i;
+    hid_t      fapl_id, file_id, space_id, g_id, sub_id, dset_id;
+    char       name[16];
+
+    MPI_Init(&argc, &argv);
+
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+    CHECK((file_id = H5Fcreate(FILE_NAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) >= 0);
+    space_id = H5Screate_simple(1, &dims, NULL);
+    CHECK((g_id = H5Gcreate2(file_id, "g", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0);
+    for (i = 0; i < 2; i++) {
+        CHECK((dset_id = H5Dcreate2(g_id, names_g[i], H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                                    H5P_DEFAULT)) >= 0);
+        H5Dclose(dset_id);
+    }
+    CHECK((sub_id = H5Gcreate2(g_id, "sub", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) >= 0);
+    CHECK((dset_id = H5Dcreate2(sub_id, "x", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                                H5P_DEFAULT)) >= 0);
+    H5Dclose(dset_id);
+    H5Gclose(sub_id);
+    H5Sclose(space_id);
+
+    // Queries by name
+    CHECK(H5Lexists(file_id, "g", H5P_DEFAULT) > 0);
+    CHECK(H5Lexists(g_id, "a", H5P_DEFAULT) > 0);
+    CHECK(H5Lexists(file_id, "g/sub/x", H5P_DEFAULT) > 0);
+    CHECK(H5Lexists(g_id, "missing", H5P_DEFAULT) == 0);
+    CHECK(H5Gget_info(g_id, &ginfo) >= 0);
+    CHECK(ginfo.nlinks == 3);
+
+    // Queries by creation order, in both directions
+    for (i = 0; i < 3; i++) {
+        CHECK(H5Lget_name_by_idx(file_id, "g", H5_INDEX_CRT_ORDER, H5_ITER_INC, i, name, sizeof(name),
+                                 H5P_DEFAULT) > 0);
+        CHECK(strcmp(name, names_g[i]) == 0);
+        CHECK(H5Lget_name_by_idx(file_id, "g", H5_INDEX_CRT_ORDER, H5_ITER_DEC, i, name, sizeof(name),
+                                 H5P_DEFAULT) > 0);
+        CHECK(strcmp(name, names_g[2 - i]) == 0);
+    }
+
+    // Iteration by name order
+    memset(&it, 0, sizeof(it));
+    CHECK(H5Literate2(g_id, H5_INDEX_NAME, H5_ITER_INC, NULL, iter_cb, &it) >= 0);
+    CHECK(it.n == 3);
+    CHECK(strcmp(it.names[0], "a") == 0 && strcmp(it.names[1], "sub") == 0 && strcmp(it.names[2], "z") == 0);
+
+    // Deleting a group removes the links below it
+    CHECK(H5Ldelete(g_id, "sub", H5P_DEFAULT) >= 0);
+    CHECK(H5Lexists(g_id, "sub", H5P_DEFAULT) == 0);
+    CHECK(H5Gget_info(g_id, &ginfo) >= 0);
+    CHECK(ginfo.nlinks == 2);
+    memset(&it, 0, sizeof(it));
+    CHECK(H5Literate2(g_id, H5_INDEX_CRT_ORDER, H5_ITER_INC, NULL, iter_cb, &it) >= 0);
+    CHECK(it.n == 2);
+    CHECK(strcmp(it.names[0], "z") == 0 && strcmp(it.names[1], "a") == 0);
+
+    H5Gclose(g_id);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    H5Pclose(fapl_id);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    MPI_Finalize();
+
+    return nerrors != 0;
+}
@@ -0,0 +1,96 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the dataset metadata cache of the PDC VOL connector:
+ *          opens served from it, eviction of the least recently closed
+ *          datasets, and the deferred writes of an evicted dataset. Runs
+ *          against a PDC server, with the connector loaded through
+ *          HDF5_VOL_CONNECTOR.
+ */
+#include <mpi.h>
+#include <stdlib.h>
+
+#include "H5VLpdc_public.h"
+#include "H5VLpdc_test.h"
+
+#define FILE_NAME "test_meta.h5"
+
+/* Elements of the datasets */
+#define N 1024
+
+int
+main(int argc, char **argv)
+{
+    H5VL_pdc_stats_t stats;
+    hsize_t          dims = N;
+    hid_t            fapl_id, file_id, space_id, a_id, b_id, a2_id;
+    uint64_t         nhit, nmiss;
+    int              buf[N], i;
+
+    MPI_Init(&argc, &argv);
+    for (i = 0; i < N; i++)
+        buf[i] = i;
+
+    // One closed dataset is kept, writes are deferred
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+    CHECK(H5Pset_pdc_meta_cache(fapl_id, 1) >= 0);
+    CHECK(H5Pset_pdc_write_cache(fapl_id, 4 * N * sizeof(int), 90, 50) >= 0);
+
+    CHECK((file_id = H5Fcreate(FILE_NAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) >= 0);
+    space_id = H5Screate_simple(1, &dims, NULL);
+    CHECK((a_id = H5Dcreate2(file_id, "a", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                             H5P_DEFAULT)) >= 0);
+    CHECK((b_id = H5Dcreate2(file_id, "b", H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                             H5P_DEFAULT)) >= 0);
+    H5Sclose(space_id);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    nhit  = stats.nmeta_hit;
+    nmiss = stats.nmeta_miss;
+
+    // A dataset still open is shared by its handles
+    CHECK((a2_id = H5Dopen2(file_id, "a", H5P_DEFAULT)) >= 0);
+    CHECK(H5Dclose(a2_id) >= 0);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nmeta_hit == nhit + 1 && stats.nmeta_miss == nmiss);
+
+    // The write to a is still deferred when b, closed last, evicts it
+    CHECK(H5Dwrite(a_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0);
+    CHECK(H5Dclose(a_id) >= 0);
+    CHECK(H5Dclose(b_id) >= 0);
+
+    // b is served from the cache, a is looked up again and holds what was written
+    CHECK((b_id = H5Dopen2(file_id, "b", H5P_DEFAULT)) >= 0);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nmeta_hit == nhit + 2 && stats.nmeta_miss == nmiss);
+    CHECK(H5Dclose(b_id) >= 0);
+    CHECK((a_id = H5Dopen2(file_id, "a", H5P_DEFAULT)) >= 0);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nmeta_miss == nmiss + 1);
+    for (i = 0; i < N; i++)
+        buf[i] = -1;
+    CHECK(H5Dread(a_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0);
+    for (i = 0; i < N; i++)
+        if (buf[i] != i) {
+            CHECK(buf[i] == i);
+            break;
+        }
+    CHECK(H5Dclose(a_id) >= 0);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    H5Pclose(fapl_id);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    MPI_Finalize();
+
+    return nerrors != 0;
+}
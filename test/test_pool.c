@@ -0,0 +1,77 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the staging buffer pool
+ */
+#include "H5VLpdc_private.h"
+#include "H5VLpdc_test.h"
+
+#include <stdint.h>
+#include <string.h>
+
+int
+main(void)
+{
+    void *a, *b;
+
+    // Nothing is retained before the first buffer is freed
+    CHECK(H5VLpdc_set_pool(1048576, FALSE) >= 0);
+    CHECK(H5VLpdc_trim_pool(0) == 0);
+
+    // A freed buffer serves the next allocation of its size class, which
+    // rounds 5000 bytes up to 5 KiB
+    CHECK((a = H5VL__pdc_pool_alloc(5000)) != NULL);
+    memset(a, 1, 5120);
+    H5VL__pdc_pool_free(a, 5000);
+    CHECK((b = H5VL__pdc_pool_alloc(5120)) == a);
+    H5VL__pdc_pool_free(b, 5120);
+
+    // Another class gets another buffer, while the first one stays retained
+    CHECK((b = H5VL__pdc_pool_alloc(6000)) != NULL && b != a);
+    H5VL__pdc_pool_free(b, 6000);
+
+    // Trimming releases the largest classes first
+    CHECK(H5VLpdc_trim_pool(5120) == 6144);
+    CHECK(H5VLpdc_trim_pool(0) == 5120);
+    CHECK(H5VLpdc_trim_pool(0) == 0);
+
+    // Buffers beyond the cap go back to the system
+    CHECK(H5VLpdc_set_pool(4096, FALSE) >= 0);
+    CHECK((a = H5VL__pdc_pool_alloc(8192)) != NULL);
+    H5VL__pdc_pool_free(a, 8192);
+    CHECK(H5VLpdc_trim_pool(0) == 0);
+    CHECK((a = H5VL__pdc_pool_alloc(100)) != NULL);
+    H5VL__pdc_pool_free(a, 100);
+    CHECK(H5VLpdc_trim_pool(0) == 4096);
+
+    // A lower cap applies to the buffers already retained
+    CHECK(H5VLpdc_set_pool(65536, FALSE) >= 0);
+    CHECK((a = H5VL__pdc_pool_alloc(4096)) != NULL);
+    CHECK((b = H5VL__pdc_pool_alloc(8192)) != NULL);
+    H5VL__pdc_pool_free(a, 4096);
+    H5VL__pdc_pool_free(b, 8192);
+    CHECK(H5VLpdc_set_pool(4096, FALSE) >= 0);
+    CHECK(H5VLpdc_trim_pool(0) == 4096);
+
+    // Large buffers are aligned on huge pages when asked to
+    CHECK(H5VLpdc_set_pool(16 * 1048576, TRUE) >= 0);
+    CHECK((a = H5VL__pdc_pool_alloc(4 * 1048576)) != NULL);
+    CHECK(((uintptr_t)a & (2 * 1048576 - 1)) == 0);
+    memset(a, 2, 4 * 1048576);
+    H5VL__pdc_pool_free(a, 4 * 1048576);
+    CHECK(H5VLpdc_trim_pool(0) == 4 * 1048576);
+
+    H5VL__pdc_pool_term();
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    return nerrors != 0;
+}
@@ -0,0 +1,159 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the selection blocks and memory maps
+ */
+#include "H5VLpdc_private.h"
+#include "H5VLpdc_test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Check the extent and packed layout of a 2-D block */
+#define CHECK_BLOCK(blk, off0, off1, cnt0, cnt1, pitch0, b)                                                 \
+    CHECK((blk).ndim == 2 && (blk).offset[0] == (off0) && (blk).offset[1] == (off1) &&                      \
+          (blk).count[0] == (cnt0) && (blk).count[1] == (cnt1) && (blk).base == (b) &&                      \
+          ((cnt0) == 1 || (blk).pitch[0] == (pitch0)) && ((cnt1) == 1 || (blk).pitch[1] == 1))
+
+int
+main(void)
+{
+    hsize_t           dims[2] = {8, 10}, start[2], stride[2], count[2], block[2], coords[3][2];
+    hsize_t           mdims = 12, mstart = 0, mstride = 2, mcount = 6;
+    H5VL_pdc_block_t *blocks = NULL, blk;
+    H5VL_pdc_memmap_t map;
+    H5VL_pdc_conv_t   conv;
+    uint64_t *        perm = NULL;
+    size_t            nblocks;
+    int32_t           src[6] = {1, 2, 3, 4, 5, 6}, mem[12], back[6];
+    int16_t           mem16[12];
+    hid_t             space_id, mspace_id;
+    int               i;
+
+    space_id = H5Screate_simple(2, dims, NULL);
+
+    // Nothing selected, no block
+    H5Sselect_none(space_id);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 0 && perm == NULL);
+    free(blocks);
+
+    // The whole dataspace is one block
+    H5Sselect_all(space_id);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 1 && perm == NULL);
+    CHECK_BLOCK(blocks[0], 0, 0, 8, 10, 10, 0);
+    CHECK(H5VL__pdc_block_dense(&blocks[0]));
+    free(blocks);
+
+    // So is a contiguous hyperslab
+    start[0] = 2;
+    start[1] = 3;
+    count[0] = 4;
+    count[1] = 5;
+    H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, NULL, count, NULL);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 1 && perm == NULL);
+    CHECK_BLOCK(blocks[0], 2, 3, 4, 5, 5, 0);
+    CHECK(H5VL__pdc_block_dense(&blocks[0]));
+    free(blocks);
+
+    // Strided columns make one block per column pair, interleaved in the packed buffer
+    start[0]  = 0;
+    start[1]  = 0;
+    stride[0] = 1;
+    stride[1] = 4;
+    count[0]  = 8;
+    count[1]  = 2;
+    block[0]  = 1;
+    block[1]  = 2;
+    H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 2 && perm == NULL);
+    CHECK_BLOCK(blocks[0], 0, 0, 8, 2, 4, 0);
+    CHECK_BLOCK(blocks[1], 0, 4, 8, 2, 4, 2);
+    CHECK(!H5VL__pdc_block_dense(&blocks[1]));
+
+    // Scaled to bytes along the last dimension
+    H5VL__pdc_block_scale(blocks, nblocks, 4);
+    CHECK(blocks[1].offset[1] == 16 && blocks[1].count[1] == 8 && blocks[1].base == 8 &&
+          blocks[1].pitch[0] == 16);
+    free(blocks);
+
+    // Irregular hyperslabs are walked row by row, rows of the same columns merged
+    start[0] = 0;
+    start[1] = 0;
+    count[0] = 2;
+    count[1] = 2;
+    H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, NULL, count, NULL);
+    start[1] = 4;
+    count[0] = 1;
+    H5Sselect_hyperslab(space_id, H5S_SELECT_OR, start, NULL, count, NULL);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 2 && perm == NULL);
+    CHECK_BLOCK(blocks[0], 0, 0, 2, 2, 4, 0);
+    CHECK_BLOCK(blocks[1], 0, 4, 1, 2, 0, 2);
+    free(blocks);
+
+    // Points are walked in row-major order, the permutation gives their place in the selection
+    coords[0][0] = 1;
+    coords[0][1] = 3;
+    coords[1][0] = 1;
+    coords[1][1] = 2;
+    coords[2][0] = 0;
+    coords[2][1] = 0;
+    H5Sselect_elements(space_id, H5S_SELECT_SET, 3, &coords[0][0]);
+    CHECK(H5VL__pdc_sel_blocks(space_id, &blocks, &nblocks, &perm) >= 0);
+    CHECK(nblocks == 2 && perm != NULL);
+    CHECK(perm && perm[0] == 2 && perm[1] == 1 && perm[2] == 0);
+    CHECK_BLOCK(blocks[0], 0, 0, 1, 1, 0, 0);
+    CHECK_BLOCK(blocks[1], 1, 2, 1, 2, 0, 1);
+    free(blocks);
+    free(perm);
+
+    // Every other element of the user buffer is a run of its own
+    mspace_id = H5Screate_simple(1, &mdims, NULL);
+    H5Sselect_hyperslab(mspace_id, H5S_SELECT_SET, &mstart, &mstride, &mcount, NULL);
+    CHECK(H5VL__pdc_memmap_build(mspace_id, mem, sizeof(int32_t), NULL, &map) >= 0);
+    CHECK(map.nrun == 6 && map.pos[6] == 24);
+    CHECK(H5VL__pdc_memmap_addr(&map, 0, 4) == (void *)mem);
+    CHECK(H5VL__pdc_memmap_addr(&map, 4, 4) == (void *)(mem + 2));
+    CHECK(H5VL__pdc_memmap_addr(&map, 0, 8) == NULL);
+
+    // Blocks are scattered to the runs and gathered back
+    memset(&blk, 0, sizeof(blk));
+    blk.ndim     = 1;
+    blk.count[0] = 6;
+    blk.pitch[0] = 1;
+    memset(mem, 0, sizeof(mem));
+    H5VL__pdc_memmap_copy(&map, &blk, sizeof(int32_t), src, NULL, NULL, TRUE);
+    for (i = 0; i < 12; i++)
+        CHECK(mem[i] == (i % 2 ? 0 : src[i / 2]));
+    H5VL__pdc_memmap_copy(&map, &blk, sizeof(int32_t), back, NULL, NULL, FALSE);
+    CHECK(memcmp(back, src, sizeof(src)) == 0);
+    H5VL__pdc_memmap_free(&map);
+
+    // Or converted on the way, the runs being in bytes of the user buffer
+    CHECK(H5VL__pdc_memmap_build(mspace_id, mem16, sizeof(int16_t), NULL, &map) >= 0);
+    CHECK(H5VL__pdc_conv_init(H5T_NATIVE_INT32, H5T_NATIVE_INT16, &conv));
+    memset(mem16, 0, sizeof(mem16));
+    H5VL__pdc_memmap_copy(&map, &blk, sizeof(int32_t), src, NULL, &conv, TRUE);
+    for (i = 0; i < 12; i++)
+        CHECK(mem16[i] == (i % 2 ? 0 : src[i / 2]));
+    H5VL__pdc_memmap_free(&map);
+
+    H5Sclose(mspace_id);
+    H5Sclose(space_id);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    return nerrors != 0;
+}
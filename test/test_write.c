@@ -0,0 +1,150 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of the HDF5 PDC VOL connector. The full copyright       *
+ * notice, including terms governing use, modification, and redistribution,  *
+ * is contained in the COPYING file, which can be found at the root of the   *
+ * source code distribution tree.                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: Tests of the deferred writes of the PDC VOL connector: the order
+ *          they complete in, with and without a flush thread, and their
+ *          completion when the dataset is closed before the file. Runs
+ *          against a PDC server, with the connector loaded through
+ *          HDF5_VOL_CONNECTOR.
+ */
+#include <mpi.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "H5VLpdc_public.h"
+#include "H5VLpdc_test.h"
+
+#define FILE_NAME "test_write.h5"
+
+/* Elements of the dataset */
+#define N 4096
+
+/* Write the elements of [off, off + n) of a 1-D dataset, all set to value */
+static herr_t
+write_part(hid_t dset_id, hsize_t off, hsize_t n, int value)
+{
+    hid_t   mspace_id, fspace_id;
+    int *   buf = (int *)malloc(n * sizeof(int));
+    hsize_t i;
+    herr_t  ret;
+
+    for (i = 0; i < n; i++)
+        buf[i] = value;
+    mspace_id = H5Screate_simple(1, &n, NULL);
+    fspace_id = H5Dget_space(dset_id);
+    H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &off, NULL, &n, NULL);
+    ret = H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id, fspace_id, H5P_DEFAULT, buf);
+    H5Sclose(fspace_id);
+    H5Sclose(mspace_id);
+    free(buf);
+
+    return ret;
+}
+
+/* Read a whole dataset and check it against expect */
+static void
+check_data(hid_t file_id, const char *name, const int *expect)
+{
+    hid_t dset_id;
+    int * buf = (int *)malloc(N * sizeof(int));
+    int   i;
+
+    CHECK((dset_id = H5Dopen2(file_id, name, H5P_DEFAULT)) >= 0);
+    CHECK(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0);
+    for (i = 0; i < N; i++)
+        if (buf[i] != expect[i]) {
+            CHECK(buf[i] == expect[i]);
+            break;
+        }
+    H5Dclose(dset_id);
+    free(buf);
+}
+
+/* Create a dataset of N elements */
+static hid_t
+create_dset(hid_t file_id, const char *name)
+{
+    hsize_t dims = N;
+    hid_t   space_id, dset_id;
+
+    space_id = H5Screate_simple(1, &dims, NULL);
+    dset_id  = H5Dcreate2(file_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Sclose(space_id);
+
+    return dset_id;
+}
+
+static void
+test_write(bool flush_thread)
+{
+    H5VL_pdc_stats_t stats;
+    hid_t            fapl_id, file_id, dset_id;
+    int              expect[N], buf[N], i;
+
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+    CHECK(H5Pset_pdc_write_cache(fapl_id, 4 * N * sizeof(int), 90, 50) >= 0);
+    CHECK(H5Pset_pdc_flush_thread(fapl_id, flush_thread) >= 0);
+
+    CHECK((file_id = H5Fcreate(FILE_NAME, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) >= 0);
+
+    // Overlapping writes are deferred, and land in the order they were made
+    CHECK((dset_id = create_dset(file_id, "order")) >= 0);
+    CHECK(write_part(dset_id, 0, N, 1) >= 0);
+    CHECK(write_part(dset_id, N / 2, N / 2, 2) >= 0);
+    CHECK(write_part(dset_id, N / 4, N / 4, 3) >= 0);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(stats.nreq == 3);
+
+    // A read of data still deferred is served from the writes, newest first; the flush
+    // thread may have written them already
+    for (i = 0; i < N; i++)
+        expect[i] = i < N / 4 ? 1 : i < N / 2 ? 3 : 2;
+    CHECK(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0);
+    CHECK(memcmp(buf, expect, sizeof(expect)) == 0);
+    CHECK(H5VLpdc_get_stats(file_id, &stats) >= 0);
+    CHECK(flush_thread || stats.nhit == 1);
+    CHECK(H5Fflush(file_id, H5F_SCOPE_GLOBAL) >= 0);
+    CHECK(H5Dclose(dset_id) >= 0);
+
+    // Writes still deferred when their dataset is closed are made before its object goes
+    CHECK((dset_id = create_dset(file_id, "closed")) >= 0);
+    CHECK(write_part(dset_id, 0, N / 2, 4) >= 0);
+    CHECK(write_part(dset_id, N / 2, N / 2, 5) >= 0);
+    CHECK(H5Dclose(dset_id) >= 0);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    CHECK((file_id = H5Fopen(FILE_NAME, H5F_ACC_RDONLY, fapl_id)) >= 0);
+    for (i = 0; i < N; i++)
+        expect[i] = i < N / 4 ? 1 : i < N / 2 ? 3 : 2;
+    check_data(file_id, "order", expect);
+    for (i = 0; i < N; i++)
+        expect[i] = i < N / 2 ? 4 : 5;
+    check_data(file_id, "closed", expect);
+    CHECK(H5Fclose(file_id) >= 0);
+
+    H5Pclose(fapl_id);
+}
+
+int
+main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    test_write(false);
+    test_write(true);
+
+    if (nerrors)
+        printf("%d checks failed\n", nerrors);
+    MPI_Finalize();
+
+    return nerrors != 0;
+}